@@ -2,7 +2,12 @@
 #define HORIZONWIDGET_H
 #pragma once
 #include <QWidget>
+#include <QPixmap>
+#include <QRegion>
 
+// Yapay ufuk. Ufuk + pitch merdiveni ("dünya") ve halka + uçak sembolü
+// (sabit katman) boyut değişiminde devicePixelRatio'ya uygun pixmap'lere
+// bir kez çizilir; her karede sadece döndürülmüş/kaydırılmış bir blit yapılır.
 class HorizonWidget : public QWidget
 {
     Q_OBJECT
@@ -11,14 +16,34 @@ public:
 
     void setAttitude(double rollDeg, double pitchDeg);
 
+    // false: her karede her şeyi baştan çiz (eski yol, benchmark karşılaştırması için)
+    void setLayerCache(bool on);
+    bool layerCache() const { return m_layerCache; }
+
 protected:
     void paintEvent(QPaintEvent *e) override;
+    void resizeEvent(QResizeEvent *e) override;
 
 private:
+    void paintDirect(QPainter &p);
+    void paintCached(QPainter &p);
+    void rebuildLayers();
+
+    // Ortak çizim parçaları: p dünya (ufuk merkezli) / widget koordinatında
+    static void drawWorld(QPainter &p, double R, double halfW, double halfH);
+    static void drawOverlay(QPainter &p, const QPointF &c, double R);
+
     double m_rollDeg  = 0.0;
     double m_pitchDeg = 0.0;
     double m_pxPerDeg = 4.0;
 
+    bool m_layerCache = true;
+    QPixmap m_world;            // ufuk (0,0) = pixmap merkezi
+    QPixmap m_overlay;          // widget boyutunda, şeffaf
+    QRegion m_clip;             // daire mask
+    QSize m_cacheSize;
+    qreal m_cacheDpr = 0.0;
+
     static double clamp(double v, double lo, double hi) {
         return (v < lo) ? lo : (v > hi) ? hi : v;
     }
@@ -2,6 +2,7 @@
 #define MAPBRIDGE_H
 
 #include <QWidget>
+#include "mission.h"
 
 class MapBridge : public QObject {
     Q_OBJECT
@@ -11,12 +12,23 @@ public:
 signals:
     void waypointAdded(double lat, double lon);
      void zoomLevelChanged(double zoom);
+    void mapLoaded(bool ok);
+    // Basma/sürükleme/bırakma (pick ve poligon modu dışında). Basılan yerde
+    // waypoint var mı kararını C++ verir, MapSurface::setDragWaypoint ile bildirir.
+    void mapPressed(double lat, double lon, double zoom);
+    void mapDragged(double lat, double lon);
+    void mapReleased(double lat, double lon);
+    void polygonDrawn(const QVector<GeoPoint> &polygon);
 
 public slots:
     void jsReady(const QString &msg);
     void pickModeChanged(bool on);
     void onMapClicked(double lat, double lng, int x, int y);
      void onZoomChangedFromJs(double zoom);
+    void onMapPressed(double lat, double lng, double zoom);
+    void onMapDragged(double lat, double lng);
+    void onMapReleased(double lat, double lng);
+    void onPolygonDrawn(const QString &json);
 };
 
 
@@ -0,0 +1,75 @@
+#ifndef COVERAGE_H
+#define COVERAGE_H
+
+#include <QHash>
+#include <QImage>
+#include <QVector>
+#include <vector>
+#include "enuframe.h"
+#include "mission.h"
+
+// Uçulan alanın kapsama (geçiş sayısı) rasterı; home merkezli ENU düzleminde
+// CELL_M'lik hücreler, TILE x TILE hücrelik seyrek karolar. Sadece üzerinden
+// geçilen karolar bellekte tutulur: bellek uçuş süresiyle değil, kapsanan
+// alanla büyür.
+//
+// Her konum güncellemesinde son noktadan yeni noktaya swath genişliğinde bir
+// kapsül (dikdörtgen + iki uçta yarım swath yarıçaplı daire, yuvarlak birleşim)
+// satır satır (scanline) doldurulur; dönüşün dış tarafında boşluk kalmaz.
+// Her hücre onu en son damgalayan parçanın numarasını tutar: bir önceki
+// parçanın da damgaladığı hücre aynı geçişin devamıdır, tekrar sayılmaz.
+// Hücre değeri böylece gerçek geçiş sayısıdır. Değişen karolar takeDirty ile
+// alınıp haritaya resim olarak gönderilir.
+class CoverageMap
+{
+public:
+    static constexpr double CELL_M = 1.0;       // hücre kenarı
+    static constexpr int TILE = 256;            // karo kenarı (hücre)
+    static constexpr double MAX_STEP_M = 100.0; // daha uzun sıçrama çizilmez (fix kaybı)
+
+    void setFrame(const EnuFrame &frame);       // temizler
+    const EnuFrame &frame() const { return m_frame; }
+
+    void setSwath(double meters) { m_swath = qMax(CELL_M, meters); }
+    double swath() const { return m_swath; }
+
+    void clear();
+    void addPosition(double lat, double lon);
+    void breakTrack() { m_hasLast = false; }    // sonraki nokta yeni geçiş
+
+    double coveredArea() const { return m_coveredCells * CELL_M * CELL_M; }     // m^2
+    int tileCount() const { return m_tiles.size(); }
+
+    QVector<quint64> takeDirty();
+    void markAllDirty();
+    QImage renderTile(quint64 key) const;
+    void tileBounds(quint64 key, GeoPoint &sw, GeoPoint &ne) const;
+    static QString tileId(quint64 key);
+
+private:
+    struct Tile {
+        std::vector<quint8> passes;             // satır 0 = güney
+        std::vector<quint32> lastSeg;           // hücreyi son damgalayan parça, 0 = hiç
+        bool dirty = false;
+    };
+
+    void stampSegment(double ax, double ay, double bx, double by);
+    void stampDisc(double cx, double cy);
+    void stampCell(int cx, int cy);
+
+    EnuFrame m_frame;
+    double m_swath = 20.0;
+    QHash<quint64, Tile> m_tiles;
+    QVector<quint64> m_dirty;
+    qint64 m_coveredCells = 0;
+
+    bool m_hasLast = false;
+    double m_lastX = 0.0, m_lastY = 0.0;
+    quint32 m_seg = 0;                          // şu an damgalanan parça
+
+    // Son erişilen karo; aynı satırdaki hücreler çoğunlukla aynı karoda
+    quint64 m_cachedKey = ~quint64(0);
+    Tile *m_cachedTile = nullptr;
+};
+
+#endif // COVERAGE_H
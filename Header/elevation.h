@@ -0,0 +1,99 @@
+#ifndef ELEVATION_H
+#define ELEVATION_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+#include <memory>
+#include "mission.h"
+
+class DemTile;
+
+// Çevrimdışı arazi yüksekliği: SRTM .hgt karoları (1" 3601x3601 ya da 3"
+// 1201x1201, big-endian int16, metre). Dosyalar QFile::map ile eşlenir;
+// sadece dokunulan sayfalar belleğe gelir. Son kullanılan karolar açık tutulur.
+//
+// Karo adı sol alt köşeden: N41E029.hgt -> enlem [41, 42), boylam [29, 30).
+// Dizin: KUZGUN_DEM_DIR ya da <AppLocalData>/dem.
+//
+// elevation() ve profile() thread-safe; profil işi requestProfile() ile
+// servisin kendi QThreadPool'unda yapılır, yıkıcı bitmesini bekler.
+class ElevationService : public QObject
+{
+    Q_OBJECT
+public:
+    // Bir bacağın arazi özeti (bacak i: wp[i-1] -> wp[i])
+    struct Leg {
+        float groundMax = 0.0f;         // m AMSL
+        float minClearance = 0.0f;      // m, bacak boyunca en düşük AGL
+        bool missing = false;           // bir kısmı için DEM yok
+    };
+
+    struct Profile {
+        int generation = 0;
+        double homeGround = 0.0;        // irtifaların referansı (m AMSL)
+        bool homeKnown = false;
+        QVector<float> ground;          // nokta başına arazi (NaN: veri yok)
+        QVector<Leg> legs;              // legs[0] boş
+        int samples = 0;
+        int lowLegs = 0;                // minClearance < eşik
+        qint64 elapsedMs = 0;
+    };
+
+    static ElevationService *instance();
+
+    void setDirectory(const QString &dir);
+    QString directory() const;
+    void setCacheTiles(int tiles);
+
+    // Bilinear; veri yoksa NaN
+    double elevation(double lat, double lon);
+    // Sadece zaten açık karolardan; dosya açmaz, GUI thread'i için
+    double loadedElevation(double lat, double lon) const;
+
+    // Kalkış/iniş bacakları zemine zaten yaklaşır: düşük AGL sayılmaz
+    static bool isGroundLeg(MissionCommand from, MissionCommand to);
+
+    // Görev irtifaları (lat, lon) noktasındaki zemine göredir (home).
+    // Her bacak 'spacing' metrede bir örneklenir.
+    Profile profile(const QVector<Waypoint> &wps, double refLat, double refLon,
+                    double spacing, double minClearance);
+
+    // Arka planda hesaplar; sadece en son isteğin sonucu profileReady ile gelir
+    int requestProfile(const QVector<Waypoint> &wps, double refLat, double refLon,
+                       double spacing, double minClearance);
+    // Bekleyen isteğin sonucu artık istenmiyor (görev değişti)
+    void cancelPending() { m_generation.fetchAndAddRelaxed(1); }
+
+signals:
+    void profileReady(const ElevationService::Profile &profile);
+
+private:
+    explicit ElevationService(QObject *parent = nullptr);
+    ~ElevationService() override;
+
+    using TilePtr = std::shared_ptr<const DemTile>;
+    static int tileKey(int latFloor, int lonFloor);
+    TilePtr tile(int key);
+    // key/cur: çağıranın son karosu
+    double sample(double lat, double lon, int &key, TilePtr &cur);
+
+    struct Entry {
+        TilePtr tile;                   // null: dosya yok (tekrar aranmaz)
+        quint64 lastUse = 0;
+    };
+
+    mutable QMutex m_mutex;
+    QString m_dir;
+    QHash<int, Entry> m_tiles;
+    quint64 m_clock = 0;
+    int m_maxTiles = 16;
+    QAtomicInt m_generation;
+    QThreadPool m_pool;
+};
+
+#endif // ELEVATION_H
@@ -0,0 +1,119 @@
+#ifndef ENUFRAME_H
+#define ENUFRAME_H
+
+#include <cmath>
+#include "geodesy.h"
+
+// Home (ya da başka bir orijin) merkezli yerel teğet düzlem: x doğu, y kuzey,
+// metre. Orijinin sin/cos terimleri ve eğrilik yarıçapları kurulumda bir kez
+// hesaplanır; dönüşümler trigonometri içermez.
+//
+// toLocal/toGeo: orijindeki teğet düzleme doğrusal izdüşüm (WGS84 meridyen ve
+// asal düşey yarıçaplarıyla). Birbirinin tam tersi; iki nokta arası mesafe
+// hatası yaklaşık ayrım * (orijine enlem farkı) * tan(enlem), birkaç on km'lik
+// görev alanında ihmal edilebilir. Planlama, izleme ve geofence bunu kullanır.
+//
+// toEnu/fromEnu: ECEF üzerinden tam WGS84 ENU (irtifa dahil), Geodesy::enuBatch
+// ile aynı sonuç.
+class EnuFrame
+{
+public:
+    EnuFrame() : EnuFrame(0.0, 0.0) {}
+
+    explicit EnuFrame(double lat0, double lon0, double alt0 = 0.0)
+        : m_lat0(lat0), m_lon0(lon0), m_alt0(alt0)
+    {
+        const double p = lat0 * DEG, l = lon0 * DEG;
+        m_sinLat = std::sin(p);
+        m_cosLat = std::cos(p);
+        m_sinLon = std::sin(l);
+        m_cosLon = std::cos(l);
+
+        const double w = 1.0 - E2 * m_sinLat * m_sinLat;
+        const double N = Geodesy::WGS84_A / std::sqrt(w);
+        const double M = Geodesy::WGS84_A * (1.0 - E2) / (w * std::sqrt(w));
+        m_kx = (N + alt0) * m_cosLat * DEG;
+        m_ky = (M + alt0) * DEG;
+
+        m_x0 = (N + alt0) * m_cosLat * m_cosLon;
+        m_y0 = (N + alt0) * m_cosLat * m_sinLon;
+        m_z0 = (N * (1.0 - E2) + alt0) * m_sinLat;
+    }
+
+    double lat0() const { return m_lat0; }
+    double lon0() const { return m_lon0; }
+    double alt0() const { return m_alt0; }
+
+    // ------------------------------------------------------------ düzlem
+
+    void toLocal(double lat, double lon, double &east, double &north) const
+    {
+        east = (lon - m_lon0) * m_kx;
+        north = (lat - m_lat0) * m_ky;
+    }
+
+    void toGeo(double east, double north, double &lat, double &lon) const
+    {
+        lat = m_lat0 + north / m_ky;
+        lon = m_lon0 + east / m_kx;
+    }
+
+    // Orijine göre
+    static double distance(double east, double north) { return std::hypot(east, north); }
+
+    // Kuzeyden saat yönü [0, 360)
+    static double bearing(double east, double north)
+    {
+        const double b = std::atan2(east, north) / DEG;
+        return b < 0.0 ? b + 360.0 : b;
+    }
+
+    // ------------------------------------------------------------ tam ENU
+
+    void toEnu(double lat, double lon, double alt,
+               double &east, double &north, double &up) const
+    {
+        const double p = lat * DEG, l = lon * DEG;
+        const double sp = std::sin(p), cp = std::cos(p);
+        const double sl = std::sin(l), cl = std::cos(l);
+        const double N = Geodesy::WGS84_A / std::sqrt(1.0 - E2 * sp * sp);
+        const double dx = (N + alt) * cp * cl - m_x0;
+        const double dy = (N + alt) * cp * sl - m_y0;
+        const double dz = (N * (1.0 - E2) + alt) * sp - m_z0;
+        east  = -m_sinLon * dx + m_cosLon * dy;
+        north = -m_sinLat * m_cosLon * dx - m_sinLat * m_sinLon * dy + m_cosLat * dz;
+        up    =  m_cosLat * m_cosLon * dx + m_cosLat * m_sinLon * dy + m_sinLat * dz;
+    }
+
+    void fromEnu(double east, double north, double up,
+                 double &lat, double &lon, double &alt) const
+    {
+        const double x = m_x0 - m_sinLon * east - m_sinLat * m_cosLon * north + m_cosLat * m_cosLon * up;
+        const double y = m_y0 + m_cosLon * east - m_sinLat * m_sinLon * north + m_cosLat * m_sinLon * up;
+        const double z = m_z0 + m_cosLat * north + m_sinLat * up;
+
+        // ECEF -> geodetik; orijin yakınında birkaç yineleme mm altına iner
+        const double r = std::hypot(x, y);
+        double p = std::atan2(z, r * (1.0 - E2));
+        double N = Geodesy::WGS84_A;
+        for (int i = 0; i < 4; ++i) {
+            const double sp = std::sin(p);
+            N = Geodesy::WGS84_A / std::sqrt(1.0 - E2 * sp * sp);
+            p = std::atan2(z + E2 * N * sp, r);
+        }
+        lat = p / DEG;
+        lon = std::atan2(y, x) / DEG;
+        alt = r / std::cos(p) - N;
+    }
+
+private:
+    static constexpr double DEG = M_PI / 180.0;
+    static constexpr double E2 = Geodesy::WGS84_F * (2.0 - Geodesy::WGS84_F);
+
+    double m_lat0, m_lon0, m_alt0;
+    double m_sinLat, m_cosLat, m_sinLon, m_cosLon;
+    double m_kx, m_ky;                  // m / derece (boylam, enlem)
+    double m_x0, m_y0, m_z0;            // orijin ECEF
+};
+
+#endif // ENUFRAME_H
@@ -3,21 +3,19 @@
 
 #include <QWidget>
 #include "MapBridge.h"
+#include "mapsurface.h"
 #include "SerialManager.h"
+#include "mission.h"
+#include "missiongeometry.h"
+
+class MissionModel;
+class MissionUploader;
+class QTimer;
+class RouteOptimizer;
 
 namespace Ui {
 class FlightController;
 }
-struct Waypoint {
-    double lat; //Latitude (Enlem)
-    double lon; //Longtide (Boylam)
-    double alt; //Altitude (Yükseklik)
-    double dist; //Distance (Noktalar arası mesafe)
-    double radius;  // Radius (Yarıçap)
-    QString status;
-};
-
-
 
 class FlightController : public QWidget
 {
@@ -27,23 +25,27 @@ public:
     explicit FlightController(SerialManager* serialPtr,const QVector<Waypoint>& wpList, QWidget *parent = nullptr);
     ~FlightController();
 
-    QVector<Waypoint> wps;
     double homeLat = 0, homeLon = 0;
     bool homeSet = false;
 
     double haversineMeters(double lat1, double lon1, double lat2, double lon2);
     void appendWaypoint(double lat, double lon);
-    void refreshTable();
-    void addRemoveButton(int row);
+    void appendWaypoints(const QVector<Waypoint> &newWps);
     void removeWaypointRow(int row);
-    void recomputeDistancesAndUpdateTable();
-    void rebuildRemoveButtonsRowProperty();
     void redrawWaypointsOnMap();
-    void addStatusCombo(int row);
-    void rebuildStatusCombosRowProperty();
+    void sendZonesToMap();
+    bool terrainReference(double &lat, double &lon) const;
+    void requestTerrainProfile();
+    void updateFlightPath();
+    void sendFlightPathToMap();
+    static VehicleProfile loadVehicleProfile();
+    static void saveVehicleProfile(const VehicleProfile &v);
+    void sendValidationToMap();
+    void updateMissionTotals();
     void addStyleSheet();
     void listSerialPorts();
     void getMap();
+    void getTable();
     void getTriggers();
 
 signals:
@@ -52,21 +54,31 @@ signals:
 private slots:
     void onSendClicked();
     void onReadClicked();
+    void onImportClicked();
+    void onExportClicked();
+    void onZonesClicked();
+    void onVehicleClicked();
+    void onOptimizeClicked();
+    void onPolygonDrawn(const QVector<GeoPoint> &polygon);
 
 private:
+    void setSendCancels(bool cancels);
+
     Ui::FlightController *ui;
-    MapBridge *bridge;
+    MapBridge *bridge = nullptr;
+    MapSurface *m_map = nullptr;
+    MissionModel *m_model = nullptr;
+    MissionUploader *m_uploader = nullptr;
+    RouteOptimizer *m_optimizer = nullptr;
+    QVector<Waypoint> m_uploadWps;      // gönderilen anlık görüntü
+    QTimer *m_terrainTimer = nullptr;
+    QTimer *m_pathTimer = nullptr;
+    QVector<GeoPoint> m_flightPath;     // yaylı rota (harita için)
+    double m_flownLength = 0.0;         // m
     SerialManager* serial;
     bool wpReading = false;
     QString currentPort;
     QString rxBuffer;
-    static constexpr int COL_STATUS = 0;
-    static constexpr int COL_LAT    = 1;
-    static constexpr int COL_LON    = 2;
-    static constexpr int COL_ALT    = 3;
-    static constexpr int COL_DIST   = 4;
-    static constexpr int COL_RADIUS = 5;
-    static constexpr int COL_REMOVE = 6;
     bool m_drawEnabled = false;
     bool m_mapReady    = false;
 
@@ -0,0 +1,28 @@
+#ifndef FLIGHTPATH_H
+#define FLIGHTPATH_H
+
+#include <QVector>
+#include "mission.h"
+
+// Sabit kanat için uçulabilir rota: her ara waypoint'te iki bacağa teğet
+// dönüş yayı (fillet). Yay yarıçapı waypoint'in radius'u; yay bacağın
+// yarısından uzun olamayacağı için gerekirse küçültülür.
+//
+// Her köşe sadece komşu iki noktaya bağlı: uzun görevlerde köşeler parçalara
+// bölünüp QThreadPool'da paralel hesaplanır. Yaylar 'tolerance' kiriş
+// hatasıyla örneklenir; düz kısımlar sadece uç noktalarıyla gelir.
+namespace FlightPath {
+
+struct Path {
+    QVector<GeoPoint> points;       // haritaya gidecek sadeleştirilmiş çizgi
+    double length = 0.0;            // m, uçulan (yaylı) uzunluk
+    double straightLength = 0.0;    // m, düz bacakların toplamı
+    int tightTurns = 0;             // yarıçapı küçültülen köşe sayısı
+};
+
+// threads: 0 = QThreadPool'un tamamı, 1 = seri
+Path compute(const QVector<Waypoint> &wps, double tolerance = 1.0, int threads = 0);
+
+}
+
+#endif // FLIGHTPATH_H
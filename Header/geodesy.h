@@ -0,0 +1,68 @@
+#ifndef GEODESY_H
+#define GEODESY_H
+
+// Jeodezi fonksiyonları. Qt'ye bağımlı değil (bench/ tarafından da derlenir).
+//
+// Batch fonksiyonlar struct-of-arrays alır: her alan ayrı, ardışık bir dizi.
+// x86-64'te çalışma anında AVX2+FMA varsa 4'lü vektör çekirdekleri, yoksa
+// skaler döngüler kullanılır. Açılar derece, mesafeler metre.
+namespace Geodesy {
+
+constexpr double EARTH_RADIUS = 6371000.0;      // küresel model (haversine)
+constexpr double WGS84_A = 6378137.0;
+constexpr double WGS84_F = 1.0 / 298.257223563;
+
+// ---------------------------------------------------------------- tekil
+
+double haversine(double lat1, double lon1, double lat2, double lon2);
+
+// Elipsoid üzerinde Vincenty ters problemi; yakınsamazsa haversine döner
+double vincenty(double lat1, double lon1, double lat2, double lon2);
+
+// İlk kerteriz [0, 360)
+double bearing(double lat1, double lon1, double lat2, double lon2);
+
+void destination(double lat, double lon, double bearingDeg, double dist,
+                 double &outLat, double &outLon);
+
+// ---------------------------------------------------------------- batch
+
+void haversineBatch(const double *lat1, const double *lon1,
+                    const double *lat2, const double *lon2,
+                    double *outDist, int n);
+
+// Yineleme sayısı noktaya göre değiştiği için skaler
+void vincentyBatch(const double *lat1, const double *lon1,
+                   const double *lat2, const double *lon2,
+                   double *outDist, int n);
+
+void bearingBatch(const double *lat1, const double *lon1,
+                  const double *lat2, const double *lon2,
+                  double *outBearing, int n);
+
+void destinationBatch(const double *lat, const double *lon,
+                      const double *bearingDeg, const double *dist,
+                      double *outLat, double *outLon, int n);
+
+// WGS84 elipsoidi, (lat0, lon0, alt0) orijinli yerel teğet düzlem
+void enuBatch(double lat0, double lon0, double alt0,
+              const double *lat, const double *lon, const double *alt,
+              double *east, double *north, double *up, int n);
+
+void nedBatch(double lat0, double lon0, double alt0,
+              const double *lat, const double *lon, const double *alt,
+              double *north, double *east, double *down, int n);
+
+// ---------------------------------------------------------------- dispatch
+
+enum class Kernel { Scalar, Avx2 };
+
+// İlk çağrıda CPU'ya göre seçilir. KUZGUN_GEODESY=scalar ile zorlanabilir.
+Kernel activeKernel();
+const char *kernelName();
+// Benchmark/karşılaştırma için; desteklenmeyen çekirdek seçilirse skaler kalır
+void forceKernel(Kernel k);
+
+}
+
+#endif // GEODESY_H
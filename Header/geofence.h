@@ -0,0 +1,78 @@
+#ifndef GEOFENCE_H
+#define GEOFENCE_H
+
+#include <QVector>
+#include <vector>
+#include "missionvalidator.h"
+#include "enuframe.h"
+
+// Uçuş sırasında geofence / yasak bölge kontrolü (her konum güncellemesi).
+//
+// Bölgeler düzgün bir ızgaraya dağıtılır: her hücre kendini kesen kenarları
+// ve merkezinin hangi bölgelerin içinde olduğunu tutar. Bir nokta için sadece
+// bulunduğu hücreye bakılır: merkezden noktaya giden doğru parçasının hücredeki
+// kenarlarla kesişim sayısı merkezin durumunu çevirir. Maliyet köşe sayısından
+// bağımsız, hücre başına birkaç kenar (mikrosaniyenin altında).
+//
+// MissionValidator gibi enlem/boylam düzleminde; 180. boylamı geçen bölgeler
+// desteklenmez.
+class Geofence
+{
+public:
+    enum Breach { None = 0, NoFly, OutsideFence };
+
+    struct Result {
+        Breach breach = None;
+        int zone = -1;                  // NoFly: girilen bölge
+    };
+
+    struct Status {
+        Result now;
+        Result ahead;                   // tahmini konumlarda ilk ihlal
+        double aheadSeconds = -1.0;     // ihlale kalan süre; yoksa -1
+    };
+
+    // İleriye bakış: hız vektörüyle LOOKAHEAD_S saniye, STEP_S aralıkla
+    static constexpr double LOOKAHEAD_S = 10.0;
+    static constexpr double STEP_S = 1.0;
+
+    void setZones(const QVector<MissionValidator::Zone> &zones);
+    const QVector<MissionValidator::Zone> &zones() const { return m_zones; }
+    bool isEmpty() const { return m_zones.isEmpty(); }
+
+    Result check(double lat, double lon) const;
+
+    // Akış: yön son iki fix'ten, büyüklük GPS hızından (m/s)
+    Status update(double lat, double lon, double speed);
+    void resetTrack() { m_hasLast = false; }
+
+private:
+    struct Edge {
+        int zone;
+        double ax, ay, bx, by;          // x = boylam, y = enlem
+    };
+    struct Entry {
+        int zone;
+        bool centerInside;
+        int edgeBegin, edgeEnd;         // m_edges aralığı
+    };
+
+    int cellOf(double x, double y) const;
+
+    QVector<MissionValidator::Zone> m_zones;
+    bool m_hasFence = false;
+
+    double m_x0 = 0.0, m_y0 = 0.0;      // ızgara sol alt köşesi
+    double m_cw = 1.0, m_ch = 1.0;      // hücre boyu (derece)
+    int m_cols = 0, m_rows = 0;
+    std::vector<int> m_cellStart;       // hücre -> m_entries (CSR)
+    std::vector<Entry> m_entries;
+    std::vector<Edge> m_edges;
+
+    EnuFrame m_frame;                   // ileriye bakış için, bölgelerin ortasında
+    bool m_hasLast = false;
+    double m_lastE = 0.0, m_lastN = 0.0;
+    double m_dirE = 0.0, m_dirN = 0.0;  // birim yön
+};
+
+#endif // GEOFENCE_H
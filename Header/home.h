@@ -3,9 +3,16 @@
 
 #include <QWidget>
 #include "MapBridge.h"
+#include "mapsurface.h"
 #include "SerialManager.h"
 #include "flightcontroller.h"
+#include "missiondownloader.h"
+#include "missiontracker.h"
+#include "geofence.h"
+#include "navfilter.h"
+#include "coverage.h"
 #include <QElapsedTimer>
+#include <QPointer>
 #include "HorizonWidget.h"
 #include "settings.h"
 
@@ -35,16 +42,29 @@ private slots:
 
 private:
     Ui::Home *ui;
-    MapBridge *bridge;
+    MapBridge *bridge = nullptr;
+    MapSurface *m_map = nullptr;
     SerialManager *serial;
+    MissionDownloader *m_downloader = nullptr;
+    MissionTracker m_tracker;
+    int m_shownLeg = -1;                // haritada gösterilen aktif bacak
+    Geofence m_fence;
+    NavFilter m_nav;                    // GPS + IMU; harita/HUD/geofence bunu kullanır
+    QElapsedTimer m_navClock;           // filtre zaman damgaları
+    QTimer *m_navTimer = nullptr;
+    CoverageMap m_coverage;             // uçulan alan, home düzleminde
+    QTimer *m_coverageTimer = nullptr;
+    EnuFrame m_homeFrame;               // ilk fix'te kurulur; home mesafe/kerteriz
+    bool m_homeSet = false;
+    int m_fenceAlarm = 0;               // 0 yok, 1 uyarı (tahmin), 2 ihlal
+    bool m_rtlSent = false;             // bu ihlal için RTL gönderildi
 
     bool isConnected = false;
-    bool wpReading = false;
     bool wpRequestedOnce = false;
     bool dataRequestedOnce = false;
     QString currentPort;
     QString rxBuffer;
-    FlightController *fcWin = nullptr;
+    QPointer<FlightController> fcWin;
     Settings *settingsWin = nullptr;
     double ACC_SCALE  = 16384.0;
     double GYRO_SCALE = 131.0;
@@ -65,7 +85,18 @@ private:
 
     void handleDisconnectedState();
     void updateUavOnMap(double lat, double lon, bool pan = true);
+    void updateMissionProgress(double lat, double lon, double speed);
+    void checkGeofence(double lat, double lon, double speed);
+    double navTime() const { return m_navClock.nsecsElapsed() * 1e-9; }
+    void onNavTick();
+    void uploadCoverage();
+    void setHome(double lat, double lon, double alt);
+    void updateHomeReadout(double lat, double lon);
+    bool loadGeofence(const QString &path, QString *error = nullptr);
+    void sendGeofenceToMap();
+    void onGeofenceClicked();
     void clearWaypoints();
+    void onDownloadProgress(int received, int total, double itemsPerSec);
 
 
 private slots:
@@ -0,0 +1,157 @@
+#ifndef KDTREE_H
+#define KDTREE_H
+
+#include <algorithm>
+#include <vector>
+
+// 2B nokta indeksi: dengeli, örtük k-d ağacı (düğüm = aralığın ortası,
+// eksen derinliğe göre x/y). En yakın nokta sorgusu O(log n).
+//
+// Harita düzenlemesi için artımlı: taşınan ya da sona eklenen nokta ağaca
+// girmez, küçük bir "gevşek" listede tutulur (ağaçtaki eski yeri atlanır).
+// Liste LOOSE_MAX'ı geçerse ya da araya ekleme/silme id'leri kaydırırsa
+// ağaç bir sonraki sorguda baştan kurulur (O(n log n)).
+class PointKdTree
+{
+public:
+    static constexpr int LOOSE_MAX = 64;
+
+    int size() const { return int(m_x.size()); }
+
+    void assign(const std::vector<double> &x, const std::vector<double> &y)
+    {
+        m_x = x;
+        m_y = y;
+        m_dirty = true;
+    }
+
+    void clear()
+    {
+        m_x.clear();
+        m_y.clear();
+        m_dirty = true;
+    }
+
+    void set(int id, double x, double y)
+    {
+        m_x[id] = x;
+        m_y[id] = y;
+        loosen(id);
+    }
+
+    void insert(int id, double x, double y)
+    {
+        m_x.insert(m_x.begin() + id, x);
+        m_y.insert(m_y.begin() + id, y);
+        if (id == size() - 1) {
+            m_isLoose.push_back(0);
+            loosen(id);
+        } else {
+            m_dirty = true;         // sonraki id'ler kaydı
+        }
+    }
+
+    void remove(int id)
+    {
+        m_x.erase(m_x.begin() + id);
+        m_y.erase(m_y.begin() + id);
+        m_dirty = true;
+    }
+
+    void truncate(int n)
+    {
+        if (n >= size()) return;
+        m_x.resize(n);
+        m_y.resize(n);
+        m_dirty = true;
+    }
+
+    // maxDist içindeki en yakın nokta; yoksa -1
+    int nearest(double x, double y, double maxDist) const
+    {
+        if (m_dirty || int(m_loose.size()) > LOOSE_MAX)
+            build();
+
+        Best best{-1, maxDist * maxDist};
+        if (!m_order.empty())
+            search(0, int(m_order.size()), 0, x, y, best);
+        for (int id : m_loose)
+            consider(id, x, y, best);
+        return best.id;
+    }
+
+private:
+    struct Best {
+        int id;
+        double d2;
+    };
+
+    void loosen(int id)
+    {
+        if (m_dirty || m_isLoose[id]) return;
+        m_isLoose[id] = 1;
+        m_loose.push_back(id);
+    }
+
+    void build() const
+    {
+        const int n = size();
+        m_order.resize(n);
+        m_split.resize(n);
+        for (int i = 0; i < n; ++i) m_order[i] = i;
+        split(0, n, 0);
+        m_loose.clear();
+        m_isLoose.assign(n, 0);
+        m_dirty = false;
+    }
+
+    void split(int lo, int hi, int depth) const
+    {
+        if (lo >= hi) return;
+        const int mid = (lo + hi) / 2;
+        const std::vector<double> &axis = depth & 1 ? m_y : m_x;
+        std::nth_element(m_order.begin() + lo, m_order.begin() + mid, m_order.begin() + hi,
+                         [&axis](int a, int b) { return axis[a] < axis[b]; });
+        m_split[mid] = axis[m_order[mid]];
+        split(lo, mid, depth + 1);
+        split(mid + 1, hi, depth + 1);
+    }
+
+    void consider(int id, double x, double y, Best &best) const
+    {
+        const double dx = m_x[id] - x, dy = m_y[id] - y;
+        const double d2 = dx * dx + dy * dy;
+        if (d2 <= best.d2) {
+            best.d2 = d2;
+            best.id = id;
+        }
+    }
+
+    void search(int lo, int hi, int depth, double x, double y, Best &best) const
+    {
+        if (lo >= hi) return;
+        const int mid = (lo + hi) / 2;
+        const int id = m_order[mid];
+        if (!m_isLoose[id])
+            consider(id, x, y, best);
+
+        // Bölme düzlemi kurulumdaki konum; nokta sonradan taşınmış olabilir
+        const double diff = ((depth & 1) ? y : x) - m_split[mid];
+        if (diff < 0) {
+            search(lo, mid, depth + 1, x, y, best);
+            if (diff * diff <= best.d2) search(mid + 1, hi, depth + 1, x, y, best);
+        } else {
+            search(mid + 1, hi, depth + 1, x, y, best);
+            if (diff * diff <= best.d2) search(lo, mid, depth + 1, x, y, best);
+        }
+    }
+
+    std::vector<double> m_x, m_y;
+    mutable std::vector<int> m_order;       // k-d sırası (örtük ağaç)
+    mutable std::vector<double> m_split;    // m_order ile hizalı bölme değeri
+    mutable std::vector<int> m_loose;
+    mutable std::vector<char> m_isLoose;
+    mutable bool m_dirty = true;
+};
+
+#endif // KDTREE_H
@@ -0,0 +1,92 @@
+#ifndef MAPSERVICE_H
+#define MAPSERVICE_H
+
+#include <QObject>
+#include <QWebEnginePage>
+#include <QHash>
+#include <QPointF>
+#include "MapBridge.h"
+
+class QWebEngineProfile;
+class QWebEngineView;
+class MapSurface;
+class TileStore;
+
+// map.html'i yükleyen, kendi WebChannel ve MapBridge'ine sahip sayfa.
+// Sayfa MapService'e aittir; view kapanınca yok olmaz, tekrar bağlanabilir.
+class MapPage : public QWebEnginePage
+{
+    Q_OBJECT
+public:
+    MapPage(QWebEngineProfile *profile, const QUrl &url, QObject *parent = nullptr);
+
+    MapBridge *bridge() const { return m_bridge; }
+    bool isReady() const { return m_ready; }
+
+private:
+    MapBridge *m_bridge;
+    bool m_ready = false;
+};
+
+class MapService : public QObject
+{
+    Q_OBJECT
+public:
+    enum Role {
+        HomeMap,    // map.html?pick=0
+        PlanMap     // map.html?pick=1
+    };
+
+    enum Backend {
+        WebBackend,     // QtWebEngine + Leaflet
+        NativeBackend   // QPainter, Chromium yok
+    };
+
+    static MapService *instance();
+
+    // Çalışma anında seçilir: --native-map ya da KUZGUN_MAP_BACKEND=native
+    static Backend backendFromArguments(const QStringList &args);
+    void setBackend(Backend backend) { m_backend = backend; }
+    Backend backend() const { return m_backend; }
+
+    // İlk çağrıda cache ayarlarıyla bir kez yapılandırılır
+    QWebEngineProfile *profile();
+    TileStore *tileStore();
+
+    // Role'e ait uzun ömürlü sayfayı döndürür (ilk çağrıda oluşturulur).
+    MapPage *page(Role role);
+
+    // Seçim ekranı açıkken haritayı arka planda hazırlar: WebEngine süreci,
+    // Leaflet, ikonlar ve son bilinen konum etrafındaki karolar.
+    // Home açıldığında attach() hazır sayfayı alır.
+    void prewarm(Role role);
+
+    // Son bilinen konum (bir sonraki açılışta prewarm için saklanır)
+    void rememberPosition(double lat, double lon);
+    QPointF lastPosition() const { return m_lastPos; }     // x = lat, y = lon
+
+    // Açılış süre ölçümü: main()'den itibaren geçen süreyi loglar
+    static void markPhase(const char *phase);
+
+    // view'in yerine seçili arka ucu yerleştirir.
+    // Web: paylaşılan sayfa view'e bağlanır (başka view'de ise oradan alınır).
+    // Native: view silinir, aynı yere NativeMapWidget konur.
+    MapSurface *attach(Role role, QWebEngineView *view);
+
+private:
+    explicit MapService(QObject *parent = nullptr);
+    void configureProfile();
+    void releasePages();
+    void loadSettings();
+    void saveSettings();
+    QUrl pageUrl(Role role) const;
+
+    Backend m_backend = WebBackend;
+    QWebEngineProfile *m_profile = nullptr;
+    TileStore *m_tiles = nullptr;
+    QHash<int, MapPage*> m_pages;
+    QPointF m_lastPos;
+    bool m_positionDirty = false;
+};
+
+#endif // MAPSERVICE_H
@@ -0,0 +1,95 @@
+#ifndef MAPSURFACE_H
+#define MAPSURFACE_H
+
+#include <QImage>
+#include <QObject>
+#include <QVector>
+#include "MapBridge.h"
+#include "mission.h"
+
+class QWidget;
+class QWebEngineView;
+class MapPage;
+
+// Harita arka ucundan bağımsız arayüz. Home ve FlightController haritaya
+// sadece bunun üzerinden konuşur; JS/Leaflet ya da yerli QPainter çizici.
+// Haritadan gelen olaylar (tıklama, zoom) her iki arka uçta da MapBridge
+// sinyalleri olarak gelir.
+class MapSurface
+{
+public:
+    virtual ~MapSurface() = default;
+
+    virtual QWidget *widget() const = 0;
+    virtual MapBridge *bridge() const = 0;
+    virtual bool isReady() const = 0;
+
+    virtual void setUav(double lat, double lon, bool pan = true) = 0;
+    virtual void setGpsFixState(bool fix) = 0;
+    virtual void setZoom(double zoom) = 0;
+    virtual void setWaypoints(const QVector<Waypoint> &wps) = 0;
+    virtual void clearWaypoints() = 0;
+
+    // Artımlı güncelleme: sadece değişen waypoint gönderilir
+    virtual void updateWaypoint(int index, const Waypoint &wp) = 0;
+    virtual void insertWaypoint(int index, const Waypoint &wp) = 0;
+    virtual void removeWaypoint(int index) = 0;
+
+    // Açıkken tıklamalar poligon köşesi olur; kapatınca poligon
+    // MapBridge::polygonDrawn ile gelir.
+    virtual void setPolygonDrawMode(bool on) = 0;
+
+    // Yasak bölge / geofence çokgenleri (inclusion: geofence)
+    virtual void setZones(const QVector<QVector<GeoPoint>> &rings, const QVector<bool> &inclusion) = 0;
+    // Doğrulamadan geçemeyen bacaklar (indeks = hedef nokta) kırmızı çizilir
+    virtual void setLegHighlights(const QVector<int> &legs) = 0;
+    // Uçulan (yaylı) rota; waypoint düzenlenince düz çizgiye döner
+    virtual void setFlightPath(const QVector<GeoPoint> &path) = 0;
+    // mapPressed'e cevap: fare bırakılana kadar bu waypoint sürüklenir (pan
+    // yapılmaz), hareket mapDragged ile gelir. -1: sürükleme yok.
+    virtual void setDragWaypoint(int index) = 0;
+    // Uçuşta aktif bacak (indeks = hedef nokta), -1: yok
+    virtual void setActiveLeg(int index) = 0;
+    // Kapsama rasterı: id'si aynı karo yerine konur; sw/ne köşeleri
+    virtual void setCoverageTile(const QString &id, const QImage &image,
+                                 const GeoPoint &sw, const GeoPoint &ne) = 0;
+    virtual void clearCoverage() = 0;
+};
+
+// QtWebEngine + map.html
+class WebMapSurface : public QObject, public MapSurface
+{
+    Q_OBJECT
+public:
+    WebMapSurface(QWebEngineView *view, MapPage *page, QObject *parent = nullptr);
+
+    QWidget *widget() const override;
+    MapBridge *bridge() const override;
+    bool isReady() const override;
+
+    void setUav(double lat, double lon, bool pan = true) override;
+    void setGpsFixState(bool fix) override;
+    void setZoom(double zoom) override;
+    void setWaypoints(const QVector<Waypoint> &wps) override;
+    void clearWaypoints() override;
+    void updateWaypoint(int index, const Waypoint &wp) override;
+    void insertWaypoint(int index, const Waypoint &wp) override;
+    void removeWaypoint(int index) override;
+    void setPolygonDrawMode(bool on) override;
+    void setZones(const QVector<QVector<GeoPoint>> &rings, const QVector<bool> &inclusion) override;
+    void setLegHighlights(const QVector<int> &legs) override;
+    void setFlightPath(const QVector<GeoPoint> &path) override;
+    void setDragWaypoint(int index) override;
+    void setActiveLeg(int index) override;
+    void setCoverageTile(const QString &id, const QImage &image,
+                         const GeoPoint &sw, const GeoPoint &ne) override;
+    void clearCoverage() override;
+
+private:
+    void runJs(const QString &js);
+
+    QWebEngineView *m_view;
+    MapPage *m_page;
+};
+
+#endif // MAPSURFACE_H
@@ -19,7 +19,7 @@ public:
 
 private:
     Ui::MapWindow *ui;
-    MapBridge *bridge;
+    MapBridge *bridge = nullptr;
 };
 
 #endif // MAPWINDOW_H
@@ -0,0 +1,53 @@
+#ifndef MISSION_H
+#define MISSION_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <type_traits>
+
+// Görev komutu. Seri protokolde ve tabloda isimleriyle görünür
+// ("WAYPOINT", "VTOL_TAKEOFF", ...); içeride sadece 1 bayt.
+enum class MissionCommand : quint8 {
+    Waypoint = 0,
+    Takeoff,
+    Land,
+    VtolTakeoff,
+    VtolLand,
+    Loiter,
+    Rtl,
+    Count
+};
+
+// Trivially copyable: QVector<Waypoint> kopyalama/ekleme memcpy ile yapılır,
+// paylaşılan (COW) liste düzenlenene kadar kopyalanmaz.
+struct Waypoint {
+    double lat; //Latitude (Enlem)
+    double lon; //Longtide (Boylam)
+    float alt; //Altitude (Yükseklik)
+    float dist; //Distance (Noktalar arası mesafe)
+    float radius;  // Radius (Yarıçap)
+    MissionCommand command;
+};
+
+static_assert(std::is_trivially_copyable<Waypoint>::value, "Waypoint must stay POD");
+static_assert(sizeof(Waypoint) == 32, "Waypoint layout changed");
+Q_DECLARE_TYPEINFO(Waypoint, Q_PRIMITIVE_TYPE);
+
+struct GeoPoint {
+    double lat;
+    double lon;
+};
+Q_DECLARE_TYPEINFO(GeoPoint, Q_PRIMITIVE_TYPE);
+
+namespace Mission {
+
+QString commandName(MissionCommand cmd);
+// Bilinmeyen isimde WAYPOINT döner, ok = false
+MissionCommand commandFromName(QStringView name, bool *ok = nullptr);
+// Tablo/combobox sırası enum sırasıyla aynı
+const QStringList &commandNames();
+
+}
+
+#endif // MISSION_H
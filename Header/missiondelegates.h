@@ -0,0 +1,41 @@
+#ifndef MISSIONDELEGATES_H
+#define MISSIONDELEGATES_H
+
+#include <QStyledItemDelegate>
+
+// Status hücresi: metin + ok olarak çizilir, QComboBox sadece düzenlerken açılır
+class StatusDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+    QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+                          const QModelIndex &index) const override;
+    void setEditorData(QWidget *editor, const QModelIndex &index) const override;
+    void setModelData(QWidget *editor, QAbstractItemModel *model,
+                      const QModelIndex &index) const override;
+};
+
+// Remove hücresi: "X" butonu gibi çizilir, tıklanınca removeClicked(row)
+class RemoveButtonDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+    bool editorEvent(QEvent *event, QAbstractItemModel *model,
+                     const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+signals:
+    void removeClicked(int row);
+
+private:
+    QPersistentModelIndex m_pressed;
+};
+
+#endif // MISSIONDELEGATES_H
@@ -0,0 +1,98 @@
+#ifndef MISSIONDOWNLOADER_H
+#define MISSIONDOWNLOADER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QVector>
+#include "mission.h"
+
+class QTimer;
+class SerialManager;
+
+// Araçtan gelen görevi okur.
+//
+//   FC  -> WP_BEGIN,<n>
+//   FC  -> WP,<seq>,<lat>,<lon>,<alt>,<dist>,<radius>[,"<CMD>"]  (seq'li)
+//          WP,<lat>,<lon>,<alt>,<dist>,<radius>[,"<CMD>"]        (eski, sırayla)
+//   FC  -> WP_END
+//
+// n kadar yer baştan ayrılır. seq atlarsa, WP_END geldiğinde eksik varsa ya da
+// akış durursa eksikler tek tek WP_GET,<seq> ile tekrar istenir. seq'siz eski
+// akışta eksiğin yeri bilinemez; bir kez WP_GET,ALL ile tamamı istenir.
+// Alınanlar haritaya aralıklı olarak partial() ile gönderilir.
+class MissionDownloader : public QObject
+{
+    Q_OBJECT
+public:
+    enum State {
+        Idle,
+        Receiving,
+        Repairing,  // WP_END geldi / akış durdu, eksikler isteniyor
+        Done,
+        Failed
+    };
+
+    explicit MissionDownloader(SerialManager *serial, QObject *parent = nullptr);
+
+    void cancel();
+
+    State state() const { return m_state; }
+    bool isBusy() const { return m_state == Receiving || m_state == Repairing; }
+    int total() const { return m_wps.size(); }
+    int received() const { return m_received; }
+    double itemsPerSec() const;
+
+    // Şimdiye kadar alınanlar, sırayla (boşluklar atlanır)
+    QVector<Waypoint> receivedWaypoints() const;
+
+signals:
+    void started(int total);
+    void partial(const QVector<Waypoint> &received);
+    void progress(int received, int total, double itemsPerSec);
+    // ok değilse wps boştur; alınan öğe sayısı received()'da
+    void finished(bool ok, const QVector<Waypoint> &wps, const QString &message);
+
+private slots:
+    void onLine(const QString &port, const QString &line);
+    void onTick();
+    void onDisconnected();
+
+private:
+    void begin(int announced);
+    void onItem(const QString &line);
+    void onEnd();
+    void startRepair();
+    void requestMissing();
+    void finish(bool ok, const QString &message);
+    void reportProgress();
+    void pushPartial();
+    bool write(const QByteArray &data);
+
+    SerialManager *m_serial;
+    QTimer *m_tick;
+
+    State m_state = Idle;
+    QVector<Waypoint> m_wps;
+    QVector<bool> m_have;
+    int m_received = 0;
+    int m_next = 0;                     // seq'siz satırlar için sıradaki indeks
+    bool m_countKnown = false;
+    bool m_indexed = false;             // araç seq gönderiyor mu
+    bool m_ended = false;               // WP_END görüldü
+    int m_gaps = 0;                     // seq atlaması sayısı (log için)
+
+    int m_repairRounds = 0;
+    int m_fullRetries = 0;
+    int m_repairCursor = 0;
+    int m_receivedAtRequest = 0;
+
+    QElapsedTimer m_clock;
+    qint64 m_startedAt = 0;
+    qint64 m_lastLineAt = 0;
+    qint64 m_lastRequestAt = 0;
+    qint64 m_lastProgressAt = 0;
+    qint64 m_lastPartialAt = 0;
+    int m_partialCount = 0;             // son partial()'daki öğe sayısı
+};
+
+#endif // MISSIONDOWNLOADER_H
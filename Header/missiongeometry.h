@@ -0,0 +1,79 @@
+#ifndef MISSIONGEOMETRY_H
+#define MISSIONGEOMETRY_H
+
+#include <QVector>
+#include "mission.h"
+
+// Bir bacağın (wp[i-1] -> wp[i]) metrikleri. İlk waypoint'in bacağı sıfırdır.
+struct LegMetrics {
+    double dist   = 0.0;    // m, yatay
+    double climb  = 0.0;    // m, sadece tırmanış (iniş sayılmaz)
+    double time   = 0.0;    // s, tahmini uçuş süresi
+    double energy = 0.0;    // Wh
+
+    LegMetrics &operator+=(const LegMetrics &o) { dist += o.dist; climb += o.climb; time += o.time; energy += o.energy; return *this; }
+    LegMetrics &operator-=(const LegMetrics &o) { dist -= o.dist; climb -= o.climb; time -= o.time; energy -= o.energy; return *this; }
+    friend LegMetrics operator+(LegMetrics a, const LegMetrics &b) { return a += b; }
+    friend LegMetrics operator-(LegMetrics a, const LegMetrics &b) { return a -= b; }
+};
+
+// Süre ve enerji tahmini için araç modeli. Güçler bataryadan çekilen
+// ortalama elektrik gücüdür; tırmanış/alçalma süresince seyir gücünün yerine geçer.
+struct VehicleProfile {
+    double cruise = 15.0;           // m/s hava hızı
+    double climb  = 3.0;            // m/s
+    double sink   = 2.0;            // m/s
+
+    double cruisePower = 350.0;     // W
+    double climbPower  = 550.0;     // W
+    double sinkPower   = 250.0;     // W
+
+    // VTOL_TAKEOFF / VTOL_LAND: dikey kısım hover gücüyle, artı sabit geçiş
+    double hoverPower     = 1200.0; // W
+    double transitionTime = 15.0;   // s, hover <-> ileri uçuş
+
+    double batteryWh  = 600.0;      // kullanılabilir kapasite
+    double reservePct = 20.0;       // bu yüzdenin altı uyarı
+
+    double windSpeed = 0.0;         // m/s
+    double windFrom  = 0.0;         // derece, rüzgarın geldiği yön
+};
+
+// Görev bacaklarının kümülatif toplamları (Fenwick ağacı).
+// Bir bacağın değişmesi O(log n), "k'ya kadar" sorgusu ve toplam O(log n).
+// Ortaya ekleme/silmede indeksler kaydığı için ağaç O(n) toplama ile yeniden
+// kurulur; trigonometri tekrar hesaplanmaz, sadece saklanan bacaklar toplanır.
+class MissionGeometry
+{
+public:
+    static LegMetrics legBetween(double lat1, double lon1, double alt1,
+                                 double lat2, double lon2, double alt2,
+                                 MissionCommand to, const VehicleProfile &vehicle);
+    // Mesafe ve rota (derece) önceden (ör. batch) hesaplanmışsa
+    static LegMetrics legFrom(double dist, double course, double dz,
+                              MissionCommand to, const VehicleProfile &vehicle);
+    // Rüzgar üçgeni: rota boyunca yer hızı (rüzgar hava hızını aşarsa küçük pozitif)
+    static double groundSpeed(double course, const VehicleProfile &vehicle);
+
+    int size() const { return m_legs.size(); }
+    const LegMetrics &leg(int i) const { return m_legs.at(i); }
+
+    void clear();
+    void assign(const QVector<LegMetrics> &legs);
+    void append(const LegMetrics &leg);
+    void insert(int i, const LegMetrics &leg);
+    void remove(int i);
+    void setLeg(int i, const LegMetrics &leg);
+
+    // wp[0]'dan wp[k]'ya kadar (k dahil) toplam
+    LegMetrics prefix(int k) const;
+    LegMetrics total() const { return prefix(m_legs.size() - 1); }
+
+private:
+    void rebuild();
+
+    QVector<LegMetrics> m_legs;
+    QVector<LegMetrics> m_tree;     // 1 tabanlı Fenwick, m_tree[0] kullanılmaz
+};
+
+#endif // MISSIONGEOMETRY_H
@@ -0,0 +1,55 @@
+#ifndef MISSIONIO_H
+#define MISSIONIO_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+#include <QVector>
+#include <limits>
+#include "mission.h"
+
+// Görev dosyası okuma/yazma: QGroundControl .plan, KML ve GPX.
+//
+// Okuma DOM kurmaz: dosya belleğe eşlenir (QFile::map), .plan kendi küçük
+// JSON tarayıcısıyla, KML/GPX QXmlStreamReader ile tek geçişte okunur ve
+// öğeler doğrudan QVector<Waypoint>'e yazılır. Yazma tek bir tampona yapılır.
+//
+// GPX <ele> deniz seviyesine göredir (AMSL), görev irtifaları kalkışa göre.
+// homeAmsl verilirse <ele> = alt + homeAmsl yazılır, okurken alt = ele - homeAmsl.
+// Bağıl irtifa ayrıca <extensions><kuzgun:relAlt> içine yazılır ve okurken
+// önceliklidir. homeAmsl bilinmiyorsa (NaN) <ele> yazılmaz; sadece <ele> taşıyan
+// yabancı dosyalarda değer çevrilemez ve olduğu gibi alınır.
+namespace MissionIO {
+
+constexpr double NO_HOME = std::numeric_limits<double>::quiet_NaN();
+
+enum class Format {
+    Unknown,
+    QgcPlan,
+    Kml,
+    Gpx
+};
+
+// Uzantıya göre (.plan / .kml / .gpx)
+Format formatForPath(const QString &path);
+// QFileDialog filtresi
+QString fileFilter();
+
+bool load(const QString &path, QVector<Waypoint> &out, QString *error = nullptr,
+          double homeAmsl = NO_HOME);
+bool save(const QString &path, const QVector<Waypoint> &wps, QString *error = nullptr,
+          double homeAmsl = NO_HOME);
+
+// Bellekteki veri üzerinde (load bunları eşlenmiş dosyayla çağırır)
+bool parsePlan(QByteArrayView data, QVector<Waypoint> &out, QString *error = nullptr);
+bool parseKml(QByteArrayView data, QVector<Waypoint> &out, QString *error = nullptr);
+bool parseGpx(QByteArrayView data, QVector<Waypoint> &out, QString *error = nullptr,
+              double homeAmsl = NO_HOME);
+
+QByteArray writePlan(const QVector<Waypoint> &wps);
+QByteArray writeKml(const QVector<Waypoint> &wps);
+QByteArray writeGpx(const QVector<Waypoint> &wps, double homeAmsl = NO_HOME);
+
+}
+
+#endif // MISSIONIO_H
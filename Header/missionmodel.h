@@ -0,0 +1,159 @@
+#ifndef MISSIONMODEL_H
+#define MISSIONMODEL_H
+
+#include <QAbstractTableModel>
+#include "mission.h"
+#include "missiongeometry.h"
+#include "missionvalidator.h"
+#include "elevation.h"
+#include "persistentvector.h"
+#include "kdtree.h"
+
+class QUndoStack;
+class MissionEditCommand;
+
+// Görev tablosunun modeli; waypoint'ler burada tutulur.
+// Tablo satır başına widget oluşturmaz, status ve remove hücrelerini
+// delegeler çizer. Düzenlemede sadece etkilenen hücreler bildirilir.
+//
+// Her düzenleme undoStack()'e bir komut olarak girer. Komut önceki ve sonraki
+// sürümü PersistentVector olarak tutar; bir düzenleme O(log n) yeni düğüm
+// demektir. Geri alma da aynı satır sinyallerini verir (harita sadece farkı çizer).
+//
+// Her düzenlemeden sonra MissionValidator sadece etkilenen satırları yeniden
+// kontrol eder; sorunlu satırlar kırmızı arka plan ve açıklamalı ipucu alır.
+//
+// Haritada seçme/sürükleme için noktalar Web Mercator'da bir k-d ağacında
+// tutulur (rowAt). Sürükleme sırasında model canlı güncellenir ama geçmişe
+// bırakıldığında tek komut girer.
+class MissionModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    enum Column {
+        ColStatus = 0,
+        ColLat,
+        ColLon,
+        ColAlt,
+        ColGround,      // arazi yüksekliği (m AMSL)
+        ColAgl,         // noktada yerden yükseklik
+        ColDist,
+        ColTotal,       // başlangıçtan bu noktaya kümülatif mesafe
+        ColEta,         // başlangıçtan bu noktaya tahmini süre
+        ColBattery,     // bu noktaya varıldığında kalan batarya (%)
+        ColRadius,
+        ColRemove,
+        ColumnCount
+    };
+
+    using Version = PersistentVector<Waypoint>;
+
+    explicit MissionModel(QObject *parent = nullptr);
+
+    static QString formatDuration(double seconds);
+
+    const QVector<Waypoint> &waypoints() const { return m_wps; }
+    const Waypoint &at(int row) const { return m_wps.at(row); }
+    int size() const { return m_wps.size(); }
+    bool isEmpty() const { return m_wps.isEmpty(); }
+
+    // O(log n); satır başına kümülatif değerler Total/ETA sütunlarında
+    LegMetrics total() const { return m_geo.total(); }
+
+    // Araç modeli değişince tüm bacaklar yeniden hesaplanır; düzenlemede
+    // sadece değişen noktanın iki bacağı (Fenwick ile O(log n) toplam)
+    const VehicleProfile &vehicle() const { return m_vehicle; }
+    void setVehicle(const VehicleProfile &vehicle);
+    // Batarya kapasitesinin yüzdesi; 0'ın altına inebilir
+    double batteryRemaining(int row) const;
+
+    QUndoStack *undoStack() const { return m_undo; }
+
+    const MissionValidator &validator() const { return m_validator; }
+    void setZones(const QVector<MissionValidator::Zone> &zones);
+    void setValidationRules(const MissionValidator::Rules &rules);
+
+    // ElevationService profili; satır sayısı tutmuyorsa (eski sonuç) yok sayılır
+    void setTerrain(const ElevationService::Profile &profile, double minClearance);
+    int lowClearanceLegs() const { return m_terrainLowLegs; }
+
+    // zoom seviyesinde tolPx piksel içindeki en yakın satır; yoksa -1
+    int rowAt(double lat, double lon, double zoom, double tolPx) const;
+
+    // Haritadan sürükleme: moveTo her karede satırı günceller (komut yok),
+    // endMove değiştiyse tek bir geri alınabilir düzenleme ekler
+    void beginMove(int row);
+    void moveTo(double lat, double lon);
+    void endMove();
+    int movingRow() const { return m_moveRow; }
+
+    // Yükleme: geçmiş temizlenir
+    void setWaypoints(const QVector<Waypoint> &wps);
+    // Geri alınabilir toplu değişiklik (içe aktarma vb.)
+    void replaceAll(const QVector<Waypoint> &wps, const QString &text);
+    void append(const Waypoint &wp);
+    void append(const QVector<Waypoint> &wps);
+    void removeAt(int row);
+    void clear();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+signals:
+    // Konum ya da yarıçap değişti; harita sadece bu noktayı günceller
+    void geometryChanged(int row);
+    // Toplam mesafe/tırmanış/süre değişti
+    void totalsChanged();
+    // Sorunlu satır/bacak kümesi değişti
+    void validationChanged();
+
+private:
+    friend class MissionEditCommand;
+
+    // Komutların uyguladığı değişiklikler
+    void applySet(int row, const Waypoint &wp);
+    void applyInsert(int row, const Waypoint &wp);
+    void applyRemove(int row);
+    void applyAppend(const Version &v, int first);
+    void applyTruncate(int size);
+    void applyReset(const Version &v);
+
+    // row'a giren bacak (row-1 -> row)
+    LegMetrics computeLeg(int row) const;
+    void recomputeLeg(int row);
+    void storeDist(int row, double dist);
+    void rebuildGeometry();
+    // first'ten itibaren mesafe ve kümülatif hücreler değişti
+    void emitLegsChanged(int first);
+    // Tüm görev yeniden doğrulanır (yükleme, toplu değişiklik, kural/bölge)
+    void revalidateAll();
+    void emitIssuesChanged(int first, int last, bool notify);
+    void reindex();
+    // Arazi satırları görevle hizalı tutulur; yeni satır profil gelene kadar boş
+    void clearTerrain();
+    bool hasTerrain(int row) const { return m_terrain.size() == m_wps.size() && row < m_terrain.size(); }
+
+    QVector<Waypoint> m_wps;
+    Version m_version;              // m_wps'in paylaşımlı sürümü (dist hariç)
+    MissionGeometry m_geo;
+    VehicleProfile m_vehicle;
+    MissionValidator m_validator;
+    PointKdTree m_index;            // normalize Mercator, satırla hizalı
+    int m_moveRow = -1;
+
+    struct TerrainRow {
+        float ground;           // NaN: DEM yok
+        float legClearance;     // bu noktaya giren bacakta en düşük AGL
+    };
+    QVector<TerrainRow> m_terrain;
+    double m_homeGround = 0.0;
+    double m_minClearance = 0.0;
+    int m_terrainLowLegs = 0;
+    QUndoStack *m_undo;
+};
+
+#endif // MISSIONMODEL_H
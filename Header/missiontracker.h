@@ -0,0 +1,57 @@
+#ifndef MISSIONTRACKER_H
+#define MISSIONTRACKER_H
+
+#include <QVector>
+#include "mission.h"
+#include "enuframe.h"
+
+// Uçuş sırasında görev ilerlemesi: GPS konumundan aktif bacak, varılan
+// waypoint'ler, çapraz hata (cross-track), kalan mesafe ve ETA.
+//
+// Hedef waypoint'e (a) kabul çemberine girilince ya da (b) bacak boyunca
+// hedefin hizası geçilince (along-track >= bacak uzunluğu) varılmış sayılır.
+// Aktif indeks sadece ileri gider; atlanan noktalar toplamda bir kez sayılır
+// (amortize O(1)). Waypoint'ler setMission'da yerel düzleme (home, yoksa ilk
+// waypoint merkezli EnuFrame) izdüşürülür; her fix tek dönüşüm ve düzlemde
+// birkaç çarpma. Kalan mesafe sondan toplamlarla bulunur.
+//
+// RTL ve sonrası izlenmez (koordinatı home'dur); oraya gelince biter.
+class MissionTracker
+{
+public:
+    struct State {
+        bool valid = false;             // görev var ve en az bir fix geldi
+        bool finished = false;
+        int target = -1;                // hedef waypoint; aktif bacak target-1 -> target
+        int reached = 0;                // varılan waypoint sayısı
+        double crossTrack = 0.0;        // m, + rota sağında
+        double alongTrack = 0.0;        // m, bacak başından
+        double toTarget = 0.0;          // m
+        double toGo = 0.0;              // m, görev sonuna
+        double eta = -1.0;              // s, hız bilinmiyorsa -1
+    };
+
+    void setMission(const QVector<Waypoint> &wps);
+    // Home belli olunca; ilerleme korunur
+    void setFrame(const EnuFrame &frame);
+    void reset();
+
+    // speed: yer hızı (m/s)
+    const State &update(double lat, double lon, double speed);
+    const State &state() const { return m_state; }
+
+private:
+    void project();
+    bool arrived(int target, double x, double y, double &toTarget,
+                 double &along, double &cross) const;
+
+    QVector<Waypoint> m_wps;
+    EnuFrame m_frame;
+    bool m_hasFrame = false;
+    QVector<double> m_x, m_y;           // waypoint'ler, m (doğu, kuzey)
+    QVector<double> m_remaining;        // m_remaining[i]: wp[i]'den sona
+    int m_end = 0;                      // izlenen son waypoint + 1 (RTL'de kesilir)
+    State m_state;
+};
+
+#endif // MISSIONTRACKER_H
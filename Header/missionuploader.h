@@ -0,0 +1,117 @@
+#ifndef MISSIONUPLOADER_H
+#define MISSIONUPLOADER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QVector>
+#include "mission.h"
+
+class QTimer;
+class SerialManager;
+
+// Kayan pencereli, onaylı görev yükleme.
+//
+//   GCS -> MU_BEGIN,<n>,<crc32>,<window>
+//   FC  -> MU_READY,<n>,<have>          have: bu CRC için elindeki ardışık öğe sayısı (resume)
+//   GCS -> MU,<seq>,<lat>,<lon>,<alt>,<dist>,<radius>,<CMD>,<crc16>
+//   FC  -> MU_ACK,<seq>  |  MU_NAK,<seq>
+//   GCS -> MU_END,<crc32>
+//   FC  -> MU_DONE,<crc32>  |  MU_FAIL,<sebep>
+//
+// crc16: "seq,...,CMD" kısmının qChecksum'ı (CRC-16/ISO-3309), 4 hex hane.
+// crc32: tüm öğe gövdelerinin sırayla CRC-32'si (IEEE), 8 hex hane.
+// Araç konuşuyor ama MU_BEGIN'e cevap vermiyorsa eski WP_BEGIN/WP/WP_END ile
+// gönderilir; sonuç Unverified olur. Araç hiç konuşmuyorsa yükleme başarısızdır.
+class MissionUploader : public QObject
+{
+    Q_OBJECT
+public:
+    enum State {
+        Idle,
+        Handshake,
+        Sending,
+        Finishing,
+        Paused,     // bağlantı koptu; tekrar bağlanınca kaldığı yerden (finished gelmez)
+        Done,
+        Unverified, // eski protokolle gönderildi, araç onaylamadı
+        Failed
+    };
+
+    explicit MissionUploader(SerialManager *serial, QObject *parent = nullptr);
+
+    void start(const QVector<Waypoint> &wps);
+    void resume();
+    void cancel();
+
+    State state() const { return m_state; }
+    bool isBusy() const { return m_state == Handshake || m_state == Sending || m_state == Finishing; }
+    bool isActive() const { return isBusy() || m_state == Paused; }
+    int total() const { return m_lines.size(); }
+    int acked() const { return m_ackedCount; }
+
+    void setWindow(int window) { m_window = qBound(1, window, 64); }
+
+    // Onaylanan baytlar / geçen süre
+    double goodputBytesPerSec() const;
+    // Seri hattın teorik hızı (8N1: baud / 10)
+    double lineRateBytesPerSec() const;
+
+    static QByteArray itemPayload(int seq, const Waypoint &wp);
+    static quint32 crc32(const QByteArray &data, quint32 crc = 0);
+
+signals:
+    void progress(int acked, int total, double bytesPerSec, double lineRatePercent);
+    void paused(int acked, int total);                  // bağlantı koptu, cancel() ya da resume bekler
+    void finished(MissionUploader::State result, const QString &message);  // Done/Unverified/Failed, bir kez
+
+private slots:
+    void onLine(const QString &port, const QString &line);
+    void onTick();
+    void onDisconnected();
+    void onConnected();
+
+private:
+    enum ItemState : quint8 { Pending, InFlight, Acked };
+
+    void sendBegin();
+    void sendItem(int seq);
+    void fillWindow();
+    void onAck(int seq);
+    void finish(State result, const QString &message);
+    void sendLegacy();
+    bool write(const QByteArray &data);
+    void reportProgress();
+    qint64 rto() const;
+
+    SerialManager *m_serial;
+    QTimer *m_tick;
+
+    State m_state = Idle;
+    QVector<Waypoint> m_wps;
+    QVector<QByteArray> m_lines;        // hazır kodlanmış MU satırları
+    QVector<ItemState> m_item;
+    QVector<qint64> m_sentAt;
+    QVector<quint8> m_retries;
+    quint32 m_crc = 0;
+
+    int m_window = 8;
+    int m_inFlight = 0;
+    int m_cursor = 0;                   // ilk Pending aday
+    int m_ackedCount = 0;
+    qint64 m_ackedBytes = 0;
+
+    bool m_protocolConfirmed = false;   // araç MU_READY gönderdi mi
+    bool m_vehicleHeard = false;        // handshake sırasında araçtan herhangi bir satır geldi mi
+    int m_attempts = 0;                 // handshake / MU_END denemesi
+    qint64 m_lastControlAt = 0;
+    int m_crcRestarts = 0;
+
+    double m_srtt = 0.0;                // ms, düzgünleştirilmiş gidiş-dönüş
+    double m_rttVar = 0.0;
+
+    QElapsedTimer m_clock;
+    qint64 m_startedAt = 0;
+    qint64 m_lastProgressAt = 0;
+};
+
+#endif // MISSIONUPLOADER_H
@@ -0,0 +1,90 @@
+#ifndef MISSIONVALIDATOR_H
+#define MISSIONVALIDATOR_H
+
+#include <QString>
+#include <QVector>
+#include <vector>
+#include "mission.h"
+#include "rtree.h"
+
+// Gönderim öncesi görev kontrolü.
+//
+// Satır i'nin sorunları: noktanın kendisi (irtifa, dönüş, komut sırası) ve
+// ona giren bacak (wp[i-1] -> wp[i]) yasak bölge / geofence kontrolü.
+// Bölgelerin sınır kutuları paketlenmiş R-ağacında; bir bacak sadece kutusu
+// kesişen bölgelerle kesin testten geçer. Düzenlemede sadece etkilenen
+// satırlar (komşu bacaklar ve dönüşler) yeniden kontrol edilir.
+//
+// Kesişim testleri enlem/boylam düzleminde yapılır (doğrusal dönüşüm kesişimi
+// değiştirmez); 180. boylamı geçen bölgeler desteklenmez.
+class MissionValidator
+{
+public:
+    enum Issue : quint16 {
+        NoIssue         = 0,
+        InNoFlyZone     = 1 << 0,   // bacak yasak bölgeye giriyor
+        OutsideFence    = 1 << 1,   // bacak geofence dışına çıkıyor
+        AltitudeLow     = 1 << 2,
+        AltitudeHigh    = 1 << 3,
+        TurnTooTight    = 1 << 4,   // dönüş kabul yarıçapına sığmıyor
+        LoiterTooTight  = 1 << 5,   // loiter yarıçapı minimum dönüşten küçük
+        BadSequence     = 1 << 6    // kalkış ilk değil / inişten sonra öğe var
+    };
+
+    struct Rules {
+        float minAlt = 10.0f;           // m, kalkış/iniş hariç
+        float maxAlt = 120.0f;          // m
+        double cruiseSpeed = 15.0;      // m/s
+        double maxBankDeg = 30.0;       // minimum dönüş yarıçapı için
+    };
+
+    struct Zone {
+        QString name;
+        QVector<GeoPoint> ring;         // dış sınır, kapalı olması gerekmez
+        bool inclusion = false;         // true: geofence (içinde kalınmalı)
+    };
+
+    void setRules(const Rules &rules) { m_rules = rules; }
+    const Rules &rules() const { return m_rules; }
+
+    // Bölgeler değişince R-ağacı yeniden kurulur
+    void setZones(const QVector<Zone> &zones);
+    const QVector<Zone> &zones() const { return m_zones; }
+    // GeoJSON Polygon / MultiPolygon (Feature, FeatureCollection).
+    // properties.type == "inclusion" (ya da "geofence") olanlar geofence.
+    static bool loadZones(const QString &path, QVector<Zone> &out, QString *error = nullptr);
+
+    // v^2 / (g tan(bank))
+    double minTurnRadius() const;
+
+    void validateAll(const QVector<Waypoint> &wps);
+    // Tek satır değişti / eklendi / silindi. Sorunu değişen satır aralığı
+    // [first, last] döner (değişiklik yoksa first > last).
+    void rowChanged(const QVector<Waypoint> &wps, int row, int &first, int &last);
+    void rowInserted(const QVector<Waypoint> &wps, int row, int &first, int &last);
+    void rowRemoved(const QVector<Waypoint> &wps, int row, int &first, int &last);
+
+    quint16 issues(int row) const { return row >= 0 && row < m_issues.size() ? m_issues[row] : quint16(0); }
+    int offendingRows() const { return m_offending; }
+    // Sorunlu bacaklar (satır indeksi = hedef nokta)
+    QVector<int> offendingLegs() const;
+
+    static QString describe(quint16 issues);
+
+private:
+    quint16 checkRow(const QVector<Waypoint> &wps, int row) const;
+    quint16 checkLeg(const Waypoint &a, const Waypoint &b) const;
+    void recheck(const QVector<Waypoint> &wps, int from, int to, int &first, int &last);
+    void setIssues(int row, quint16 v);
+
+    Rules m_rules;
+    QVector<Zone> m_zones;
+    std::vector<RBox> m_zoneBoxes;
+    PackedRTree m_tree;
+    bool m_hasFence = false;
+
+    QVector<quint16> m_issues;
+    int m_offending = 0;
+};
+
+#endif // MISSIONVALIDATOR_H
@@ -0,0 +1,128 @@
+#ifndef NATIVEMAP_H
+#define NATIVEMAP_H
+
+#include <QWidget>
+#include <QHash>
+#include <QPixmap>
+#include <QPolygonF>
+#include "mapsurface.h"
+
+class QToolButton;
+class TileStore;
+
+// QtWebEngine gerektirmeyen, QPainter ile çizen harita.
+// map.html'deki işlemlerin aynısını yapar: karo piramidi, pan/zoom, UAV ikonu,
+// waypoint işaretleri (sürüklenebilir), yarıçap çemberleri, oklu rota ve pick modu.
+// Yazılımsal (raster) çizim; sadece değişen bölgeler yeniden boyanır.
+class NativeMapWidget : public QWidget, public MapSurface
+{
+    Q_OBJECT
+public:
+    NativeMapWidget(TileStore *tiles, bool pickVisible, QWidget *parent = nullptr);
+
+    QWidget *widget() const override { return const_cast<NativeMapWidget*>(this); }
+    MapBridge *bridge() const override { return m_bridge; }
+    bool isReady() const override { return true; }
+
+    void setUav(double lat, double lon, bool pan = true) override;
+    void setGpsFixState(bool fix) override;
+    void setZoom(double zoom) override;
+    void setWaypoints(const QVector<Waypoint> &wps) override;
+    void clearWaypoints() override;
+    void updateWaypoint(int index, const Waypoint &wp) override;
+    void insertWaypoint(int index, const Waypoint &wp) override;
+    void removeWaypoint(int index) override;
+    void setPolygonDrawMode(bool on) override;
+    void setZones(const QVector<QVector<GeoPoint>> &rings, const QVector<bool> &inclusion) override;
+    void setLegHighlights(const QVector<int> &legs) override;
+    void setFlightPath(const QVector<GeoPoint> &path) override;
+    void setDragWaypoint(int index) override;
+    void setActiveLeg(int index) override;
+    void setCoverageTile(const QString &id, const QImage &image,
+                         const GeoPoint &sw, const GeoPoint &ne) override;
+    void clearCoverage() override;
+
+    void centerOn(double lat, double lon);
+
+protected:
+    void paintEvent(QPaintEvent *e) override;
+    void resizeEvent(QResizeEvent *e) override;
+    void mousePressEvent(QMouseEvent *e) override;
+    void mouseMoveEvent(QMouseEvent *e) override;
+    void mouseReleaseEvent(QMouseEvent *e) override;
+    void wheelEvent(QWheelEvent *e) override;
+
+private:
+    // Web Mercator, [0,1) normalize koordinat
+    static QPointF project(double lat, double lon);
+    static void unproject(const QPointF &n, double &lat, double &lon);
+
+    double worldSize() const;
+    QPointF toScreen(double lat, double lon) const;
+    QPointF toScreen(const QPointF &n) const;
+    void toGeo(const QPointF &screen, double &lat, double &lon) const;
+    double metersPerPixel(double lat) const;
+    QRectF tileScreenRect(int z, int x, int y) const;
+    QRect uavRect() const;
+
+    void zoomAround(double zoom, const QPointF &anchor);
+    void zoomStep(double delta);
+    void togglePick();
+    void layoutButtons();
+    void onTileReady(int z, int x, int y);
+
+    static quint64 cellKey(int cx, int cy);
+
+    void paintTiles(QPainter &p, const QRect &dirty);
+    void paintWaypoints(QPainter &p);
+    void paintUav(QPainter &p);
+    void paintPolygon(QPainter &p);
+    void paintZones(QPainter &p);
+    void paintCoverage(QPainter &p);
+
+    TileStore *m_tiles;
+    MapBridge *m_bridge;
+
+    QPointF m_center;
+    double m_zoom = 16.0;
+
+    double m_uavLat;
+    double m_uavLon;
+    bool m_hasGpsFix = false;
+    bool m_follow = true;                       // kullanıcı sürükleyince kapanır
+
+    QVector<Waypoint> m_wps;
+
+    bool m_pickMode = false;
+    bool m_polyDrawMode = false;
+    QVector<GeoPoint> m_polygon;
+
+    struct ZoneShape {
+        QPolygonF ring;             // normalize Mercator
+        QRectF bounds;
+        bool inclusion;
+    };
+    QVector<ZoneShape> m_zones;
+    struct CoverageTile {
+        QImage image;
+        QRectF bounds;              // normalize Mercator
+    };
+    QHash<QString, CoverageTile> m_coverage;
+    QVector<int> m_badLegs;
+    int m_activeLeg = -1;
+    QVector<QPointF> m_flightPath;              // normalize Mercator; boşsa düz rota
+    bool m_pressed = false;
+    bool m_dragging = false;
+    int m_dragRow = -1;                         // sürüklenen waypoint
+    QPoint m_pressPos;
+    QPoint m_lastPos;
+
+    QPixmap m_uavIcon;
+    QPixmap m_markerIcon;
+
+    QToolButton *m_btnZoomIn;
+    QToolButton *m_btnZoomOut;
+    QToolButton *m_btnPick;
+};
+
+#endif // NATIVEMAP_H
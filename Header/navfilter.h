@@ -0,0 +1,101 @@
+#ifndef NAVFILTER_H
+#define NAVFILTER_H
+
+#include <array>
+#include "enuframe.h"
+
+// GPS + IMU birleştirme: hata durumlu (error-state) Kalman filtresi.
+//
+// Nominal durum: konum ve hız (yerel ENU, m), yönelim (gövde -> ENU
+// kuaterniyonu), ivmeölçer ve jiroskop sapmaları. Her IMU örneğinde nominal
+// durum ivme/açısal hızla ilerletilir, 15 boyutlu hata kovaryansı yayılır.
+// GPS fix'i geldiğinde konum (3) ve yer hızı (skaler) ölçümleriyle hata durumu
+// kestirilir, nominal duruma eklenir. Sonuç: fix'ler arasında IMU hızında,
+// kovaryanslı konum/hız.
+//
+// Gövde ekseni: x sağ, y ileri, z yukarı (DATA ham değerleri bu düzende;
+// düz dururken az = +1 g). Başlangıç yönü bilinmez: araç ileri doğru uçtuğu
+// varsayılarak ilk hareketli fix çiftinin rotasından alınır. O zamana kadar
+// yatay ivme kullanılmaz (sabit hız modeli).
+//
+// Zaman damgaları saniye, monoton; mesajların alındığı an. Sıralı gelmeyen ya
+// da çok seyrek IMU örnekleri (MAX_DT) güvenli şekilde kırpılır.
+class NavFilter
+{
+public:
+    struct Noise {
+        double accel = 0.5;             // m/s^2/sqrt(Hz), ivme gürültüsü
+        double gyro = 0.01;             // rad/s/sqrt(Hz)
+        double accelBias = 0.02;        // m/s^2/sqrt(s), sapma yürüyüşü
+        double gyroBias = 0.0005;       // rad/s/sqrt(s)
+        double gpsH = 2.5;              // m, yatay konum
+        double gpsV = 5.0;              // m, irtifa
+        double gpsSpeed = 0.5;          // m/s
+        double noImuAccel = 3.0;        // m/s^2/sqrt(Hz); IMU yokken sabit hız modeli
+    };
+
+    struct State {
+        bool valid = false;
+        double lat = 0.0, lon = 0.0, alt = 0.0;
+        double east = 0.0, north = 0.0, up = 0.0;   // m, filtre orijinine göre
+        double vEast = 0.0, vNorth = 0.0, vUp = 0.0;
+        double speed = 0.0;             // m/s, yatay
+        double course = 0.0;            // derece, kuzeyden saat yönü
+        double sigmaH = 0.0;            // m, yatay konum 1-sigma
+        double sigmaV = 0.0;            // m, düşey
+        bool headingValid = false;
+    };
+
+    static constexpr double MAX_DT = 0.1;           // s, tek adımda en çok
+    static constexpr double MAX_EXTRAPOLATE = 0.5;  // s, state() ileri tahmin sınırı
+    static constexpr double GPS_TIMEOUT = 3.0;      // s, bu kadar fix yoksa geçersiz
+
+    void setNoise(const Noise &noise) { m_noise = noise; }
+    void reset();
+
+    // acc: m/s^2 (özgül kuvvet), gyro: rad/s; gövde ekseninde
+    void imu(double t, const double acc[3], const double gyro[3]);
+    // speed: yer hızı (m/s)
+    void gps(double t, double lat, double lon, double alt, double speed);
+
+    bool isValid(double t) const { return m_init && t - m_lastGps <= GPS_TIMEOUT; }
+    // t anına (en çok MAX_EXTRAPOLATE) sabit hızla ilerletilmiş durum
+    State state(double t) const;
+
+    const EnuFrame &frame() const { return m_frame; }
+    int rejectedFixes() const { return m_rejected; }
+
+private:
+    static constexpr int N = 15;
+    using Mat = std::array<double, N * N>;
+    using Vec3 = std::array<double, 3>;
+
+    void init(double t, double lat, double lon, double alt);
+    void predict(double dt, const Vec3 &acc, const Vec3 &gyro, bool useImu);
+    void alignHeading(double course);
+    bool update(const double *H, int rows, const double *y, const double *R, double gate);
+    void inject(const double *dx);
+    void rotation(double R[9]) const;
+
+    Noise m_noise;
+    EnuFrame m_frame;
+    bool m_init = false;
+    bool m_headingValid = false;
+    double m_t = 0.0;                   // durumun zamanı
+    double m_lastImu = -1e9;
+    double m_lastGps = -1e9;
+    int m_rejected = 0;                 // art arda reddedilen fix
+
+    Vec3 m_p{}, m_v{};
+    std::array<double, 4> m_q{1.0, 0.0, 0.0, 0.0};  // w, x, y, z
+    Vec3 m_ba{}, m_bg{};
+    Vec3 m_lastAcc{}, m_lastGyro{};
+    bool m_hasAcc = false;
+    Mat m_P{};
+
+    // Rota için önceki fix (yerel düzlem)
+    bool m_hasPrevFix = false;
+    double m_prevE = 0.0, m_prevN = 0.0;
+};
+
+#endif // NAVFILTER_H
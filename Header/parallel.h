@@ -0,0 +1,38 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <QSemaphore>
+#include <QThreadPool>
+#include <QtGlobal>
+
+#include <atomic>
+
+// [0, n) aralığını chunk'lık parçalar halinde global havuzda işler:
+// body(from, to). Parçalar bir sayaçtan çekilir, çağıran thread da çalışır;
+// havuzda boş thread yoksa iş seri biter, bekleme kilitlenmez.
+// threads <= 0: havuzun thread sayısı.
+template <typename F>
+void parallelFor(int n, int chunk, int threads, F &&body)
+{
+    const int chunks = (n + chunk - 1) / chunk;
+    if (chunks <= 0) return;
+    std::atomic<int> next{0};
+    auto run = [&]() {
+        for (int c = next.fetch_add(1); c < chunks; c = next.fetch_add(1))
+            body(c * chunk, qMin(n, (c + 1) * chunk));
+    };
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int workers = qBound(1, threads > 0 ? threads : pool->maxThreadCount(), chunks);
+    QSemaphore exited;
+    int started = 0;
+    for (int w = 1; w < workers; ++w) {
+        if (!pool->tryStart([&]() { run(); exited.release(); }))
+            break;
+        ++started;
+    }
+    run();
+    exited.acquire(started);
+}
+
+#endif // PARALLEL_H
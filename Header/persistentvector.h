@@ -0,0 +1,234 @@
+#ifndef PERSISTENTVECTOR_H
+#define PERSISTENTVECTOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+// Değiştirilemez (persistent) dizi: boyut etiketli B+ ağacı, yapraklar en
+// fazla B öğe tutar. set / insert / erase kökten yaprağa kadar olan yolu
+// kopyalar (O(log n) düğüm, her biri en fazla B eleman); geri kalan düğümler
+// eski sürümle paylaşılır. Sürüm kopyalamak sadece bir kök işaretçisidir.
+//
+// Silmede düğümler birleştirilmez; boşalan düğüm atılır. Yükseklik yine de
+// ulaşılan en büyük boyutun log_B'si ile sınırlıdır.
+template <typename T, int B = 32>
+class PersistentVector
+{
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Node {
+        bool leaf = true;
+        int size = 0;                       // alt ağaçtaki öğe sayısı
+        std::vector<T> items;               // yaprak
+        std::vector<NodePtr> children;      // iç düğüm
+    };
+
+public:
+    PersistentVector() = default;
+
+    // O(n), tek geçişte dengeli ağaç
+    static PersistentVector fromArray(const T *data, int n)
+    {
+        PersistentVector v;
+        if (n <= 0) return v;
+
+        std::vector<NodePtr> level;
+        level.reserve((n + B - 1) / B);
+        for (int i = 0; i < n; i += B) {
+            auto leaf = std::make_shared<Node>();
+            leaf->items.assign(data + i, data + std::min(n, i + B));
+            leaf->size = int(leaf->items.size());
+            level.push_back(std::move(leaf));
+        }
+        while (level.size() > 1) {
+            std::vector<NodePtr> up;
+            up.reserve((level.size() + B - 1) / B);
+            for (size_t i = 0; i < level.size(); i += B) {
+                auto inner = std::make_shared<Node>();
+                inner->leaf = false;
+                inner->children.assign(level.begin() + i, level.begin() + std::min(level.size(), i + B));
+                for (const NodePtr &c : inner->children) inner->size += c->size;
+                up.push_back(std::move(inner));
+            }
+            level.swap(up);
+        }
+        v.m_root = level.front();
+        return v;
+    }
+
+    int size() const { return m_root ? m_root->size : 0; }
+    bool isEmpty() const { return size() == 0; }
+
+    // Aynı kökü paylaşan iki sürüm eşittir (içerik karşılaştırılmaz)
+    bool isSameVersion(const PersistentVector &o) const { return m_root == o.m_root; }
+
+    const T &at(int i) const
+    {
+        assert(i >= 0 && i < size());
+        const Node *n = m_root.get();
+        while (!n->leaf) {
+            const int k = childFor(n, i);
+            n = n->children[k].get();
+        }
+        return n->items[i];
+    }
+
+    // Sıralı okuma: n öğe out'a yazılır
+    void copyTo(T *out) const
+    {
+        if (m_root) copyRec(m_root.get(), out);
+    }
+
+    PersistentVector set(int i, const T &value) const
+    {
+        assert(i >= 0 && i < size());
+        PersistentVector v;
+        v.m_root = setRec(m_root, i, value);
+        return v;
+    }
+
+    PersistentVector insert(int i, const T &value) const
+    {
+        assert(i >= 0 && i <= size());
+        PersistentVector v;
+        if (!m_root) {
+            auto leaf = std::make_shared<Node>();
+            leaf->items.push_back(value);
+            leaf->size = 1;
+            v.m_root = std::move(leaf);
+            return v;
+        }
+
+        NodePtr right;
+        NodePtr left = insertRec(m_root, i, value, right);
+        if (!right) {
+            v.m_root = std::move(left);
+            return v;
+        }
+        // Kök bölündü: ağaç bir seviye uzar
+        auto root = std::make_shared<Node>();
+        root->leaf = false;
+        root->size = left->size + right->size;
+        root->children = {std::move(left), std::move(right)};
+        v.m_root = std::move(root);
+        return v;
+    }
+
+    PersistentVector append(const T &value) const { return insert(size(), value); }
+
+    PersistentVector erase(int i) const
+    {
+        assert(i >= 0 && i < size());
+        PersistentVector v;
+        NodePtr root = eraseRec(m_root, i);
+        // Tek çocuklu kökleri at
+        while (root && !root->leaf && root->children.size() == 1)
+            root = root->children.front();
+        v.m_root = std::move(root);
+        return v;
+    }
+
+private:
+    static int childFor(const Node *n, int &i)
+    {
+        int k = 0;
+        while (i >= n->children[k]->size) {
+            i -= n->children[k]->size;
+            ++k;
+        }
+        return k;
+    }
+
+    static void copyRec(const Node *n, T *&out)
+    {
+        if (n->leaf) {
+            out = std::copy(n->items.begin(), n->items.end(), out);
+            return;
+        }
+        for (const NodePtr &c : n->children) copyRec(c.get(), out);
+    }
+
+    static NodePtr setRec(const NodePtr &node, int i, const T &value)
+    {
+        auto copy = std::make_shared<Node>(*node);
+        if (copy->leaf) {
+            copy->items[i] = value;
+        } else {
+            const int k = childFor(node.get(), i);
+            copy->children[k] = setRec(node->children[k], i, value);
+        }
+        return copy;
+    }
+
+    // Düğüm taşarsa ikiye bölünür; sağ yarı 'split' ile döner
+    static NodePtr insertRec(const NodePtr &node, int i, const T &value, NodePtr &split)
+    {
+        auto copy = std::make_shared<Node>(*node);
+        ++copy->size;
+
+        if (copy->leaf) {
+            copy->items.insert(copy->items.begin() + i, value);
+            if (int(copy->items.size()) > B) {
+                auto right = std::make_shared<Node>();
+                const int half = int(copy->items.size()) / 2;
+                right->items.assign(copy->items.begin() + half, copy->items.end());
+                right->size = int(right->items.size());
+                copy->items.resize(half);
+                copy->size = half;
+                split = std::move(right);
+            }
+            return copy;
+        }
+
+        // i == size ise son çocuğa eklenir
+        int k = 0;
+        while (k + 1 < int(node->children.size()) && i > node->children[k]->size) {
+            i -= node->children[k]->size;
+            ++k;
+        }
+        NodePtr childSplit;
+        copy->children[k] = insertRec(node->children[k], i, value, childSplit);
+        if (childSplit)
+            copy->children.insert(copy->children.begin() + k + 1, std::move(childSplit));
+
+        if (int(copy->children.size()) > B) {
+            auto right = std::make_shared<Node>();
+            right->leaf = false;
+            const int half = int(copy->children.size()) / 2;
+            right->children.assign(copy->children.begin() + half, copy->children.end());
+            copy->children.resize(half);
+            for (const NodePtr &c : right->children) right->size += c->size;
+            copy->size -= right->size;
+            split = std::move(right);
+        }
+        return copy;
+    }
+
+    // Boşalan düğüm için nullptr
+    static NodePtr eraseRec(const NodePtr &node, int i)
+    {
+        if (node->size == 1) return nullptr;
+
+        auto copy = std::make_shared<Node>(*node);
+        --copy->size;
+        if (copy->leaf) {
+            copy->items.erase(copy->items.begin() + i);
+            return copy;
+        }
+
+        const int k = childFor(node.get(), i);
+        NodePtr child = eraseRec(node->children[k], i);
+        if (child)
+            copy->children[k] = std::move(child);
+        else
+            copy->children.erase(copy->children.begin() + k);
+        return copy;
+    }
+
+    NodePtr m_root;
+};
+
+#endif // PERSISTENTVECTOR_H
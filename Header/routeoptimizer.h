@@ -0,0 +1,71 @@
+#ifndef ROUTEOPTIMIZER_H
+#define ROUTEOPTIMIZER_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include "mission.h"
+
+// Denetim görevleri için waypoint sırası iyileştirme (açık uçlu TSP).
+// Baştaki TAKEOFF/VTOL_TAKEOFF ve sondaki LAND/VTOL_LAND/RTL yerinde kalır;
+// aradaki noktalar toplam mesafe en kısa olacak şekilde yeniden sıralanır.
+//
+// Mesafe matrisi bir kez (haversineBatch ile) hesaplanır. Her başlangıç
+// (en yakın komşu, mevcut sıra, rastgeleleştirilmiş en yakın komşu) 2-opt ve
+// Or-opt ile yerel optimuma indirilir; başlangıçlar QThreadPool'da paralel
+// koşar, en iyisi seçilir. cancel() ile yarıda kesilirse o ana kadarki en iyi
+// sonuç döner.
+class RouteOptimizer : public QObject
+{
+    Q_OBJECT
+public:
+    struct Result {
+        QVector<Waypoint> wps;      // yeni sıra
+        QVector<int> order;         // order[i]: yeni i. satırın eski satırı
+        double before = 0.0;        // m, başlangıç/bitiş bağlantıları dahil
+        double after = 0.0;
+        int starts = 0;             // tamamlanan başlangıç
+        bool cancelled = false;
+        qint64 elapsedMs = 0;
+
+        bool improved() const { return after < before - 0.5; }
+    };
+
+    using Progress = std::function<void(int done, int total)>;
+
+    explicit RouteOptimizer(QObject *parent = nullptr);
+    ~RouteOptimizer() override;
+
+    // Sabit uçlar: baştaki kalkış ve sondaki iniş/RTL satır sayısı
+    static void fixedEnds(const QVector<Waypoint> &wps, int &head, int &tail);
+
+    // Senkron çekirdek. home: RTL ve kalkışsız görevler için bağlantı noktası
+    // (nullptr: açık uç). starts = 0: thread sayısına göre. threads = 1: seri.
+    static Result optimize(const QVector<Waypoint> &wps, const GeoPoint *home,
+                           int starts = 0, int threads = 0,
+                           const std::atomic<bool> *cancel = nullptr,
+                           const Progress &progress = Progress());
+
+    // Arka planda (kendi havuzunda) çalışır; sonuç finished() ile GUI
+    // thread'ine gelir. Çalışan iş varsa önce iptal edilir (sonucu gelmez).
+    // Yıkıcı işi iptal edip bitmesini bekler: iş nesneden uzun yaşamaz.
+    void start(const QVector<Waypoint> &wps, const GeoPoint *home, int starts = 0);
+    void cancel();
+    // İptal eder ve sonucu bekleme (görev bu arada değişti)
+    void discard();
+    bool isRunning() const { return m_running; }
+
+signals:
+    void progress(int done, int total);
+    void finished(const RouteOptimizer::Result &result);
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_cancel;
+    bool m_running = false;
+    QThreadPool m_pool;
+};
+
+#endif // ROUTEOPTIMIZER_H
@@ -0,0 +1,132 @@
+#ifndef RTREE_H
+#define RTREE_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+struct RBox {
+    double minX = 0.0;
+    double minY = 0.0;
+    double maxX = 0.0;
+    double maxY = 0.0;
+
+    bool intersects(const RBox &o) const
+    {
+        return minX <= o.maxX && o.minX <= maxX && minY <= o.maxY && o.minY <= maxY;
+    }
+
+    void expand(const RBox &o)
+    {
+        minX = std::min(minX, o.minX);
+        minY = std::min(minY, o.minY);
+        maxX = std::max(maxX, o.maxX);
+        maxY = std::max(maxY, o.maxY);
+    }
+};
+
+// Statik, paketlenmiş R-ağacı (Sort-Tile-Recursive). Bir kez kurulur, sonra
+// sadece sorgulanır; bölge listesi değişince baştan kurulur (O(n log n)).
+// Düğümler seviye seviye tek dizide: işaretçi yok, önbellek dostu.
+class PackedRTree
+{
+public:
+    static constexpr int NODE = 16;
+
+    void build(const std::vector<RBox> &boxes)
+    {
+        m_boxes.clear();
+        m_ids.clear();
+        m_levels.clear();
+
+        const int n = int(boxes.size());
+        if (n == 0) return;
+
+        // Yapraklar: x dilimleri, her dilim kendi içinde y'ye göre
+        std::vector<int> order(n);
+        for (int i = 0; i < n; ++i) order[i] = i;
+        auto cx = [&](int i) { return boxes[i].minX + boxes[i].maxX; };
+        auto cy = [&](int i) { return boxes[i].minY + boxes[i].maxY; };
+
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return cx(a) < cx(b); });
+        const int leafNodes = (n + NODE - 1) / NODE;
+        const int slices = int(std::ceil(std::sqrt(double(leafNodes))));
+        const int sliceSize = slices * NODE;
+        for (int s = 0; s < n; s += sliceSize)
+            std::sort(order.begin() + s, order.begin() + std::min(n, s + sliceSize),
+                      [&](int a, int b) { return cy(a) < cy(b); });
+
+        m_boxes.reserve(n + n / (NODE - 1) + 1);
+        m_ids.reserve(m_boxes.capacity());
+        for (int i : order) {
+            m_boxes.push_back(boxes[i]);
+            m_ids.push_back(i);
+        }
+        m_levels.push_back(0);
+
+        // Üst seviyeler: ardışık NODE kutu bir düğüm; id = ilk çocuğun konumu
+        int begin = 0, end = n;
+        while (end - begin > 1) {
+            m_levels.push_back(end);
+            for (int i = begin; i < end; i += NODE) {
+                RBox b = m_boxes[i];
+                for (int k = i + 1; k < std::min(end, i + NODE); ++k)
+                    b.expand(m_boxes[k]);
+                m_boxes.push_back(b);
+                m_ids.push_back(i);
+            }
+            begin = end;
+            end = int(m_boxes.size());
+        }
+        m_levels.push_back(end);
+    }
+
+    int size() const { return m_levels.empty() ? 0 : m_levels[1]; }
+    bool isEmpty() const { return size() == 0; }
+
+    // q ile kesişen her kutu için f(id)
+    template <typename F>
+    void query(const RBox &q, F &&f) const
+    {
+        if (m_boxes.empty()) return;
+
+        // (konum, seviye) yığını; kök en son eklenen kutu. Derinlik başına en
+        // fazla NODE-1 bekleyen düğüm: 2^31 öğede bile 256 yeter.
+        int stack[256][2];
+        int top = 0;
+        const int rootLevel = int(m_levels.size()) - 2;
+        stack[top][0] = int(m_boxes.size()) - 1;
+        stack[top][1] = rootLevel;
+        ++top;
+
+        while (top > 0) {
+            --top;
+            const int pos = stack[top][0];
+            const int level = stack[top][1];
+            if (!m_boxes[pos].intersects(q)) continue;
+
+            if (level == 0) {
+                f(m_ids[pos]);
+                continue;
+            }
+            const int first = m_ids[pos];
+            const int last = std::min(first + NODE, m_levels[level]);
+            for (int c = first; c < last; ++c) {
+                if (level - 1 == 0) {
+                    if (m_boxes[c].intersects(q)) f(m_ids[c]);
+                } else {
+                    stack[top][0] = c;
+                    stack[top][1] = level - 1;
+                    ++top;
+                }
+            }
+        }
+    }
+
+private:
+    std::vector<RBox> m_boxes;      // tüm seviyeler, yapraklar önce
+    std::vector<int> m_ids;         // yaprak: öğe id, iç düğüm: ilk çocuğun konumu
+    std::vector<int> m_levels;      // her seviyenin başlangıcı (+ son)
+};
+
+#endif // RTREE_H
@@ -14,10 +14,13 @@ public:
     ~SerialManager();
     bool connectSerial(const QString &portName);
     bool send(const QString &portName, const QString &message);
+    // Bloklamadan yazar, satır sonu eklemez (toplu aktarım için)
+    bool write(const QByteArray &data);
     QString receive(const QString &portName);
     void disconnectSerial(QString portName);
     bool isConnected() const;
     QString currentPortName() const;
+    qint32 baudRate() const { return m_serial->baudRate(); }
     void setPortName(QString portName);
     void clearRx();
 
@@ -0,0 +1,29 @@
+#ifndef SURVEY_H
+#define SURVEY_H
+
+#include <QVector>
+#include "mission.h"
+
+// Çizilen poligon için boustrophedon (çim biçme) tarama deseni.
+struct SurveyParams {
+    double spacing  = 30.0;     // m, tek hattın kapsama genişliği
+    double overlap  = 20.0;     // %, yan bindirme
+    double heading  = 0.0;      // derece, hatların yönü (kuzeyden saat yönü)
+    double altitude = 40.0;     // m
+    double radius   = 10.0;     // m, waypoint yarıçapı
+};
+
+namespace Survey {
+
+// Poligon ağırlık merkezinde yerel ENU düzlemine izdüşürülür, hat yönüne
+// döndürülür ve her tarama hattı poligon kenarlarıyla kesilir (içbükey
+// poligonlarda bir hat birden fazla parçaya bölünür). Her parça için giriş ve
+// çıkış waypoint'i üretilir; hatlar sırayla ters yönde gezilir.
+QVector<Waypoint> generate(const QVector<GeoPoint> &polygon, const SurveyParams &params);
+
+// Hatlar arası gerçek mesafe: spacing * (1 - overlap)
+double lineSpacing(const SurveyParams &params);
+
+}
+
+#endif // SURVEY_H
@@ -0,0 +1,50 @@
+#ifndef TILESTORE_H
+#define TILESTORE_H
+
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QSet>
+#include <QThreadPool>
+
+class QNetworkAccessManager;
+
+// Yerli harita için uydu karo deposu.
+// Karolar diskte QNetworkDiskCache ile, bellekte çözülmüş QImage olarak tutulur.
+// PNG/JPEG çözme işi depo'nun kendi QThreadPool'unda yapılır, GUI thread'i
+// beklemez; yıkıcı bekleyen çözmelerin bitmesini bekler.
+class TileStore : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TileStore(QObject *parent = nullptr);
+    ~TileStore() override;
+
+    static constexpr int TILE_SIZE = 256;
+    static constexpr int MAX_NATIVE_ZOOM = 19;
+
+    // Bellekteki karo; yoksa null döner ve indirme/çözme başlatılır.
+    QImage tile(int z, int x, int y);
+    bool contains(int z, int x, int y) const;
+    void request(int z, int x, int y);
+
+    static quint64 key(int z, int x, int y)
+    {
+        return (quint64(z) << 58) | (quint64(x) << 29) | quint64(y);
+    }
+
+signals:
+    void tileReady(int z, int x, int y);
+
+private:
+    void onDecoded(quint64 k, int z, int x, int y, const QImage &img);
+
+    QNetworkAccessManager *m_net;
+    QCache<quint64, QImage> m_memory;   // maliyet: KB
+    QSet<quint64> m_pending;
+    QHash<quint64, qint64> m_failedAt;  // ms; kısa süre tekrar istenmez
+    QThreadPool m_pool;
+};
+
+#endif // TILESTORE_H
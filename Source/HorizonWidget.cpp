@@ -3,6 +3,8 @@
 #include <QtMath>
 #include <QPainterPath>
 
+static constexpr double MAX_PITCH = 45.0;    // ufuk çizgisi aşırı kaçmasın
+
 HorizonWidget::HorizonWidget(QWidget *parent) : QWidget(parent)
 {
     setMinimumSize(250, 160);
@@ -16,52 +18,50 @@ void HorizonWidget::setAttitude(double rollDeg, double pitchDeg)
     update();
 }
 
-void HorizonWidget::paintEvent(QPaintEvent *)
+void HorizonWidget::setLayerCache(bool on)
 {
-    QPainter p(this);
-    p.setRenderHint(QPainter::Antialiasing, true);
-
-    const int w = width();
-    const int h = height();
-    const QPointF c(w * 0.5, h * 0.5);
+    m_layerCache = on;
+    if (!on) {
+        m_world = QPixmap();
+        m_overlay = QPixmap();
+        m_cacheSize = QSize();
+    }
+    update();
+}
 
-    // Daire mask (Mission Planner gibi)
-    const double R = qMin(w, h) * 0.48;
-    QPainterPath clip;
-    clip.addEllipse(c, R, R);
-    p.setClipPath(clip);
+void HorizonWidget::resizeEvent(QResizeEvent *e)
+{
+    QWidget::resizeEvent(e);
+    m_cacheSize = QSize();      // bir sonraki paintEvent'te yeniden çizilir
+}
 
-    // Pitch clamp (ufuk çizgisi aşırı kaçmasın)
-    double pitch = clamp(m_pitchDeg, -45.0, 45.0);
-    double roll  = m_rollDeg;
+void HorizonWidget::paintEvent(QPaintEvent *)
+{
+    QPainter p(this);
+    if (m_layerCache)
+        paintCached(p);
+    else
+        paintDirect(p);
+}
 
+// Sky/ground, ufuk çizgisi ve pitch merdiveni. p'nin orijini ufkun ortası,
+// halfW/halfH boyalı alanın yarı boyutu.
+void HorizonWidget::drawWorld(QPainter &p, double R, double halfW, double halfH)
+{
     // Deg->pixel ölçeği: 1 derece kaç pixel kaydıracak?
     // Mission Planner hissi için R/30 iyi başlangıç (30° -> yarıçap kadar)
     const double pxPerDeg = R / 30.0;
-    const double pitchOffsetPx = pitch * pxPerDeg;
-
-    // Dünya (sky/ground) için transform:
-    // 1) merkeze gel
-    // 2) roll kadar döndür
-    // 3) pitch kadar yukarı/aşağı kaydır (döndürülmüş eksende)
-    p.translate(c);
-    p.rotate(-roll);              // eksi: ekranda sağa yatma hisleri için
-    p.translate(0, pitchOffsetPx);
-
-    // Arka plan: üst mavi (sky), alt yeşil (ground)
-    // (clip zaten var; büyük rect çiziyoruz)
-    QRectF big(-w, -h, w * 2.0, h * 2.0);
 
     // Sky
-    p.fillRect(QRectF(big.left(), big.top(), big.width(), big.height()/2.0), QColor("#86AEEB"));
+    p.fillRect(QRectF(-halfW, -halfH, halfW * 2.0, halfH), QColor("#86AEEB"));
     // Ground
-    p.fillRect(QRectF(big.left(), 0, big.width(), big.height()/2.0), QColor("#6FAE3A"));
+    p.fillRect(QRectF(-halfW, 0, halfW * 2.0, halfH), QColor("#6FAE3A"));
 
     // Ufuk çizgisi (white)
     QPen horizonPen(Qt::white);
     horizonPen.setWidthF(3.0);
     p.setPen(horizonPen);
-    p.drawLine(QPointF(-w, 0), QPointF(w, 0));
+    p.drawLine(QPointF(-halfW, 0), QPointF(halfW, 0));
 
     // Pitch ladder (10° aralık, Mission Planner benzeri)
     // çizgiler ufka paralel (y=const), yazılar sağ/sol
@@ -95,19 +95,18 @@ void HorizonWidget::paintEvent(QPaintEvent *)
         if (deg == 0) continue;
         drawPitchMark(deg);
     }
+}
 
-    // Transform’u geri al (uçak sembolü sabit kalacak)
-    p.resetTransform();
-    p.setClipping(false);
-
-    // Daire çerçevesi
+// Daire çerçevesi ve ortadaki sabit uçak sembolü (widget koordinatında)
+void HorizonWidget::drawOverlay(QPainter &p, const QPointF &c, double R)
+{
     QPen ringPen(QColor("#D8D8D8"));
     ringPen.setWidthF(3.0);
     p.setPen(ringPen);
     p.setBrush(Qt::NoBrush);
     p.drawEllipse(c, R, R);
 
-    // Ortadaki sabit "aircraft" sembolü (kırmızı kanatlar + orta işaret)
+    // Kırmızı kanatlar + orta işaret
     QPen planePen(QColor("#E02020"));
     planePen.setWidthF(4.0);
     p.setPen(planePen);
@@ -131,3 +130,97 @@ void HorizonWidget::paintEvent(QPaintEvent *)
 
     // (İstersen üstte roll scale / tick’ler de ekleriz)
 }
+
+// Eski yol: clip path, font ve merdivenin tamamı her karede baştan
+void HorizonWidget::paintDirect(QPainter &p)
+{
+    p.setRenderHint(QPainter::Antialiasing, true);
+
+    const int w = width();
+    const int h = height();
+    const QPointF c(w * 0.5, h * 0.5);
+
+    // Daire mask (Mission Planner gibi)
+    const double R = qMin(w, h) * 0.48;
+    QPainterPath clip;
+    clip.addEllipse(c, R, R);
+    p.setClipPath(clip);
+
+    const double pitch = clamp(m_pitchDeg, -MAX_PITCH, MAX_PITCH);
+
+    // Dünya (sky/ground) için transform:
+    // 1) merkeze gel
+    // 2) roll kadar döndür
+    // 3) pitch kadar yukarı/aşağı kaydır (döndürülmüş eksende)
+    p.translate(c);
+    p.rotate(-m_rollDeg);         // eksi: ekranda sağa yatma hisleri için
+    p.translate(0, pitch * R / 30.0);
+    drawWorld(p, R, w, h);
+
+    // Transform’u geri al (uçak sembolü sabit kalacak)
+    p.resetTransform();
+    p.setClipping(false);
+    drawOverlay(p, c, R);
+}
+
+// Katmanlar sadece boyut ya da ekran ölçeği (DPR) değişince çizilir
+void HorizonWidget::rebuildLayers()
+{
+    const qreal dpr = devicePixelRatioF();
+    const int w = width();
+    const int h = height();
+    const QPointF c(w * 0.5, h * 0.5);
+    const double R = qMin(w, h) * 0.48;
+
+    // Dünya katmanı: daire her roll açısında ±R, pitch kaydırması ±45° kadar
+    // dışarı taşabilir. Birkaç pixel pay, döndürülmüş kenar görünmesin.
+    const double halfW = R + 4.0;
+    const double halfH = R + MAX_PITCH * R / 30.0 + 4.0;
+    m_world = QPixmap(QSize(qCeil(halfW * 2.0 * dpr), qCeil(halfH * 2.0 * dpr)));
+    m_world.setDevicePixelRatio(dpr);
+    {
+        QPainter wp(&m_world);
+        wp.setRenderHint(QPainter::Antialiasing, true);
+        wp.setFont(font());
+        const QSizeF ws = m_world.deviceIndependentSize();
+        wp.translate(ws.width() * 0.5, ws.height() * 0.5);     // ufuk = pixmap merkezi
+        drawWorld(wp, R, ws.width() * 0.5, ws.height() * 0.5);
+    }
+
+    m_overlay = QPixmap(size() * dpr);
+    m_overlay.setDevicePixelRatio(dpr);
+    m_overlay.fill(Qt::transparent);
+    {
+        QPainter op(&m_overlay);
+        op.setRenderHint(QPainter::Antialiasing, true);
+        drawOverlay(op, c, R);
+    }
+
+    // Kenar basamakları 3 px halkanın altında kalır; antialias'lı clip path'e gerek yok
+    m_clip = QRegion(QRectF(c.x() - R, c.y() - R, 2.0 * R, 2.0 * R).toAlignedRect(), QRegion::Ellipse);
+
+    m_cacheSize = size();
+    m_cacheDpr = dpr;
+}
+
+void HorizonWidget::paintCached(QPainter &p)
+{
+    if (m_cacheSize != size() || m_cacheDpr != devicePixelRatioF())
+        rebuildLayers();
+
+    const QPointF c(width() * 0.5, height() * 0.5);
+    const double R = qMin(width(), height()) * 0.48;
+    const double pitch = clamp(m_pitchDeg, -MAX_PITCH, MAX_PITCH);
+    const QSizeF ws = m_world.deviceIndependentSize();
+
+    p.setClipRegion(m_clip);
+    p.setRenderHint(QPainter::SmoothPixmapTransform, true);
+    p.translate(c);
+    p.rotate(-m_rollDeg);
+    p.translate(0, pitch * R / 30.0);
+    p.drawPixmap(QPointF(-ws.width() * 0.5, -ws.height() * 0.5), m_world);
+
+    p.resetTransform();
+    p.setClipping(false);
+    p.drawPixmap(0, 0, m_overlay);
+}
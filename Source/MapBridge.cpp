@@ -1,4 +1,6 @@
 #include "MapBridge.h"
+#include <QJsonArray>
+#include <QJsonDocument>
 
 
 
@@ -22,3 +24,36 @@ void MapBridge::onZoomChangedFromJs(double zoom)
 {
     emit zoomLevelChanged(zoom);
 }
+
+void MapBridge::onMapPressed(double lat, double lng, double zoom)
+{
+    emit mapPressed(lat, lng, zoom);
+}
+
+void MapBridge::onMapDragged(double lat, double lng)
+{
+    emit mapDragged(lat, lng);
+}
+
+void MapBridge::onMapReleased(double lat, double lng)
+{
+    emit mapReleased(lat, lng);
+}
+
+// json: [[lat, lng], ...]
+void MapBridge::onPolygonDrawn(const QString &json)
+{
+    const QJsonArray arr = QJsonDocument::fromJson(json.toUtf8()).array();
+
+    QVector<GeoPoint> polygon;
+    polygon.reserve(arr.size());
+    for (const auto &v : arr) {
+        const QJsonArray p = v.toArray();
+        if (p.size() < 2) continue;
+        polygon.push_back({ p[0].toDouble(), p[1].toDouble() });
+    }
+
+    qDebug() << "[MAP POLYGON] vertices =" << polygon.size();
+    if (polygon.size() >= 3)
+        emit polygonDrawn(polygon);
+}
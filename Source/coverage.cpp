@@ -0,0 +1,197 @@
+#include "coverage.h"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr double MIN_STEP_M = 0.5 * CoverageMap::CELL_M;   // altında nokta birikir
+
+static inline quint64 makeKey(int tx, int ty)
+{
+    return (quint64(quint32(tx)) << 32) | quint32(ty);
+}
+
+static inline int keyX(quint64 key) { return int(quint32(key >> 32)); }
+static inline int keyY(quint64 key) { return int(quint32(key)); }
+
+static inline int floorDiv(int a, int b)
+{
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+void CoverageMap::setFrame(const EnuFrame &frame)
+{
+    m_frame = frame;
+    clear();
+}
+
+void CoverageMap::clear()
+{
+    m_tiles.clear();
+    m_dirty.clear();
+    m_coveredCells = 0;
+    m_hasLast = false;
+    m_seg = 0;
+    m_cachedKey = ~quint64(0);
+    m_cachedTile = nullptr;
+}
+
+// Aynı geçişte (önceki ya da bu parça) damgalanmış hücre tekrar sayılmaz
+void CoverageMap::stampCell(int cx, int cy)
+{
+    const int tx = floorDiv(cx, TILE), ty = floorDiv(cy, TILE);
+    const quint64 key = makeKey(tx, ty);
+    if (key != m_cachedKey || !m_cachedTile) {
+        auto it = m_tiles.find(key);
+        if (it == m_tiles.end()) {
+            it = m_tiles.insert(key, Tile());
+            it->passes.assign(size_t(TILE) * TILE, 0);
+            it->lastSeg.assign(size_t(TILE) * TILE, 0);
+        }
+        m_cachedKey = key;
+        m_cachedTile = &it.value();
+    }
+
+    const size_t idx = size_t(cy - ty * TILE) * TILE + (cx - tx * TILE);
+    quint32 &last = m_cachedTile->lastSeg[idx];
+    if (last == m_seg) return;
+    const bool samePass = last != 0 && last + 1 == m_seg;
+    last = m_seg;
+    if (samePass) return;
+
+    quint8 &c = m_cachedTile->passes[idx];
+    if (c == 0) ++m_coveredCells;
+    if (c == 255) return;
+    ++c;
+    if (!m_cachedTile->dirty) {
+        m_cachedTile->dirty = true;
+        m_dirty.append(key);
+    }
+}
+
+void CoverageMap::addPosition(double lat, double lon)
+{
+    double x, y;
+    m_frame.toLocal(lat, lon, x, y);
+    if (!m_hasLast) {
+        m_hasLast = true;
+        m_seg += 2;             // önceki geçişle bağ kopsun
+        m_lastX = x;
+        m_lastY = y;
+        return;
+    }
+
+    const double d = std::hypot(x - m_lastX, y - m_lastY);
+    if (d < MIN_STEP_M) return;
+    if (d <= MAX_STEP_M) {
+        ++m_seg;
+        stampSegment(m_lastX, m_lastY, x, y);
+    } else {
+        m_seg += 2;             // sıçrama: yeni geçiş
+    }
+    m_lastX = x;
+    m_lastY = y;
+}
+
+// A -> B parçasının kapsülü. Dikdörtgen: satır merkezinde dışbükey dörtgenin
+// x aralığı bulunur. Uçlardaki daireler birleşim yerini (dönüşün dış tarafı)
+// doldurur; örtüşen hücreleri stampCell ayıklar.
+void CoverageMap::stampSegment(double ax, double ay, double bx, double by)
+{
+    const double len = std::hypot(bx - ax, by - ay);
+    const double ux = (bx - ax) / len, uy = (by - ay) / len;
+    const double h = 0.5 * m_swath;
+    const double nx = -uy * h, ny = ux * h;
+
+    const double qx[4] = {ax + nx, bx + nx, bx - nx, ax - nx};
+    const double qy[4] = {ay + ny, by + ny, by - ny, ay - ny};
+    const double yMin = *std::min_element(qy, qy + 4), yMax = *std::max_element(qy, qy + 4);
+
+    const int row0 = int(std::ceil(yMin / CELL_M - 0.5));
+    const int row1 = int(std::floor(yMax / CELL_M - 0.5));
+    for (int row = row0; row <= row1; ++row) {
+        const double yc = (row + 0.5) * CELL_M;
+        double xMin = 1e300, xMax = -1e300;
+        for (int i = 0, j = 3; i < 4; j = i++) {
+            if ((qy[i] > yc) == (qy[j] > yc)) continue;
+            const double x = qx[j] + (yc - qy[j]) * (qx[i] - qx[j]) / (qy[i] - qy[j]);
+            xMin = std::min(xMin, x);
+            xMax = std::max(xMax, x);
+        }
+        if (xMin > xMax) continue;
+
+        const int col0 = int(std::ceil(xMin / CELL_M - 0.5));
+        const int col1 = int(std::floor(xMax / CELL_M - 0.5));
+        for (int col = col0; col <= col1; ++col)
+            stampCell(col, row);
+    }
+
+    stampDisc(ax, ay);
+    stampDisc(bx, by);
+}
+
+void CoverageMap::stampDisc(double cx, double cy)
+{
+    const double h = 0.5 * m_swath;
+    const int row0 = int(std::ceil((cy - h) / CELL_M - 0.5));
+    const int row1 = int(std::floor((cy + h) / CELL_M - 0.5));
+    for (int row = row0; row <= row1; ++row) {
+        const double dy = (row + 0.5) * CELL_M - cy;
+        const double dx = std::sqrt(qMax(0.0, h * h - dy * dy));
+        const int col0 = int(std::ceil((cx - dx) / CELL_M - 0.5));
+        const int col1 = int(std::floor((cx + dx) / CELL_M - 0.5));
+        for (int col = col0; col <= col1; ++col)
+            stampCell(col, row);
+    }
+}
+
+QVector<quint64> CoverageMap::takeDirty()
+{
+    QVector<quint64> out;
+    out.swap(m_dirty);
+    for (quint64 key : std::as_const(out))
+        m_tiles[key].dirty = false;
+    return out;
+}
+
+// Harita yeniden yüklendiğinde hepsi tekrar gönderilir
+void CoverageMap::markAllDirty()
+{
+    m_dirty.clear();
+    for (auto it = m_tiles.begin(); it != m_tiles.end(); ++it) {
+        it->dirty = true;
+        m_dirty.append(it.key());
+    }
+}
+
+QImage CoverageMap::renderTile(quint64 key) const
+{
+    QImage img(TILE, TILE, QImage::Format_ARGB32);
+    img.fill(Qt::transparent);
+    const auto it = m_tiles.constFind(key);
+    if (it == m_tiles.constEnd()) return img;
+
+    // 1 geçiş yeşil, 2 sarı, 3+ kırmızı (çift ilaçlama)
+    static const QRgb colors[4] = {0, qRgba(34, 197, 94, 110), qRgba(250, 204, 21, 140),
+                                   qRgba(239, 68, 68, 160)};
+    const std::vector<quint8> &passes = it->passes;
+    for (int row = 0; row < TILE; ++row) {
+        QRgb *line = reinterpret_cast<QRgb *>(img.scanLine(TILE - 1 - row));   // görüntüde üst = kuzey
+        const quint8 *src = &passes[size_t(row) * TILE];
+        for (int col = 0; col < TILE; ++col)
+            if (src[col]) line[col] = colors[qMin(int(src[col]), 3)];
+    }
+    return img;
+}
+
+void CoverageMap::tileBounds(quint64 key, GeoPoint &sw, GeoPoint &ne) const
+{
+    const double size = TILE * CELL_M;
+    const double x0 = keyX(key) * size, y0 = keyY(key) * size;
+    m_frame.toGeo(x0, y0, sw.lat, sw.lon);
+    m_frame.toGeo(x0 + size, y0 + size, ne.lat, ne.lon);
+}
+
+QString CoverageMap::tileId(quint64 key)
+{
+    return QString("%1_%2").arg(keyX(key)).arg(keyY(key));
+}
@@ -0,0 +1,312 @@
+#include "elevation.h"
+#include "geodesy.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutexLocker>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static constexpr qint16 HGT_VOID = -32768;
+static const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+// Eşlenmiş tek .hgt dosyası. Kurulduktan sonra değişmez; thread'ler arasında
+// shared_ptr ile paylaşılır, LRU'dan düşse bile son kullanıcıya kadar yaşar.
+class DemTile
+{
+public:
+    static std::shared_ptr<const DemTile> open(const QString &path, int latFloor, int lonFloor)
+    {
+        auto t = std::shared_ptr<DemTile>(new DemTile(path));
+        if (!t->m_file.open(QIODevice::ReadOnly))
+            return nullptr;
+
+        const qint64 bytes = t->m_file.size();
+        const int n = int(std::lround(std::sqrt(double(bytes / 2))));
+        if (n < 2 || qint64(n) * n * 2 != bytes) {
+            qDebug() << "DEM: unexpected size" << bytes << path;
+            return nullptr;
+        }
+        t->m_data = t->m_file.map(0, bytes);
+        if (!t->m_data) {
+            // Eşleme yoksa (bazı ağ sürücüleri) belleğe oku
+            t->m_buffer = t->m_file.readAll();
+            t->m_data = reinterpret_cast<const uchar *>(t->m_buffer.constData());
+        }
+        t->m_n = n;
+        t->m_lat0 = latFloor;
+        t->m_lon0 = lonFloor;
+        return t;
+    }
+
+    double sample(double lat, double lon) const
+    {
+        const int last = m_n - 1;
+        const double y = qBound(0.0, (m_lat0 + 1 - lat) * last, double(last));
+        const double x = qBound(0.0, (lon - m_lon0) * last, double(last));
+        const int r0 = qMin(int(y), last - 1);
+        const int c0 = qMin(int(x), last - 1);
+        const double fy = y - r0, fx = x - c0;
+
+        const qint16 h[4] = {at(r0, c0), at(r0, c0 + 1), at(r0 + 1, c0), at(r0 + 1, c0 + 1)};
+        const double w[4] = {(1 - fx) * (1 - fy), fx * (1 - fy), (1 - fx) * fy, fx * fy};
+
+        // Boşluklu (void) köşeler ağırlıktan düşülür
+        double sum = 0.0, wsum = 0.0;
+        for (int i = 0; i < 4; ++i) {
+            if (h[i] == HGT_VOID) continue;
+            sum += h[i] * w[i];
+            wsum += w[i];
+        }
+        return wsum > 1e-9 ? sum / wsum : NaN;
+    }
+
+private:
+    explicit DemTile(const QString &path) : m_file(path) {}
+
+    qint16 at(int r, int c) const
+    {
+        const uchar *p = m_data + (qint64(r) * m_n + c) * 2;
+        return qint16(quint16(p[0]) << 8 | p[1]);      // big-endian
+    }
+
+    QFile m_file;
+    QByteArray m_buffer;
+    const uchar *m_data = nullptr;
+    int m_n = 0;
+    int m_lat0 = 0;
+    int m_lon0 = 0;
+};
+
+ElevationService *ElevationService::instance()
+{
+    static ElevationService *service = nullptr;
+    if (!service)
+        service = new ElevationService(qApp);
+    return service;
+}
+
+ElevationService::ElevationService(QObject *parent)
+    : QObject(parent)
+{
+    const QByteArray env = qgetenv("KUZGUN_DEM_DIR");
+    m_dir = !env.isEmpty()
+                ? QString::fromLocal8Bit(env)
+                : QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/dem";
+}
+
+ElevationService::~ElevationService()
+{
+    cancelPending();
+    m_pool.waitForDone();
+}
+
+void ElevationService::setDirectory(const QString &dir)
+{
+    QMutexLocker lock(&m_mutex);
+    if (dir == m_dir) return;
+    m_dir = dir;
+    m_tiles.clear();
+}
+
+QString ElevationService::directory() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_dir;
+}
+
+void ElevationService::setCacheTiles(int tiles)
+{
+    QMutexLocker lock(&m_mutex);
+    m_maxTiles = qMax(1, tiles);
+}
+
+int ElevationService::tileKey(int latFloor, int lonFloor)
+{
+    return (latFloor + 90) * 360 + (lonFloor + 180);
+}
+
+ElevationService::TilePtr ElevationService::tile(int key)
+{
+    QString dirPath;
+    {
+        QMutexLocker lock(&m_mutex);
+        auto it = m_tiles.find(key);
+        if (it != m_tiles.end()) {
+            it->lastUse = ++m_clock;
+            return it->tile;
+        }
+        dirPath = m_dir;
+    }
+
+    // Dosya kilit dışında açılır; bekleyen loadedElevation çağrısı takılmaz
+    const int latFloor = key / 360 - 90;
+    const int lonFloor = key % 360 - 180;
+    const QString name = QString("%1%2%3%4.hgt")
+                             .arg(latFloor < 0 ? 'S' : 'N')
+                             .arg(std::abs(latFloor), 2, 10, QChar('0'))
+                             .arg(lonFloor < 0 ? 'W' : 'E')
+                             .arg(std::abs(lonFloor), 3, 10, QChar('0'));
+    const QDir dir(dirPath);
+    TilePtr t;
+    for (const QString &candidate : {name, name.toLower()}) {
+        if (QFile::exists(dir.filePath(candidate))) {
+            t = DemTile::open(dir.filePath(candidate), latFloor, lonFloor);
+            break;
+        }
+    }
+
+    QMutexLocker lock(&m_mutex);
+    if (dirPath != m_dir) return t;             // bu arada dizin değişti; önbelleğe girmez
+    auto it = m_tiles.find(key);
+    if (it != m_tiles.end()) {                  // başka bir thread önce açtı
+        it->lastUse = ++m_clock;
+        return it->tile;
+    }
+
+    // LRU: en uzun süredir kullanılmayan atılır (eşleme kapanır)
+    if (m_tiles.size() >= m_maxTiles) {
+        auto oldest = m_tiles.begin();
+        for (auto e = m_tiles.begin(); e != m_tiles.end(); ++e)
+            if (e->lastUse < oldest->lastUse) oldest = e;
+        m_tiles.erase(oldest);
+    }
+    m_tiles.insert(key, Entry{t, ++m_clock});
+    return t;
+}
+
+// Ardışık örnekler çoğunlukla aynı karoya düşer: kilit sadece karo değişince
+double ElevationService::sample(double lat, double lon, int &key, TilePtr &cur)
+{
+    if (!(lat >= -90.0 && lat < 90.0 && lon >= -180.0 && lon < 180.0)) return NaN;
+
+    const int k = tileKey(int(std::floor(lat)), int(std::floor(lon)));
+    if (k != key) {
+        key = k;
+        cur = tile(k);
+    }
+    return cur ? cur->sample(lat, lon) : NaN;
+}
+
+double ElevationService::elevation(double lat, double lon)
+{
+    int key = -1;
+    TilePtr cur;
+    return sample(lat, lon, key, cur);
+}
+
+double ElevationService::loadedElevation(double lat, double lon) const
+{
+    if (!(lat >= -90.0 && lat < 90.0 && lon >= -180.0 && lon < 180.0)) return NaN;
+
+    TilePtr t;
+    {
+        QMutexLocker lock(&m_mutex);
+        const auto it = m_tiles.constFind(tileKey(int(std::floor(lat)), int(std::floor(lon))));
+        if (it == m_tiles.constEnd()) return NaN;
+        t = it->tile;
+    }
+    return t ? t->sample(lat, lon) : NaN;
+}
+
+static inline bool isGroundCommand(MissionCommand c)
+{
+    return c == MissionCommand::Takeoff || c == MissionCommand::VtolTakeoff
+        || c == MissionCommand::Land || c == MissionCommand::VtolLand;
+}
+
+bool ElevationService::isGroundLeg(MissionCommand from, MissionCommand to)
+{
+    return isGroundCommand(from) || isGroundCommand(to);
+}
+
+ElevationService::Profile ElevationService::profile(const QVector<Waypoint> &wps, double refLat, double refLon,
+                                                    double spacing, double minClearance)
+{
+    QElapsedTimer t;
+    t.start();
+
+    int key = -1;
+    TilePtr cur;
+    auto at = [&](double lat, double lon) { return sample(lat, lon, key, cur); };
+    spacing = qMax(1.0, spacing);
+
+    Profile p;
+    const int n = wps.size();
+    p.ground.resize(n);
+    p.legs.resize(n);
+
+    for (int i = 0; i < n; ++i)
+        p.ground[i] = float(at(wps[i].lat, wps[i].lon));
+
+    double home = at(refLat, refLon);
+    if (std::isnan(home) && n > 0) home = p.ground[0];
+    p.homeKnown = !std::isnan(home);
+    p.homeGround = p.homeKnown ? home : 0.0;
+    if (!p.homeKnown) {
+        // Referans zemin yoksa AGL hesaplanamaz
+        p.elapsedMs = t.elapsed();
+        return p;
+    }
+
+    for (int i = 1; i < n; ++i) {
+        const Waypoint &a = wps[i - 1];
+        const Waypoint &b = wps[i];
+        const double d = Geodesy::haversine(a.lat, a.lon, b.lat, b.lon);
+        const int steps = qMax(1, int(std::ceil(d / spacing)));
+
+        Leg &leg = p.legs[i];
+        double groundMax = -1e9, clearance = 1e9;
+        for (int k = 0; k <= steps; ++k) {
+            const double f = double(k) / steps;
+            const double g = at(a.lat + (b.lat - a.lat) * f, a.lon + (b.lon - a.lon) * f);
+            if (std::isnan(g)) {
+                leg.missing = true;
+                continue;
+            }
+            const double amsl = p.homeGround + a.alt + (b.alt - a.alt) * f;
+            groundMax = std::max(groundMax, g);
+            clearance = std::min(clearance, amsl - g);
+        }
+        p.samples += steps + 1;
+
+        if (clearance > 1e8) {
+            leg.groundMax = float(NaN);
+            leg.minClearance = float(NaN);
+            continue;
+        }
+        leg.groundMax = float(groundMax);
+        leg.minClearance = float(clearance);
+        if (clearance < minClearance && !isGroundLeg(a.command, b.command))
+            ++p.lowLegs;
+    }
+
+    p.elapsedMs = t.elapsed();
+    return p;
+}
+
+int ElevationService::requestProfile(const QVector<Waypoint> &wps, double refLat, double refLon,
+                                     double spacing, double minClearance)
+{
+    const int generation = m_generation.fetchAndAddRelaxed(1) + 1;
+
+    // İş this'e dokunabilir: yıkıcı havuzu bekler. Sonuç kuyrukla gelir.
+    m_pool.start([this, wps, refLat, refLon, spacing, minClearance, generation]() {
+        if (m_generation.loadRelaxed() != generation) return;   // daha yenisi var
+
+        Profile p = profile(wps, refLat, refLon, spacing, minClearance);
+        p.generation = generation;
+
+        QMetaObject::invokeMethod(this, [this, p]() {
+            if (m_generation.loadRelaxed() == p.generation)
+                emit profileReady(p);
+        }, Qt::QueuedConnection);
+    });
+    return generation;
+}
@@ -1,39 +1,59 @@
 #include "flightcontroller.h"
 #include "ui_flightcontroller.h"
 #include <QDoubleValidator>
-#include <QTableWidgetItem>
-#include <QPushButton>
-#include <QComboBox>
+#include <QHeaderView>
 #include <QUrl>
 #include <QDebug>
-#include <QWebEngineProfile>
-#include <QStandardPaths>
-#include <QDir>
-#include <QWebChannel>
-#include <QWebEnginePage>
+#include "mapservice.h"
+#include "mapsurface.h"
+#include "survey.h"
+#include "missionmodel.h"
+#include "missiondelegates.h"
+#include "geodesy.h"
+#include "missionuploader.h"
+#include "missionio.h"
+#include "elevation.h"
+#include "flightpath.h"
+#include "routeoptimizer.h"
 #include <QTimer>
-#include <QJsonArray>
-#include <QJsonDocument>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QDoubleSpinBox>
+#include <QElapsedTimer>
+#include <QFileDialog>
+#include <QFormLayout>
+#include <QMessageBox>
+#include <QUndoStack>
+#include <QAction>
 #include <QSerialPortInfo>
+#include <QSettings>
+#include <QStandardPaths>
 #include <QToolBar>
 #include <cmath>
 
-static double deg2rad(double d) { return d * M_PI / 180.0; }
+// Arazi profili: bacak örnekleme aralığı ve uyarı eşiği
+static constexpr double TERRAIN_SPACING_M = 30.0;
+static constexpr double MIN_CLEARANCE_M = 30.0;
+static constexpr float DEFAULT_AGL_M = 40.0f;
+// Haritada waypoint seçme/sürükleme yarıçapı
+static constexpr double PICK_TOL_PX = 16.0;
 
 FlightController::FlightController(SerialManager* serialPtr,const QVector<Waypoint>& wpList, QWidget *parent)
     : QWidget(parent),
     ui(new Ui::FlightController),
-    bridge(new MapBridge(this)),
-    serial(serialPtr),
-    wps(wpList)
+    serial(serialPtr)
 {
     ui->setupUi(this);
+    m_model = new MissionModel(this);
+    m_model->setVehicle(loadVehicleProfile());
+    m_model->setWaypoints(wpList);
     setAttribute(Qt::WA_DeleteOnClose, true);
     setWindowTitle("Flight Controller (Plan)");
     setWindowIcon(QIcon(":/img/logo.jpeg"));
     addStyleSheet();
-    getTriggers();
+    getTable();
     getMap();
+    getTriggers();
     //listSerialPorts();
 }
 
@@ -43,28 +63,54 @@ FlightController::~FlightController()
 }
 
 void FlightController::getMap() {
-    QWebEngineProfile *profile = QWebEngineProfile::defaultProfile();
-    const QString cachePath =
-        QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)
-        + "/webengine_cache";
-    QDir().mkpath(cachePath);
-
-    profile->setCachePath(cachePath);
-    profile->setPersistentStoragePath(cachePath);
-    profile->setHttpCacheType(QWebEngineProfile::DiskHttpCache);
-    profile->setHttpCacheMaximumSize(500 * 1024 * 1024);
-
-    auto *channel = new QWebChannel(ui->mapView->page());
-    channel->registerObject("bridge", bridge);
-    ui->mapView->page()->setWebChannel(channel);
-    connect(ui->mapView, &QWebEngineView::loadFinished, this, [this](bool ok){
+    m_map = MapService::instance()->attach(MapService::PlanMap, ui->mapView);
+    bridge = m_map->bridge();
+
+    connect(bridge, &MapBridge::mapLoaded, this, [this](bool ok){
         m_mapReady = ok;
+        sendZonesToMap();
         if (m_mapReady && m_drawEnabled) {
             redrawWaypointsOnMap();
         }
     });
 
-    ui->mapView->setUrl(QUrl("qrc:/map.html?pick=1"));
+    // Sayfa önceki plan penceresinden kalmış olabilir: eski çizimleri temizle
+    m_mapReady = m_map->isReady();
+    if (m_mapReady) {
+        m_map->clearWaypoints();
+        m_map->setZones({}, {});
+        m_map->setLegHighlights({});
+    }
+}
+
+void FlightController::getTable() {
+    QTableView *tv = ui->tableWaypoints;
+    tv->setModel(m_model);
+    tv->setItemDelegateForColumn(MissionModel::ColStatus, new StatusDelegate(tv));
+
+    auto *removeDelegate = new RemoveButtonDelegate(tv);
+    tv->setItemDelegateForColumn(MissionModel::ColRemove, removeDelegate);
+    connect(removeDelegate, &RemoveButtonDelegate::removeClicked,
+            this, &FlightController::removeWaypointRow);
+
+    tv->setMouseTracking(true);     // remove butonu hover
+    tv->setSelectionBehavior(QAbstractItemView::SelectRows);
+    tv->setEditTriggers(QAbstractItemView::DoubleClicked
+                        | QAbstractItemView::SelectedClicked
+                        | QAbstractItemView::EditKeyPressed);
+
+    // Binlerce satırda sabit yükseklik: boyut hesabı için her satır ölçülmez
+    tv->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    tv->verticalHeader()->setDefaultSectionSize(26);
+    tv->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    tv->horizontalHeader()->setSectionResizeMode(MissionModel::ColRemove, QHeaderView::Fixed);
+    tv->horizontalHeader()->resizeSection(MissionModel::ColRemove, 70);
+
+    // Status tek tıkla açılır (eski combobox gibi)
+    connect(tv, &QTableView::clicked, this, [tv](const QModelIndex &index){
+        if (index.column() == MissionModel::ColStatus)
+            tv->edit(index);
+    });
 }
 
 void FlightController::getTriggers(){
@@ -80,8 +126,7 @@ void FlightController::getTriggers(){
 
         zoom = qBound(0.0, zoom, 22.0);
 
-        QString js = QString("setMapZoomFromQt(%1);").arg(zoom, 0, 'f', 1);
-        ui->mapView->page()->runJavaScript(js);
+        m_map->setZoom(zoom);
 
         ui->zoomSlider->blockSignals(true);
         ui->zoomSlider->setValue(qRound(zoom * 10.0));
@@ -101,8 +146,7 @@ void FlightController::getTriggers(){
     connect(ui->zoomSlider, &QSlider::valueChanged, this, [this](int value) {
         double zoom = value / 10.0;
 
-        QString js = QString("setMapZoomFromQt(%1);").arg(zoom, 0, 'f', 1);
-        ui->mapView->page()->runJavaScript(js);
+        m_map->setZoom(zoom);
 
         ui->lblZoom->setText(QString::number(zoom, 'f', 1));
     });
@@ -110,43 +154,229 @@ void FlightController::getTriggers(){
     connect(ui->btnSend, &QToolButton::clicked,
             this, &FlightController::onSendClicked);
 
+    m_uploader = new MissionUploader(serial, this);
+    connect(m_uploader, &MissionUploader::progress,
+            this, [this](int acked, int total, double bytesPerSec, double linePercent){
+                ui->progressUpload->setMaximum(total);
+                ui->progressUpload->setValue(acked);
+                ui->progressUpload->setFormat(QString("Upload %1/%2  %3 B/s (%4%)")
+                                                  .arg(acked).arg(total)
+                                                  .arg(bytesPerSec, 0, 'f', 0)
+                                                  .arg(linePercent, 0, 'f', 0));
+            });
+    // Bağlantı koptu: çubuk kalır, Send iptal olarak çalışır, tekrar bağlanınca sürer
+    connect(m_uploader, &MissionUploader::paused,
+            this, [this](int acked, int total){
+                ui->progressUpload->setMaximum(total);
+                ui->progressUpload->setValue(acked);
+                ui->progressUpload->setFormat(QString("Upload paused (link lost) %1/%2").arg(acked).arg(total));
+            });
+    connect(m_uploader, &MissionUploader::finished,
+            this, [this](MissionUploader::State result, const QString &message){
+                setSendCancels(false);
+                switch (result) {
+                case MissionUploader::Done:
+                    ui->progressUpload->setFormat("Upload OK");
+                    QTimer::singleShot(3000, ui->progressUpload, &QWidget::hide);
+                    emit waypointsUpdated(m_uploadWps);
+                    break;
+                case MissionUploader::Unverified:
+                    // Araç onaylamadı: görev araçtaki görev olarak yayınlanmaz, çubuk açık kalır
+                    ui->progressUpload->setFormat("Upload NOT verified: " + message);
+                    break;
+                default:
+                    ui->progressUpload->setFormat("Upload: " + message);
+                    QTimer::singleShot(3000, ui->progressUpload, &QWidget::hide);
+                    break;
+                }
+            });
+
     connect(ui->btnRead, &QToolButton::clicked,
             this, &FlightController::onReadClicked);
 
-    connect(ui->tableWaypoints, &QTableWidget::cellChanged,
-            this, [this](int row, int col)
-            {
-                if (col != COL_RADIUS) return;
-                if (row < 0 || row >= wps.size()) return;
-
-                auto *it = ui->tableWaypoints->item(row, COL_RADIUS);
-                if (!it) return;
+    // Geri al / yinele: butonlar ve Ctrl+Z / Ctrl+Y
+    QUndoStack *undo = m_model->undoStack();
+    connect(ui->btnUndo, &QToolButton::clicked, undo, &QUndoStack::undo);
+    connect(ui->btnRedo, &QToolButton::clicked, undo, &QUndoStack::redo);
+    connect(undo, &QUndoStack::canUndoChanged, ui->btnUndo, &QWidget::setEnabled);
+    connect(undo, &QUndoStack::canRedoChanged, ui->btnRedo, &QWidget::setEnabled);
+    connect(undo, &QUndoStack::undoTextChanged, this, [this](const QString &text){
+        ui->btnUndo->setToolTip(text.isEmpty() ? QString() : "Undo: " + text);
+    });
+    connect(undo, &QUndoStack::redoTextChanged, this, [this](const QString &text){
+        ui->btnRedo->setToolTip(text.isEmpty() ? QString() : "Redo: " + text);
+    });
+    ui->btnUndo->setEnabled(undo->canUndo());
+    ui->btnRedo->setEnabled(undo->canRedo());
+
+    QAction *undoAction = undo->createUndoAction(this);
+    undoAction->setShortcuts(QKeySequence::Undo);
+    undoAction->setShortcutContext(Qt::WidgetWithChildrenShortcut);
+    QAction *redoAction = undo->createRedoAction(this);
+    redoAction->setShortcuts(QKeySequence::Redo);
+    redoAction->setShortcutContext(Qt::WidgetWithChildrenShortcut);
+    addAction(undoAction);
+    addAction(redoAction);
+
+    connect(ui->btnImport, &QToolButton::clicked,
+            this, &FlightController::onImportClicked);
+    connect(ui->btnExport, &QToolButton::clicked,
+            this, &FlightController::onExportClicked);
+    connect(ui->btnZones, &QToolButton::clicked,
+            this, &FlightController::onZonesClicked);
+    connect(ui->btnVehicle, &QToolButton::clicked,
+            this, &FlightController::onVehicleClicked);
+
+    // Sıra iyileştirme arka planda; ilerleme yükleme çubuğunda gösterilir
+    m_optimizer = new RouteOptimizer(this);
+    connect(ui->btnOptimize, &QToolButton::clicked,
+            this, &FlightController::onOptimizeClicked);
+    connect(m_optimizer, &RouteOptimizer::progress, this, [this](int done, int total){
+        ui->progressUpload->setRange(0, total);
+        ui->progressUpload->setValue(done);
+    });
+    connect(m_optimizer, &RouteOptimizer::finished,
+            this, [this](const RouteOptimizer::Result &r){
+                ui->btnOptimize->setText("Optimize");
+                ui->btnSend->setEnabled(true);
+                ui->progressUpload->setRange(0, 1);
+                ui->progressUpload->setValue(1);
+                ui->progressUpload->setFormat(QString("Route %1 -> %2 km")
+                                                  .arg(r.before / 1000.0, 0, 'f', 1)
+                                                  .arg(r.after / 1000.0, 0, 'f', 1));
+                QTimer::singleShot(3000, ui->progressUpload, &QWidget::hide);
+                qDebug() << "Optimize:" << r.starts << "starts in" << r.elapsedMs << "ms,"
+                         << r.before << "->" << r.after << "m" << (r.cancelled ? "(cancelled)" : "");
+                if (r.improved())
+                    m_model->replaceAll(r.wps, "Optimize order");
+            });
+    // Çalışırken görev düzenlenirse sonuç eskidir
+    auto discardOptimize = [this](){
+        if (!m_optimizer->isRunning()) return;
+        m_optimizer->discard();
+        ui->btnOptimize->setText("Optimize");
+        ui->btnSend->setEnabled(true);
+        ui->progressUpload->hide();
+    };
+    connect(m_model, &MissionModel::totalsChanged, this, discardOptimize);
+    connect(m_model, &QAbstractItemModel::modelReset, this, discardOptimize);
+
+    // Duraklamış yükleme görev değişince eskir; tekrar bağlanınca eski görevi sürdürmesin
+    auto cancelPausedUpload = [this](){
+        if (m_uploader->state() == MissionUploader::Paused)
+            m_uploader->cancel();
+    };
+    connect(m_model->undoStack(), &QUndoStack::indexChanged, this, cancelPausedUpload);
+    connect(m_model, &QAbstractItemModel::modelReset, this, cancelPausedUpload);
+
+    // Doğrulama: sorunlu bacaklar haritada kırmızı, sayı üst satırda
+    connect(m_model, &MissionModel::validationChanged, this, [this](){
+        sendValidationToMap();
+        updateMissionTotals();
+    });
 
-                bool ok = false;
-                double r = it->text().toDouble(&ok);
-                if (!ok) return;
+    // Survey: açıkken haritaya poligon çizilir, kapatınca tarama deseni üretilir
+    connect(ui->btnSurvey, &QToolButton::toggled,
+            this, [this](bool checked){ m_map->setPolygonDrawMode(checked); });
 
-                // Limit
-                if (r < 1) r = 1;
-                if (r > 5000) r = 5000;
+    connect(bridge, &MapBridge::polygonDrawn,
+            this, &FlightController::onPolygonDrawn);
 
-                // tabloyu normalize et (signal döngüsüne girmesin)
-                ui->tableWaypoints->blockSignals(true);
-                it->setText(QString::number(r, 'f', 1));
-                ui->tableWaypoints->blockSignals(false);
+    // Harita modeli izler; sadece değişen noktalar gönderilir
+    connect(m_model, &MissionModel::geometryChanged, this, [this](int row){
+        if (m_mapReady && m_drawEnabled) m_map->updateWaypoint(row, m_model->at(row));
+    });
 
-                wps[row].radius = r;
+    connect(m_model, &QAbstractItemModel::rowsInserted,
+            this, [this](const QModelIndex &, int first, int last){
+                if (!m_mapReady) return;
+                if (!m_drawEnabled || first != last) {
+                    m_drawEnabled = true;
+                    redrawWaypointsOnMap();
+                    return;
+                }
+                m_map->insertWaypoint(first, m_model->at(first));
+            });
 
-                // Harita güncelle
-                redrawWaypointsOnMap();
+    connect(m_model, &QAbstractItemModel::rowsRemoved,
+            this, [this](const QModelIndex &, int first, int last){
+                if (m_model->isEmpty()) {
+                    m_map->clearWaypoints();
+                    return;
+                }
+                if (!m_mapReady || !m_drawEnabled) return;
+                // Toplu silme (geri alınan ekleme) tek seferde çizilir
+                if (last - first >= 8) {
+                    redrawWaypointsOnMap();
+                    return;
+                }
+                for (int row = last; row >= first; --row)
+                    m_map->removeWaypoint(row);
             });
 
-    ui->tableWaypoints->blockSignals(false);
+    connect(m_model, &MissionModel::totalsChanged,
+            this, &FlightController::updateMissionTotals);
+    updateMissionTotals();
+
+    // Arazi: düzenlemeler bitince (300 ms) profil arka planda yeniden hesaplanır
+    m_terrainTimer = new QTimer(this);
+    m_terrainTimer->setSingleShot(true);
+    m_terrainTimer->setInterval(300);
+    connect(m_terrainTimer, &QTimer::timeout, this, &FlightController::requestTerrainProfile);
+    auto scheduleTerrain = [this](){
+        ElevationService::instance()->cancelPending();
+        m_terrainTimer->start();
+    };
+    connect(m_model, &MissionModel::totalsChanged, this, scheduleTerrain);
+    connect(m_model, &QAbstractItemModel::modelReset, this, scheduleTerrain);
+    connect(ElevationService::instance(), &ElevationService::profileReady,
+            this, [this](const ElevationService::Profile &p){
+                m_model->setTerrain(p, MIN_CLEARANCE_M);
+                updateMissionTotals();
+                qDebug() << "Terrain profile:" << p.samples << "samples in" << p.elapsedMs << "ms,"
+                         << p.lowLegs << "legs below" << MIN_CLEARANCE_M << "m AGL";
+            });
+    scheduleTerrain();
+
+    // Uçulan rota: düzenleme sırasında harita düz çizer, durunca yaylar gelir
+    m_pathTimer = new QTimer(this);
+    m_pathTimer->setSingleShot(true);
+    m_pathTimer->setInterval(150);
+    connect(m_pathTimer, &QTimer::timeout, this, &FlightController::updateFlightPath);
+    connect(m_model, &MissionModel::totalsChanged, m_pathTimer, qOverload<>(&QTimer::start));
+    connect(m_model, &QAbstractItemModel::modelReset, m_pathTimer, qOverload<>(&QTimer::start));
+    // Sadece yarıçap değişince toplamlar değişmez ama harita yolu siler; yaylar yeniden hesaplanır
+    connect(m_model, &MissionModel::geometryChanged, m_pathTimer, qOverload<>(&QTimer::start));
+    updateFlightPath();
+
+    connect(m_model, &QAbstractItemModel::modelReset, this, [this](){
+        if (m_drawEnabled) redrawWaypointsOnMap();
+    });
 
     connect(bridge, &MapBridge::waypointAdded,
+            this, &FlightController::appendWaypoint);
+
+    // Seçme ve sürükleme: en yakın nokta modelin k-d ağacından. Sürüklerken
+    // her karede sadece o nokta güncellenir (geometryChanged -> updateWaypoint)
+    connect(bridge, &MapBridge::mapPressed,
+            this, [this](double lat, double lon, double zoom){
+                const int row = m_model->rowAt(lat, lon, zoom, PICK_TOL_PX);
+                if (row >= 0) {
+                    ui->tableWaypoints->selectRow(row);
+                    ui->tableWaypoints->scrollTo(m_model->index(row, MissionModel::ColLat));
+                    m_model->beginMove(row);
+                }
+                m_map->setDragWaypoint(row);
+            });
+    connect(bridge, &MapBridge::mapDragged,
             this, [this](double lat, double lon){
-                appendWaypoint(lat, lon);
-                redrawWaypointsOnMap();
+                m_model->moveTo(lat, lon);
+            });
+    connect(bridge, &MapBridge::mapReleased,
+            this, [this](double, double){
+                if (m_model->movingRow() < 0) return;
+                m_model->endMove();
+                m_map->setDragWaypoint(-1);
             });
 }
 
@@ -154,17 +384,7 @@ void FlightController::getTriggers(){
 
 double FlightController::haversineMeters(double lat1, double lon1, double lat2, double lon2)
 {
-    const double R = 6371000.0; // metre
-    const double dLat = deg2rad(lat2 - lat1);
-    const double dLon = deg2rad(lon2 - lon1);
-
-    const double a =
-        std::sin(dLat/2)*std::sin(dLat/2) +
-        std::cos(deg2rad(lat1))*std::cos(deg2rad(lat2)) *
-            std::sin(dLon/2)*std::sin(dLon/2);
-
-    const double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1-a));
-    return R * c;
+    return Geodesy::haversine(lat1, lon1, lat2, lon2);
 }
 
 
@@ -176,248 +396,443 @@ void FlightController::onReadClicked()
         return;
     }
     m_drawEnabled = true;
-    refreshTable();
     if (m_mapReady) redrawWaypointsOnMap();
 }
 
+void FlightController::onImportClicked()
+{
+    const QString path = QFileDialog::getOpenFileName(this, "Import mission", QString(),
+                                                      MissionIO::fileFilter());
+    if (path.isEmpty()) return;
+
+    QElapsedTimer t;
+    t.start();
+    // GPX <ele> AMSL: home yüksekliği (açık DEM karosundan) biliniyorsa bağıla çevrilir
+    const double homeAmsl = homeSet ? ElevationService::instance()->loadedElevation(homeLat, homeLon)
+                                    : MissionIO::NO_HOME;
+    QVector<Waypoint> imported;
+    QString error;
+    if (!MissionIO::load(path, imported, &error, homeAmsl)) {
+        QMessageBox::warning(this, "Import mission", error);
+        return;
+    }
+    const qint64 parseMs = t.elapsed();
+
+    // Geri alınabilir; modelReset haritayı bir kez yeniden çizer
+    m_drawEnabled = true;
+    m_model->replaceAll(imported, "Import mission");
+
+    qDebug() << "Imported" << m_model->size() << "waypoints from" << path
+             << "parse" << parseMs << "ms, total" << t.elapsed() << "ms";
+}
+
+void FlightController::onExportClicked()
+{
+    if (m_model->isEmpty()) return;
+
+    const QString path = QFileDialog::getSaveFileName(this, "Export mission", "mission.plan",
+                                                      MissionIO::fileFilter());
+    if (path.isEmpty()) return;
+
+    QString error;
+    double homeAmsl = MissionIO::NO_HOME;
+    double refLat, refLon;
+    if (terrainReference(refLat, refLon))
+        homeAmsl = ElevationService::instance()->loadedElevation(refLat, refLon);
+    if (!MissionIO::save(path, m_model->waypoints(), &error, homeAmsl))
+        QMessageBox::warning(this, "Export mission", error);
+}
+
+void FlightController::onZonesClicked()
+{
+    const QString path = QFileDialog::getOpenFileName(this, "Load no-fly zones", QString(),
+                                                      "GeoJSON (*.geojson *.json)");
+    if (path.isEmpty()) return;
+
+    QVector<MissionValidator::Zone> zones;
+    QString error;
+    if (!MissionValidator::loadZones(path, zones, &error)) {
+        QMessageBox::warning(this, "Load no-fly zones", error);
+        return;
+    }
+
+    QElapsedTimer t;
+    t.start();
+    m_model->setZones(zones);
+    qDebug() << "Loaded" << zones.size() << "zones from" << path
+             << "validated in" << t.elapsed() << "ms";
+
+    sendZonesToMap();
+}
+
 void FlightController::onSendClicked()
 {
+    // Yükleme sürerken ya da duraklamışken Send iptal eder
+    if (m_uploader->isActive()) {
+        m_uploader->cancel();
+        return;
+    }
     if (!serial->isConnected()) {
         qDebug() << "SEND ignored: not connected";
         return;
     }
-    const QString portName = serial->currentPortName();
-    if (portName.isEmpty() || wps.isEmpty()) return;
+    if (m_model->isEmpty()) return;
+
+    const int bad = m_model->validator().offendingRows();
+    if (bad > 0) {
+        const auto answer = QMessageBox::question(
+            this, "Send mission",
+            QString("%1 waypoint(s) failed validation (see highlighted rows).\nSend anyway?").arg(bad));
+        if (answer != QMessageBox::Yes) return;
+    }
 
     serial->clearRx();
 
-    // --- WP upload protokolü ---
-    serial->send(portName, QString("WP_BEGIN,%1\n").arg(wps.size()));
-
-    for (const Waypoint &wp : wps)
-    {
-        QString status = wp.status;
-        status.replace("\"", "'");
-
-        QString line = QString("WP,%1,%2,%3,%4,%5,\"%6\"\n")
-                           .arg(wp.lat,    0, 'f', 7)
-                           .arg(wp.lon,    0, 'f', 7)
-                           .arg(wp.alt,    0, 'f', 2)
-                           .arg(wp.dist,   0, 'f', 2)
-                           .arg(wp.radius, 0, 'f', 2)
-                           .arg(status);
-        serial->send(portName, line);
-    }
+    // Onaylı, pencereli yükleme; araç desteklemiyorsa eski WP protokolü
+    m_uploadWps = m_model->waypoints();
+    ui->progressUpload->setRange(0, m_uploadWps.size());
+    ui->progressUpload->setValue(0);
+    ui->progressUpload->setFormat("Upload %v/%m");
+    ui->progressUpload->show();
+    setSendCancels(true);
 
+    m_uploader->start(m_uploadWps);
+}
 
-    serial->send(portName, "WP_END\n");
-    emit waypointsUpdated(wps);
+// Send butonu yükleme boyunca "Cancel" olur
+void FlightController::setSendCancels(bool cancels)
+{
+    ui->btnSend->setIcon(cancels ? QIcon() : QIcon(":/img/send.png"));
+    ui->btnSend->setText(cancels ? QString("Cancel") : QString());
+    ui->btnSend->setToolTip(cancels ? QString("Cancel upload") : QString());
 }
 
 
 
 
+// İrtifalar kalkış noktasına göre: home, yoksa ilk waypoint
+bool FlightController::terrainReference(double &lat, double &lon) const
+{
+    if (homeSet) {
+        lat = homeLat;
+        lon = homeLon;
+        return true;
+    }
+    if (m_model->isEmpty()) return false;
+    lat = m_model->at(0).lat;
+    lon = m_model->at(0).lon;
+    return true;
+}
+
+void FlightController::requestTerrainProfile()
+{
+    double refLat, refLon;
+    if (!terrainReference(refLat, refLon)) return;
+    ElevationService::instance()->requestProfile(m_model->waypoints(), refLat, refLon,
+                                                 TERRAIN_SPACING_M, MIN_CLEARANCE_M);
+}
+
+void FlightController::updateFlightPath()
+{
+    QElapsedTimer timer;
+    timer.start();
+    const FlightPath::Path path = FlightPath::compute(m_model->waypoints());
+    m_flightPath = path.points;
+    m_flownLength = path.length;
+    sendFlightPathToMap();
+    updateMissionTotals();
+    qDebug() << "Flight path:" << path.points.size() << "points in" << timer.elapsed() << "ms,"
+             << path.tightTurns << "turns tighter than the waypoint radius";
+}
+
+void FlightController::sendFlightPathToMap()
+{
+    if (!m_mapReady || !m_drawEnabled || m_flightPath.size() < 2) return;
+    if (m_pathTimer->isActive()) return;    // eski yol; yenisi birazdan gelir
+    m_map->setFlightPath(m_flightPath);
+}
+
 void FlightController::appendWaypoint(double lat, double lon)
 {
+    // DEM varsa yeni nokta zeminden DEFAULT_AGL_M yukarıda; yoksa eskisi gibi 40 m.
+    // Sadece açık karolar: GUI thread'inde dosya açılmaz (profil arka planda açar)
+    float alt = DEFAULT_AGL_M;
+    double refLat, refLon;
+    if (terrainReference(refLat, refLon)) {
+        const ElevationService *dem = ElevationService::instance();
+        const double ground = dem->loadedElevation(lat, lon);
+        const double home = dem->loadedElevation(refLat, refLon);
+        if (!std::isnan(ground) && !std::isnan(home))
+            alt = float(qMax(ground - home + DEFAULT_AGL_M, double(DEFAULT_AGL_M)));
+    }
+
     Waypoint wp{};
     wp.lat = lat;
     wp.lon = lon;
-    wp.alt = 40.0;
+    wp.alt = alt;
     wp.radius = 50.0;
-    wp.status = "WAYPOINT";
+    wp.command = MissionCommand::Waypoint;
 
-    if (wps.isEmpty()) wp.dist = 0.0;
-    else {
-        const auto &prev = wps.last();
-        wp.dist = haversineMeters(prev.lat, prev.lon, lat, lon);
-    }
-
-    wps.push_back(wp);
-    const int row = ui->tableWaypoints->rowCount();
-    ui->tableWaypoints->insertRow(row);
-    addStatusCombo(row);
-
-    ui->tableWaypoints->setItem(row, COL_LAT,    new QTableWidgetItem(QString::number(wp.lat, 'f', 7)));
-    ui->tableWaypoints->setItem(row, COL_LON,    new QTableWidgetItem(QString::number(wp.lon, 'f', 7)));
-    ui->tableWaypoints->setItem(row, COL_ALT,    new QTableWidgetItem(QString::number(wp.alt, 'f', 1)));
-    ui->tableWaypoints->setItem(row, COL_DIST,   new QTableWidgetItem(QString::number(wp.dist, 'f', 1)));
-    ui->tableWaypoints->setItem(row, COL_RADIUS, new QTableWidgetItem(QString::number(wp.radius, 'f', 1)));
-
-    addRemoveButton(row);
+    m_model->append(wp);     // dist model tarafından hesaplanır
 }
 
 
-void FlightController::refreshTable()
+// Çok sayıda waypoint'i tek seferde ekler: model tek rowsInserted yayar,
+// tablo ve harita bir kez güncellenir (survey binlerce nokta üretebilir).
+void FlightController::appendWaypoints(const QVector<Waypoint> &newWps)
 {
-    ui->tableWaypoints->blockSignals(true);
+    if (newWps.isEmpty()) return;
 
-    ui->tableWaypoints->setRowCount(wps.size());
+    QElapsedTimer t;
+    t.start();
 
-    for (int i = 0; i < wps.size(); ++i) {
-        const auto &wp = wps[i];
-        addStatusCombo(i);
+    m_model->append(newWps);
 
-        ui->tableWaypoints->setItem(i, COL_LAT,    new QTableWidgetItem(QString::number(wp.lat, 'f', 7)));
-        ui->tableWaypoints->setItem(i, COL_LON,    new QTableWidgetItem(QString::number(wp.lon, 'f', 7)));
-        ui->tableWaypoints->setItem(i, COL_ALT,    new QTableWidgetItem(QString::number(wp.alt, 'f', 1)));
-        ui->tableWaypoints->setItem(i, COL_DIST,   new QTableWidgetItem(QString::number(wp.dist, 'f', 1)));
-        ui->tableWaypoints->setItem(i, COL_RADIUS, new QTableWidgetItem(QString::number(wp.radius, 'f', 1)));
-
-        addRemoveButton(i);
-    }
-    ui->tableWaypoints->blockSignals(false);
+    qDebug() << "[SURVEY] appended" << newWps.size() << "waypoints in" << t.elapsed() << "ms";
 }
 
-void FlightController::addRemoveButton(int row)
+void FlightController::onPolygonDrawn(const QVector<GeoPoint> &polygon)
 {
-    auto *btn = new QPushButton("X", ui->tableWaypoints);
-    btn->setCursor(Qt::PointingHandCursor);
-    btn->setStyleSheet(
-        "QPushButton {"
-        " font-size:14px;"
-        " font-weight:bold;"
-        " color: white;"
-        " background-color:#1e1e1e;"
-        " border:none;"
-        " padding:2px;"
-        " border-radius:4px;"
-        "}"
-        "QPushButton:hover { background-color:#a33; }"
-        "QPushButton:pressed{ background-color:#700; }"
-        );
-    btn->setProperty("row", row);
-
-    connect(btn, &QPushButton::clicked, this, [this, btn](){
-        int r = btn->property("row").toInt();
-        removeWaypointRow(r);
-    });
+    SurveyParams sp;
+
+    QDialog dlg(this);
+    dlg.setWindowTitle("Survey");
+    auto *form = new QFormLayout(&dlg);
+
+    auto makeSpin = [&dlg](double min, double max, double value, const QString &suffix) {
+        auto *sb = new QDoubleSpinBox(&dlg);
+        sb->setRange(min, max);
+        sb->setDecimals(1);
+        sb->setValue(value);
+        sb->setSuffix(suffix);
+        return sb;
+    };
+
+    auto *sbSpacing  = makeSpin(1.0, 1000.0, sp.spacing,  " m");
+    auto *sbOverlap  = makeSpin(0.0,   90.0, sp.overlap,  " %");
+    auto *sbHeading  = makeSpin(0.0,  359.9, sp.heading,  " °");
+    auto *sbAltitude = makeSpin(1.0, 1000.0, sp.altitude, " m");
+    auto *sbRadius   = makeSpin(1.0, 5000.0, sp.radius,   " m");
+
+    form->addRow("Line spacing", sbSpacing);
+    form->addRow("Overlap",      sbOverlap);
+    form->addRow("Heading",      sbHeading);
+    form->addRow("Altitude",     sbAltitude);
+    form->addRow("Radius",       sbRadius);
+
+    auto *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dlg);
+    form->addRow(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+
+    if (dlg.exec() != QDialog::Accepted) return;
+
+    sp.spacing  = sbSpacing->value();
+    sp.overlap  = sbOverlap->value();
+    sp.heading  = sbHeading->value();
+    sp.altitude = sbAltitude->value();
+    sp.radius   = sbRadius->value();
+
+    QElapsedTimer t;
+    t.start();
+    const QVector<Waypoint> pattern = Survey::generate(polygon, sp);
+    qDebug() << "[SURVEY] generated" << pattern.size() << "waypoints in" << t.elapsed() << "ms";
 
-    ui->tableWaypoints->setCellWidget(row, COL_REMOVE, btn);
+    m_drawEnabled = true;
+    appendWaypoints(pattern);
 }
 
-void FlightController::removeWaypointRow(int row)
+static QString vehicleSettingsPath()
 {
-    if (row < 0 || row >= wps.size()) return;
+    return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/vehicle.ini";
+}
 
-    wps.removeAt(row);
-    ui->tableWaypoints->removeRow(row);
+VehicleProfile FlightController::loadVehicleProfile()
+{
+    VehicleProfile v;
+    QSettings st(vehicleSettingsPath(), QSettings::IniFormat);
+    v.cruise         = st.value("cruise",         v.cruise).toDouble();
+    v.climb          = st.value("climb",          v.climb).toDouble();
+    v.sink           = st.value("sink",           v.sink).toDouble();
+    v.cruisePower    = st.value("cruisePower",    v.cruisePower).toDouble();
+    v.climbPower     = st.value("climbPower",     v.climbPower).toDouble();
+    v.sinkPower      = st.value("sinkPower",      v.sinkPower).toDouble();
+    v.hoverPower     = st.value("hoverPower",     v.hoverPower).toDouble();
+    v.transitionTime = st.value("transitionTime", v.transitionTime).toDouble();
+    v.batteryWh      = st.value("batteryWh",      v.batteryWh).toDouble();
+    v.reservePct     = st.value("reservePct",     v.reservePct).toDouble();
+    v.windSpeed      = st.value("windSpeed",      v.windSpeed).toDouble();
+    v.windFrom       = st.value("windFrom",       v.windFrom).toDouble();
+    return v;
+}
 
-    rebuildStatusCombosRowProperty();
-    rebuildRemoveButtonsRowProperty();
-    recomputeDistancesAndUpdateTable();
+void FlightController::saveVehicleProfile(const VehicleProfile &v)
+{
+    QSettings st(vehicleSettingsPath(), QSettings::IniFormat);
+    st.setValue("cruise",         v.cruise);
+    st.setValue("climb",          v.climb);
+    st.setValue("sink",           v.sink);
+    st.setValue("cruisePower",    v.cruisePower);
+    st.setValue("climbPower",     v.climbPower);
+    st.setValue("sinkPower",      v.sinkPower);
+    st.setValue("hoverPower",     v.hoverPower);
+    st.setValue("transitionTime", v.transitionTime);
+    st.setValue("batteryWh",      v.batteryWh);
+    st.setValue("reservePct",     v.reservePct);
+    st.setValue("windSpeed",      v.windSpeed);
+    st.setValue("windFrom",       v.windFrom);
+}
 
-    if (wps.isEmpty()) {
-        ui->mapView->page()->runJavaScript("clearWaypointsOnMap();");
+// Tekrar basılırsa iptal: o ana kadarki en iyi sıra uygulanır
+void FlightController::onOptimizeClicked()
+{
+    if (m_optimizer->isRunning()) {
+        m_optimizer->cancel();
         return;
     }
-    redrawWaypointsOnMap();
+    if (m_model->size() < 4 || m_uploader->isActive()) return;     // yükleme sürüyor
+
+    const GeoPoint home{homeLat, homeLon};
+    m_optimizer->start(m_model->waypoints(), homeSet ? &home : nullptr);
+
+    ui->btnOptimize->setText("Cancel");
+    ui->btnSend->setEnabled(false);
+    ui->progressUpload->setRange(0, 0);
+    ui->progressUpload->setFormat("Optimize %v/%m");
+    ui->progressUpload->show();
 }
 
-void FlightController::recomputeDistancesAndUpdateTable()
+void FlightController::onVehicleClicked()
 {
-    ui->tableWaypoints->blockSignals(true);
-
-    for (int i = 0; i < wps.size(); ++i) {
-        if (i == 0) {
-            wps[i].dist = 0.0;
-        } else {
-            wps[i].dist = haversineMeters(
-                wps[i-1].lat, wps[i-1].lon,
-                wps[i].lat,   wps[i].lon
-                );
-        }
-
-        if (auto *distItem = ui->tableWaypoints->item(i, COL_DIST)) {
-            distItem->setText(QString::number(wps[i].dist, 'f', 1));
-        } else {
-            ui->tableWaypoints->setItem(i, COL_DIST, new QTableWidgetItem(QString::number(wps[i].dist, 'f', 1)));
-        }
+    VehicleProfile v = m_model->vehicle();
+
+    QDialog dlg(this);
+    dlg.setWindowTitle("Vehicle profile");
+    auto *form = new QFormLayout(&dlg);
+
+    auto makeSpin = [&dlg](double min, double max, double value, const QString &suffix) {
+        auto *sb = new QDoubleSpinBox(&dlg);
+        sb->setRange(min, max);
+        sb->setDecimals(1);
+        sb->setValue(value);
+        sb->setSuffix(suffix);
+        return sb;
+    };
+
+    auto *sbCruise      = makeSpin(1.0,   100.0,   v.cruise,         " m/s");
+    auto *sbClimb       = makeSpin(0.1,   30.0,    v.climb,          " m/s");
+    auto *sbSink        = makeSpin(0.1,   30.0,    v.sink,           " m/s");
+    auto *sbCruisePower = makeSpin(0.0,   20000.0, v.cruisePower,    " W");
+    auto *sbClimbPower  = makeSpin(0.0,   20000.0, v.climbPower,     " W");
+    auto *sbSinkPower   = makeSpin(0.0,   20000.0, v.sinkPower,      " W");
+    auto *sbHoverPower  = makeSpin(0.0,   50000.0, v.hoverPower,     " W");
+    auto *sbTransition  = makeSpin(0.0,   300.0,   v.transitionTime, " s");
+    auto *sbBattery     = makeSpin(1.0,   100000.0, v.batteryWh,     " Wh");
+    auto *sbReserve     = makeSpin(0.0,   90.0,    v.reservePct,     " %");
+    auto *sbWindSpeed   = makeSpin(0.0,   60.0,    v.windSpeed,      " m/s");
+    auto *sbWindFrom    = makeSpin(0.0,   359.9,   v.windFrom,       " °");
+
+    form->addRow("Cruise speed",       sbCruise);
+    form->addRow("Climb rate",         sbClimb);
+    form->addRow("Descent rate",       sbSink);
+    form->addRow("Cruise power",       sbCruisePower);
+    form->addRow("Climb power",        sbClimbPower);
+    form->addRow("Descent power",      sbSinkPower);
+    form->addRow("Hover power (VTOL)", sbHoverPower);
+    form->addRow("VTOL transition",    sbTransition);
+    form->addRow("Battery capacity",   sbBattery);
+    form->addRow("Reserve",            sbReserve);
+    form->addRow("Wind speed",         sbWindSpeed);
+    form->addRow("Wind from",          sbWindFrom);
+
+    auto *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dlg);
+    form->addRow(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+
+    if (dlg.exec() != QDialog::Accepted) return;
+
+    v.cruise         = sbCruise->value();
+    v.climb          = sbClimb->value();
+    v.sink           = sbSink->value();
+    v.cruisePower    = sbCruisePower->value();
+    v.climbPower     = sbClimbPower->value();
+    v.sinkPower      = sbSinkPower->value();
+    v.hoverPower     = sbHoverPower->value();
+    v.transitionTime = sbTransition->value();
+    v.batteryWh      = sbBattery->value();
+    v.reservePct     = sbReserve->value();
+    v.windSpeed      = sbWindSpeed->value();
+    v.windFrom       = sbWindFrom->value();
+
+    saveVehicleProfile(v);
+
+    QElapsedTimer t;
+    t.start();
+    m_model->setVehicle(v);
+    qDebug() << "Vehicle profile applied to" << m_model->size() << "legs in" << t.elapsed() << "ms";
+}
 
-        if (auto *latItem = ui->tableWaypoints->item(i, COL_LAT))
-            latItem->setText(QString::number(wps[i].lat, 'f', 7));
-        if (auto *lonItem = ui->tableWaypoints->item(i, COL_LON))
-            lonItem->setText(QString::number(wps[i].lon, 'f', 7));
-        if (auto *altItem = ui->tableWaypoints->item(i, COL_ALT))
-            altItem->setText(QString::number(wps[i].alt, 'f', 1));
-        if (auto *radItem = ui->tableWaypoints->item(i, COL_RADIUS))
-            radItem->setText(QString::number(wps[i].radius, 'f', 1));
-    }
-    ui->tableWaypoints->blockSignals(false);
+void FlightController::removeWaypointRow(int row)
+{
+    m_model->removeAt(row);
 }
 
-void FlightController::rebuildRemoveButtonsRowProperty()
+void FlightController::updateMissionTotals()
 {
-    for (int i = 0; i < ui->tableWaypoints->rowCount(); ++i) {
-        auto *w = ui->tableWaypoints->cellWidget(i, COL_REMOVE);
-        if (auto *b = qobject_cast<QPushButton*>(w)) {
-            b->setProperty("row", i);
-        }
+    if (m_model->isEmpty()) {
+        ui->lblMissionTotals->clear();
+        return;
     }
+    const LegMetrics t = m_model->total();
+    QString text = QString("WP: %1    Total: %2 km    Flown: %3 km    Climb: %4 m    Time: %5    Energy: %6 Wh (%7%)")
+                       .arg(m_model->size())
+                       .arg(t.dist / 1000.0, 0, 'f', 2)
+                       .arg(m_flownLength / 1000.0, 0, 'f', 2)
+                       .arg(t.climb, 0, 'f', 0)
+                       .arg(MissionModel::formatDuration(t.time))
+                       .arg(t.energy, 0, 'f', 0)
+                       .arg(m_model->batteryRemaining(m_model->size() - 1), 0, 'f', 0);
+    const int bad = m_model->validator().offendingRows();
+    if (bad > 0)
+        text += QString("    Issues: %1").arg(bad);
+    if (m_model->lowClearanceLegs() > 0)
+        text += QString("    Low AGL legs: %1").arg(m_model->lowClearanceLegs());
+    ui->lblMissionTotals->setText(text);
 }
 
 void FlightController::redrawWaypointsOnMap()
 {
-    if (!m_mapReady)    return; // harita hazır değilse JS gönderme
-
-    QJsonArray arr;
-    for (const auto &wp : wps) {
-        QJsonArray p;
-        p.append(wp.lat);
-        p.append(wp.lon);
-        p.append(wp.radius);
-        arr.append(p);
-    }
+    if (!m_mapReady)    return; // harita hazır değilse çizme
 
-    const QString json = QString::fromUtf8(QJsonDocument(arr).toJson(QJsonDocument::Compact));
-    const QString js = QString("redrawWaypointsFromList(%1);").arg(json);
-    ui->mapView->page()->runJavaScript(js);
+    m_map->setWaypoints(m_model->waypoints());
+    sendValidationToMap();
+    sendFlightPathToMap();
 }
-void FlightController::addStatusCombo(int row)
-{
-    auto *cb = new QComboBox(ui->tableWaypoints);
-    cb->addItems({
-        "WAYPOINT",
-        "TAKEOFF",
-        "LAND",
-        "VTOL_TAKEOFF",
-        "VTOL_LAND",
-        "LOITER",
-        "RTL"
-    });
 
-    if (row >= 0 && row < wps.size() && !wps[row].status.isEmpty()) {
-        int idx = cb->findText(wps[row].status);
-        if (idx >= 0) cb->setCurrentIndex(idx);
-    } else {
-        cb->setCurrentText("WAYPOINT");
+void FlightController::sendZonesToMap()
+{
+    if (!m_mapReady) return;
+
+    const QVector<MissionValidator::Zone> &zones = m_model->validator().zones();
+    QVector<QVector<GeoPoint>> rings;
+    QVector<bool> inclusion;
+    rings.reserve(zones.size());
+    inclusion.reserve(zones.size());
+    for (const MissionValidator::Zone &z : zones) {
+        rings.append(z.ring);
+        inclusion.append(z.inclusion);
     }
-
-    cb->setProperty("row", row);
-
-    connect(cb, &QComboBox::currentTextChanged, this, [this, cb](const QString &txt){
-        int r = cb->property("row").toInt();
-        if (r < 0 || r >= wps.size()) return;
-
-        wps[r].status = txt;
-
-        redrawWaypointsOnMap();
-    });
-
-    ui->tableWaypoints->setCellWidget(row, COL_STATUS, cb);
+    m_map->setZones(rings, inclusion);
 }
 
-void FlightController::rebuildStatusCombosRowProperty()
+void FlightController::sendValidationToMap()
 {
-    for (int i = 0; i < ui->tableWaypoints->rowCount(); ++i) {
-        auto *w = ui->tableWaypoints->cellWidget(i, COL_STATUS);
-        if (auto *cb = qobject_cast<QComboBox*>(w)) {
-            cb->setProperty("row", i);
-        }
-    }
+    if (!m_mapReady || !m_drawEnabled) return;
+    m_map->setLegHighlights(m_model->validator().offendingLegs());
 }
 
 
-
 void FlightController::addStyleSheet(){
     //this->showFullScreen();
     this->showMaximized();
@@ -436,12 +851,8 @@ void FlightController::addStyleSheet(){
         "}"
         );
 
-    ui->tableWaypoints->setColumnCount(7);
-    ui->tableWaypoints->setHorizontalHeaderLabels({
-        "Status", "Latitude", "Longitude", "Altitude(m)", "Distance(m)", "Radius(m)", "Remove"
-    });
     ui->tableWaypoints->setStyleSheet(
-        "QTableWidget {"
+        "QTableView {"
         "   color: white;"
         "   background-color: #1e1e1e;"
         "   font-size:13px;"
@@ -470,8 +881,6 @@ void FlightController::addStyleSheet(){
         "   border: none;"
         "}"
         );
-    ui->tableWaypoints->blockSignals(true);
-
     ui->btnSend->setIcon(QIcon(":/img/send.png"));
     ui->btnSend->setIconSize(QSize(85, 45));
     ui->btnSend->setStyleSheet(
@@ -479,6 +888,8 @@ void FlightController::addStyleSheet(){
         "   border: 1px solid white;"
         "   border-radius: 6px;"
         "   background-color: #2b2b2b;"
+        "   color: white;"
+        "   font-weight: bold;"
         "   padding: 2px 2px"
 
         "}"
@@ -487,6 +898,56 @@ void FlightController::addStyleSheet(){
         );
 
 
+    ui->lblMissionTotals->setStyleSheet(
+        "QLabel {"
+        "   color: white;"
+        "   font-size: 14px;"
+        "   font-weight: bold;"
+        "}"
+        );
+
+    ui->progressUpload->hide();
+    ui->progressUpload->setStyleSheet(
+        "QProgressBar {"
+        "   color: white;"
+        "   background-color: #1e1e1e;"
+        "   border: 1px solid white;"
+        "   border-radius: 4px;"
+        "   text-align: center;"
+        "}"
+        "QProgressBar::chunk { background-color: #0078ff; }"
+        );
+
+    ui->btnSurvey->setStyleSheet(
+        "QToolButton {"
+        "   color: white;"
+        "   font-weight: bold;"
+        "   border: 1px solid white;"
+        "   border-radius: 6px;"
+        "   background-color: #2b2b2b;"
+        "   padding: 2px 2px"
+        "}"
+        "QToolButton:hover { border: 2px solid #0078ff; }"
+        "QToolButton:checked { background-color: #8a6000; }"
+        );
+
+    for (QToolButton *b : {ui->btnUndo, ui->btnRedo, ui->btnImport, ui->btnExport,
+                           ui->btnZones, ui->btnVehicle, ui->btnOptimize}) {
+        b->setStyleSheet(
+            "QToolButton {"
+            "   color: white;"
+            "   font-weight: bold;"
+            "   border: 1px solid white;"
+            "   border-radius: 6px;"
+            "   background-color: #2b2b2b;"
+            "   padding: 2px 2px"
+            "}"
+            "QToolButton:hover { border: 2px solid #0078ff; }"
+            "QToolButton:pressed { border: 2px solid #004f9e; }"
+            "QToolButton:disabled { color: #777; border: 1px solid #555; }"
+            );
+    }
+
     ui->btnRead->setIcon(QIcon(":/img/read.png"));
     ui->btnRead->setIconSize(QSize(85, 45));
     ui->btnRead->setStyleSheet(
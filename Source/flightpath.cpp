@@ -0,0 +1,119 @@
+#include "flightpath.h"
+#include "enuframe.h"
+#include "geodesy.h"
+#include "parallel.h"
+
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr int CHUNK = 512;               // köşe; paralel iş birimi
+static constexpr int PARALLEL_MIN = 2 * CHUNK;  // bundan kısa görev seri
+static constexpr int MAX_ARC_SEGMENTS = 64;
+
+namespace {
+
+struct Corner {
+    QVector<GeoPoint> arc;      // boşsa köşenin kendisi
+    double saved = 0.0;         // m, (2d - r*theta): düz yola göre kısalma
+    bool tight = false;
+};
+
+Corner fillet(const Waypoint &a, const Waypoint &b, const Waypoint &c, double tolerance)
+{
+    Corner out;
+    // B merkezli yerel düzlem
+    const EnuFrame f(b.lat, b.lon);
+    double ax, ay, cx, cy;
+    f.toLocal(a.lat, a.lon, ax, ay);
+    f.toLocal(c.lat, c.lon, cx, cy);
+
+    // B orijinde: giren yön u1 = (B - A), çıkan yön u2 = (C - B)
+    const double l1 = std::hypot(ax, ay);
+    const double l2 = std::hypot(cx, cy);
+    if (l1 < 1e-3 || l2 < 1e-3) return out;
+    const double u1x = -ax / l1, u1y = -ay / l1;
+    const double u2x = cx / l2, u2y = cy / l2;
+
+    const double cross = u1x * u2y - u1y * u2x;
+    const double dot = qBound(-1.0, u1x * u2x + u1y * u2y, 1.0);
+    const double theta = std::acos(dot);            // dönüş açısı
+    if (theta < 1e-3) return out;
+
+    // Teğet noktası köşeden d kadar geride/ileride; bacağın yarısını geçemez
+    double r = qMax(double(b.radius), 0.0);
+    const double halfTan = std::tan(theta * 0.5);
+    double d = r * halfTan;
+    const double dMax = 0.5 * qMin(l1, l2);
+    if (d > dMax) {
+        d = dMax;
+        r = d / halfTan;
+        out.tight = true;
+    }
+    if (r < 1e-3) return out;
+
+    const double t1x = -u1x * d, t1y = -u1y * d;
+    const double side = cross > 0 ? 1.0 : -1.0;     // +: sola (saat yönü tersi)
+    const double ox = t1x - u1y * r * side;
+    const double oy = t1y + u1x * r * side;
+
+    // Kiriş hatası: r (1 - cos(step/2)) <= tolerance
+    const double tol = qBound(0.01, tolerance, r);
+    const double step = 2.0 * std::acos(1.0 - tol / r);
+    const int segments = qBound(1, int(std::ceil(theta / step)), MAX_ARC_SEGMENTS);
+
+    const double start = std::atan2(t1y - oy, t1x - ox);
+    out.arc.reserve(segments + 1);
+    for (int k = 0; k <= segments; ++k) {
+        const double ang = start + side * theta * k / segments;
+        GeoPoint g;
+        f.toGeo(ox + r * std::cos(ang), oy + r * std::sin(ang), g.lat, g.lon);
+        out.arc.append(g);
+    }
+    out.saved = 2.0 * d - r * theta;
+    return out;
+}
+
+}
+
+FlightPath::Path FlightPath::compute(const QVector<Waypoint> &wps, double tolerance, int threads)
+{
+    Path path;
+    const int n = wps.size();
+    if (n == 0) return path;
+
+    QVector<Corner> corners(n);
+    QVector<double> legs(n, 0.0);
+    auto body = [&](int from, int to) {
+        for (int i = from; i < to; ++i) {
+            if (i > 0)
+                legs[i] = Geodesy::haversine(wps[i - 1].lat, wps[i - 1].lon, wps[i].lat, wps[i].lon);
+            // Kalkış/iniş noktalarında dönüş yayı yok
+            if (i > 0 && i + 1 < n && wps[i].command != MissionCommand::Land
+                && wps[i].command != MissionCommand::VtolLand)
+                corners[i] = fillet(wps[i - 1], wps[i], wps[i + 1], tolerance);
+        }
+    };
+    if (n >= PARALLEL_MIN && threads != 1)
+        parallelFor(n, CHUNK, threads, body);
+    else
+        body(0, n);
+
+    int total = 0;
+    for (const Corner &c : std::as_const(corners))
+        total += c.arc.isEmpty() ? 1 : c.arc.size();
+    path.points.reserve(total);
+
+    for (int i = 0; i < n; ++i) {
+        const Corner &c = corners[i];
+        path.straightLength += legs[i];
+        path.length += legs[i] - c.saved;
+        path.tightTurns += c.tight;
+        if (c.arc.isEmpty())
+            path.points.append(GeoPoint{wps[i].lat, wps[i].lon});
+        else
+            path.points += c.arc;
+    }
+    return path;
+}
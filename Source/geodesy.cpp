@@ -0,0 +1,257 @@
+#include "geodesy.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace Geodesy {
+
+// geodesy_avx2.cpp (sadece x86'da dolu)
+namespace detail {
+bool avx2Supported();
+void haversineAvx2(const double *lat1, const double *lon1, const double *lat2, const double *lon2,
+                   double *out, int n);
+void bearingAvx2(const double *lat1, const double *lon1, const double *lat2, const double *lon2,
+                 double *out, int n);
+void destinationAvx2(const double *lat, const double *lon, const double *brg, const double *dist,
+                     double *outLat, double *outLon, int n);
+void enuAvx2(double lat0, double lon0, double alt0,
+             const double *lat, const double *lon, const double *alt,
+             double *east, double *north, double *up, int n);
+}
+
+static constexpr double DEG = M_PI / 180.0;
+static constexpr double RAD = 180.0 / M_PI;
+static constexpr double WGS84_E2 = WGS84_F * (2.0 - WGS84_F);
+
+static Kernel detectKernel()
+{
+    const char *env = std::getenv("KUZGUN_GEODESY");
+    if (env && std::strcmp(env, "scalar") == 0)
+        return Kernel::Scalar;
+    return detail::avx2Supported() ? Kernel::Avx2 : Kernel::Scalar;
+}
+
+static Kernel &kernelRef()
+{
+    static Kernel k = detectKernel();
+    return k;
+}
+
+Kernel activeKernel() { return kernelRef(); }
+
+const char *kernelName()
+{
+    return kernelRef() == Kernel::Avx2 ? "avx2" : "scalar";
+}
+
+void forceKernel(Kernel k)
+{
+    kernelRef() = (k == Kernel::Avx2 && !detail::avx2Supported()) ? Kernel::Scalar : k;
+}
+
+static inline double normalizeLon(double lon)
+{
+    lon = std::fmod(lon + 540.0, 360.0) - 180.0;
+    return lon;
+}
+
+// ---------------------------------------------------------------- tekil
+
+double haversine(double lat1, double lon1, double lat2, double lon2)
+{
+    const double dLat = (lat2 - lat1) * DEG;
+    const double dLon = (lon2 - lon1) * DEG;
+    const double sLat = std::sin(dLat * 0.5);
+    const double sLon = std::sin(dLon * 0.5);
+    const double a = sLat * sLat + std::cos(lat1 * DEG) * std::cos(lat2 * DEG) * sLon * sLon;
+    return 2.0 * EARTH_RADIUS * std::atan2(std::sqrt(a), std::sqrt(1.0 - a));
+}
+
+double vincenty(double lat1, double lon1, double lat2, double lon2)
+{
+    const double a = WGS84_A;
+    const double f = WGS84_F;
+    const double b = a * (1.0 - f);
+
+    const double L = (lon2 - lon1) * DEG;
+    const double U1 = std::atan((1.0 - f) * std::tan(lat1 * DEG));
+    const double U2 = std::atan((1.0 - f) * std::tan(lat2 * DEG));
+    const double sinU1 = std::sin(U1), cosU1 = std::cos(U1);
+    const double sinU2 = std::sin(U2), cosU2 = std::cos(U2);
+
+    double lambda = L;
+    double sinSigma = 0, cosSigma = 0, sigma = 0, cos2Alpha = 0, cos2SigmaM = 0;
+
+    for (int iter = 0; iter < 200; ++iter) {
+        const double sinL = std::sin(lambda), cosL = std::cos(lambda);
+        const double t1 = cosU2 * sinL;
+        const double t2 = cosU1 * sinU2 - sinU1 * cosU2 * cosL;
+        sinSigma = std::sqrt(t1 * t1 + t2 * t2);
+        if (sinSigma == 0.0) return 0.0;                // aynı nokta
+
+        cosSigma = sinU1 * sinU2 + cosU1 * cosU2 * cosL;
+        sigma = std::atan2(sinSigma, cosSigma);
+        const double sinAlpha = cosU1 * cosU2 * sinL / sinSigma;
+        cos2Alpha = 1.0 - sinAlpha * sinAlpha;
+        cos2SigmaM = cos2Alpha != 0.0 ? cosSigma - 2.0 * sinU1 * sinU2 / cos2Alpha : 0.0;
+
+        const double C = f / 16.0 * cos2Alpha * (4.0 + f * (4.0 - 3.0 * cos2Alpha));
+        const double prev = lambda;
+        lambda = L + (1.0 - C) * f * sinAlpha *
+                         (sigma + C * sinSigma * (cos2SigmaM + C * cosSigma * (-1.0 + 2.0 * cos2SigmaM * cos2SigmaM)));
+
+        if (std::fabs(lambda - prev) < 1e-12) {
+            const double u2 = cos2Alpha * (a * a - b * b) / (b * b);
+            const double A = 1.0 + u2 / 16384.0 * (4096.0 + u2 * (-768.0 + u2 * (320.0 - 175.0 * u2)));
+            const double B = u2 / 1024.0 * (256.0 + u2 * (-128.0 + u2 * (74.0 - 47.0 * u2)));
+            const double dSigma = B * sinSigma * (cos2SigmaM + B / 4.0 * (cosSigma * (-1.0 + 2.0 * cos2SigmaM * cos2SigmaM)
+                                                                         - B / 6.0 * cos2SigmaM * (-3.0 + 4.0 * sinSigma * sinSigma)
+                                                                               * (-3.0 + 4.0 * cos2SigmaM * cos2SigmaM)));
+            return b * A * (sigma - dSigma);
+        }
+    }
+
+    // Neredeyse karşıt noktalar: yakınsamadı
+    return haversine(lat1, lon1, lat2, lon2);
+}
+
+double bearing(double lat1, double lon1, double lat2, double lon2)
+{
+    const double p1 = lat1 * DEG, p2 = lat2 * DEG;
+    const double dl = (lon2 - lon1) * DEG;
+    const double y = std::sin(dl) * std::cos(p2);
+    const double x = std::cos(p1) * std::sin(p2) - std::sin(p1) * std::cos(p2) * std::cos(dl);
+    const double deg = std::atan2(y, x) * RAD;
+    return deg < 0.0 ? deg + 360.0 : deg;
+}
+
+void destination(double lat, double lon, double bearingDeg, double dist,
+                 double &outLat, double &outLon)
+{
+    const double p1 = lat * DEG;
+    const double th = bearingDeg * DEG;
+    const double d = dist / EARTH_RADIUS;
+
+    const double sinP1 = std::sin(p1), cosP1 = std::cos(p1);
+    const double sinD = std::sin(d), cosD = std::cos(d);
+
+    const double sinP2 = sinP1 * cosD + cosP1 * sinD * std::cos(th);
+    const double p2 = std::asin(sinP2);
+    const double l2 = std::atan2(std::sin(th) * sinD * cosP1, cosD - sinP1 * sinP2);
+
+    outLat = p2 * RAD;
+    outLon = normalizeLon(lon + l2 * RAD);
+}
+
+// ---------------------------------------------------------------- skaler batch
+
+static void haversineScalar(const double *lat1, const double *lon1,
+                            const double *lat2, const double *lon2, double *out, int n)
+{
+    for (int i = 0; i < n; ++i)
+        out[i] = haversine(lat1[i], lon1[i], lat2[i], lon2[i]);
+}
+
+static void bearingScalar(const double *lat1, const double *lon1,
+                          const double *lat2, const double *lon2, double *out, int n)
+{
+    for (int i = 0; i < n; ++i)
+        out[i] = bearing(lat1[i], lon1[i], lat2[i], lon2[i]);
+}
+
+static void destinationScalar(const double *lat, const double *lon, const double *brg, const double *dist,
+                              double *outLat, double *outLon, int n)
+{
+    for (int i = 0; i < n; ++i)
+        destination(lat[i], lon[i], brg[i], dist[i], outLat[i], outLon[i]);
+}
+
+static void enuScalar(double lat0, double lon0, double alt0,
+                      const double *lat, const double *lon, const double *alt,
+                      double *east, double *north, double *up, int n)
+{
+    auto ecef = [](double latDeg, double lonDeg, double h, double &x, double &y, double &z) {
+        const double sp = std::sin(latDeg * DEG), cp = std::cos(latDeg * DEG);
+        const double sl = std::sin(lonDeg * DEG), cl = std::cos(lonDeg * DEG);
+        const double N = WGS84_A / std::sqrt(1.0 - WGS84_E2 * sp * sp);
+        x = (N + h) * cp * cl;
+        y = (N + h) * cp * sl;
+        z = (N * (1.0 - WGS84_E2) + h) * sp;
+    };
+
+    double x0, y0, z0;
+    ecef(lat0, lon0, alt0, x0, y0, z0);
+    const double sp0 = std::sin(lat0 * DEG), cp0 = std::cos(lat0 * DEG);
+    const double sl0 = std::sin(lon0 * DEG), cl0 = std::cos(lon0 * DEG);
+
+    for (int i = 0; i < n; ++i) {
+        double x, y, z;
+        ecef(lat[i], lon[i], alt[i], x, y, z);
+        const double dx = x - x0, dy = y - y0, dz = z - z0;
+        east[i]  = -sl0 * dx + cl0 * dy;
+        north[i] = -sp0 * cl0 * dx - sp0 * sl0 * dy + cp0 * dz;
+        up[i]    =  cp0 * cl0 * dx + cp0 * sl0 * dy + sp0 * dz;
+    }
+}
+
+// ---------------------------------------------------------------- dispatch
+
+void haversineBatch(const double *lat1, const double *lon1,
+                    const double *lat2, const double *lon2,
+                    double *outDist, int n)
+{
+    if (activeKernel() == Kernel::Avx2)
+        detail::haversineAvx2(lat1, lon1, lat2, lon2, outDist, n);
+    else
+        haversineScalar(lat1, lon1, lat2, lon2, outDist, n);
+}
+
+void vincentyBatch(const double *lat1, const double *lon1,
+                   const double *lat2, const double *lon2,
+                   double *outDist, int n)
+{
+    for (int i = 0; i < n; ++i)
+        outDist[i] = vincenty(lat1[i], lon1[i], lat2[i], lon2[i]);
+}
+
+void bearingBatch(const double *lat1, const double *lon1,
+                  const double *lat2, const double *lon2,
+                  double *outBearing, int n)
+{
+    if (activeKernel() == Kernel::Avx2)
+        detail::bearingAvx2(lat1, lon1, lat2, lon2, outBearing, n);
+    else
+        bearingScalar(lat1, lon1, lat2, lon2, outBearing, n);
+}
+
+void destinationBatch(const double *lat, const double *lon,
+                      const double *bearingDeg, const double *dist,
+                      double *outLat, double *outLon, int n)
+{
+    if (activeKernel() == Kernel::Avx2)
+        detail::destinationAvx2(lat, lon, bearingDeg, dist, outLat, outLon, n);
+    else
+        destinationScalar(lat, lon, bearingDeg, dist, outLat, outLon, n);
+}
+
+void enuBatch(double lat0, double lon0, double alt0,
+              const double *lat, const double *lon, const double *alt,
+              double *east, double *north, double *up, int n)
+{
+    if (activeKernel() == Kernel::Avx2)
+        detail::enuAvx2(lat0, lon0, alt0, lat, lon, alt, east, north, up, n);
+    else
+        enuScalar(lat0, lon0, alt0, lat, lon, alt, east, north, up, n);
+}
+
+void nedBatch(double lat0, double lon0, double alt0,
+              const double *lat, const double *lon, const double *alt,
+              double *north, double *east, double *down, int n)
+{
+    enuBatch(lat0, lon0, alt0, lat, lon, alt, east, north, down, n);
+    for (int i = 0; i < n; ++i)
+        down[i] = -down[i];
+}
+
+}
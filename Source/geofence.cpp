@@ -0,0 +1,212 @@
+#include "geofence.h"
+
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+static constexpr double EDGES_PER_CELL = 2.0;      // ızgara boyutu hedefi
+static constexpr int MIN_GRID = 8;
+static constexpr int MAX_GRID = 1024;
+static constexpr double MIN_MOVE_M = 0.5;           // yön için en az yer değiştirme
+
+// Yön testi; 0 pozitif sayılır, komşu kenarların ortak köşesi çift sayılmaz
+static inline bool side(double ax, double ay, double bx, double by, double px, double py)
+{
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax) >= 0.0;
+}
+
+static inline bool crosses(double cx, double cy, double px, double py, const double *e)
+{
+    return side(cx, cy, px, py, e[0], e[1]) != side(cx, cy, px, py, e[2], e[3])
+        && side(e[0], e[1], e[2], e[3], cx, cy) != side(e[0], e[1], e[2], e[3], px, py);
+}
+
+int Geofence::cellOf(double x, double y) const
+{
+    const int cx = int(std::floor((x - m_x0) / m_cw));
+    const int cy = int(std::floor((y - m_y0) / m_ch));
+    if (cx < 0 || cy < 0 || cx >= m_cols || cy >= m_rows) return -1;
+    return cy * m_cols + cx;
+}
+
+void Geofence::setZones(const QVector<MissionValidator::Zone> &zones)
+{
+    m_zones.clear();
+    for (const MissionValidator::Zone &z : zones)
+        if (z.ring.size() >= 3) m_zones.append(z);
+    m_hasFence = std::any_of(m_zones.cbegin(), m_zones.cend(),
+                             [](const MissionValidator::Zone &z) { return z.inclusion; });
+    m_cellStart.clear();
+    m_entries.clear();
+    m_edges.clear();
+    m_cols = m_rows = 0;
+    if (m_zones.isEmpty()) return;
+
+    // Izgara: tüm bölgelerin kutusu, hücre başına ~EDGES_PER_CELL kenar
+    double minX = 1e300, minY = 1e300, maxX = -1e300, maxY = -1e300;
+    int edgeCount = 0;
+    for (const MissionValidator::Zone &z : std::as_const(m_zones)) {
+        for (const GeoPoint &p : z.ring) {
+            minX = std::min(minX, p.lon); maxX = std::max(maxX, p.lon);
+            minY = std::min(minY, p.lat); maxY = std::max(maxY, p.lat);
+        }
+        edgeCount += z.ring.size();
+    }
+    const double w = std::max(maxX - minX, 1e-9), h = std::max(maxY - minY, 1e-9);
+    const double cells = qBound(double(MIN_GRID * MIN_GRID), edgeCount / EDGES_PER_CELL,
+                                double(MAX_GRID) * MAX_GRID);
+    m_cols = qBound(MIN_GRID, int(std::ceil(std::sqrt(cells * w / h))), MAX_GRID);
+    m_rows = qBound(MIN_GRID, int(std::ceil(std::sqrt(cells * h / w))), MAX_GRID);
+    m_cw = w / m_cols * (1.0 + 1e-9);
+    m_ch = h / m_rows * (1.0 + 1e-9);
+    m_x0 = minX;
+    m_y0 = minY;
+    m_frame = EnuFrame(0.5 * (minY + maxY), 0.5 * (minX + maxX));
+    const int cellCount = m_cols * m_rows;
+
+    // Hücre başına (bölge, kenar) listesi; bölge sırasıyla
+    std::vector<std::vector<Edge>> cellEdges(cellCount);
+    // Merkez satırlarında yatay ışın kesişimleri: hücre merkezi içeride mi
+    std::vector<std::vector<char>> inside(cellCount);
+
+    std::vector<std::vector<double>> rowHits(m_rows);
+    for (int zi = 0; zi < m_zones.size(); ++zi) {
+        const QVector<GeoPoint> &ring = m_zones[zi].ring;
+        for (std::vector<double> &r : rowHits) r.clear();
+
+        for (int i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+            const Edge e{zi, ring[j].lon, ring[j].lat, ring[i].lon, ring[i].lat};
+
+            // Kenarın geçtiği satırlar; her satırda kenarın x aralığı
+            const double ylo = std::min(e.ay, e.by), yhi = std::max(e.ay, e.by);
+            const int r0 = qBound(0, int(std::floor((ylo - m_y0) / m_ch)), m_rows - 1);
+            const int r1 = qBound(0, int(std::floor((yhi - m_y0) / m_ch)), m_rows - 1);
+            for (int r = r0; r <= r1; ++r) {
+                const double bandLo = std::max(ylo, m_y0 + r * m_ch);
+                const double bandHi = std::min(yhi, m_y0 + (r + 1) * m_ch);
+                double xa = e.ax, xb = e.bx;
+                if (e.ay != e.by) {
+                    const double k = (e.bx - e.ax) / (e.by - e.ay);
+                    xa = e.ax + (bandLo - e.ay) * k;
+                    xb = e.ax + (bandHi - e.ay) * k;
+                }
+                // Yuvarlama payı: sınıra değen kenar iki hücreye de girer
+                const double pad = 1e-6 * m_cw;
+                const int c0 = qBound(0, int(std::floor((std::min(xa, xb) - pad - m_x0) / m_cw)), m_cols - 1);
+                const int c1 = qBound(0, int(std::floor((std::max(xa, xb) + pad - m_x0) / m_cw)), m_cols - 1);
+                for (int c = c0; c <= c1; ++c)
+                    cellEdges[r * m_cols + c].push_back(e);
+
+                // Merkez satırı: yarı açık kural (ay > y) != (by > y)
+                const double yc = m_y0 + (r + 0.5) * m_ch;
+                if ((e.ay > yc) != (e.by > yc))
+                    rowHits[r].push_back(e.ax + (yc - e.ay) * (e.bx - e.ax) / (e.by - e.ay));
+            }
+        }
+
+        for (int r = 0; r < m_rows; ++r) {
+            std::vector<double> &hits = rowHits[r];
+            if (hits.empty()) continue;
+            std::sort(hits.begin(), hits.end());
+            size_t k = 0;
+            for (int c = 0; c < m_cols; ++c) {
+                const double xc = m_x0 + (c + 0.5) * m_cw;
+                while (k < hits.size() && hits[k] < xc) ++k;
+                if (k & 1) {
+                    std::vector<char> &in = inside[r * m_cols + c];
+                    in.resize(m_zones.size(), 0);
+                    in[zi] = 1;
+                }
+            }
+        }
+    }
+
+    // CSR: hücre -> bölge girdileri, her girdi -> kenar aralığı
+    m_cellStart.assign(cellCount + 1, 0);
+    for (int cell = 0; cell < cellCount; ++cell) {
+        m_cellStart[cell] = int(m_entries.size());
+        const std::vector<Edge> &ce = cellEdges[cell];
+        const std::vector<char> &in = inside[cell];
+        size_t k = 0;
+        for (int zi = 0; zi < m_zones.size(); ++zi) {
+            const int begin = int(m_edges.size());
+            while (k < ce.size() && ce[k].zone == zi)
+                m_edges.push_back(ce[k++]);
+            const bool centerIn = !in.empty() && in[zi];
+            if (centerIn || int(m_edges.size()) > begin)
+                m_entries.push_back(Entry{zi, centerIn, begin, int(m_edges.size())});
+        }
+    }
+    m_cellStart[cellCount] = int(m_entries.size());
+}
+
+Geofence::Result Geofence::check(double lat, double lon) const
+{
+    Result r;
+    if (m_zones.isEmpty()) return r;
+
+    bool inFence = false;
+    const int cell = cellOf(lon, lat);
+    if (cell >= 0) {
+        const int cx = cell % m_cols, cy = cell / m_cols;
+        const double mx = m_x0 + (cx + 0.5) * m_cw, my = m_y0 + (cy + 0.5) * m_ch;
+
+        for (int k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+            const Entry &en = m_entries[k];
+            bool in = en.centerInside;
+            for (int i = en.edgeBegin; i < en.edgeEnd; ++i)
+                if (crosses(mx, my, lon, lat, &m_edges[i].ax))
+                    in = !in;
+            if (!in) continue;
+
+            if (m_zones[en.zone].inclusion) {
+                inFence = true;
+            } else if (r.breach == None) {
+                r.breach = NoFly;
+                r.zone = en.zone;
+            }
+        }
+    }
+    if (r.breach == None && m_hasFence && !inFence)
+        r.breach = OutsideFence;
+    return r;
+}
+
+Geofence::Status Geofence::update(double lat, double lon, double speed)
+{
+    Status s;
+    s.now = check(lat, lon);
+
+    // Yön: son fix'ten bu yana yer değiştirme (yerel düzlem)
+    double e, n;
+    m_frame.toLocal(lat, lon, e, n);
+    if (m_hasLast) {
+        const double d = std::hypot(e - m_lastE, n - m_lastN);
+        if (d >= MIN_MOVE_M) {
+            m_dirE = (e - m_lastE) / d;
+            m_dirN = (n - m_lastN) / d;
+            m_lastE = e;
+            m_lastN = n;
+        }
+    } else {
+        m_hasLast = true;
+        m_lastE = e;
+        m_lastN = n;
+        m_dirE = m_dirN = 0.0;
+    }
+
+    if (m_zones.isEmpty() || speed <= 0.0 || (m_dirN == 0.0 && m_dirE == 0.0))
+        return s;
+
+    for (double t = STEP_S; t <= LOOKAHEAD_S + 1e-9; t += STEP_S) {
+        double pLat, pLon;
+        m_frame.toGeo(e + m_dirE * speed * t, n + m_dirN * speed * t, pLat, pLon);
+        const Result r = check(pLat, pLon);
+        if (r.breach != None && r.breach != s.now.breach) {
+            s.ahead = r;
+            s.aheadSeconds = t;
+            break;
+        }
+    }
+    return s;
+}
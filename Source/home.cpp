@@ -7,14 +7,12 @@
 #include <QComboBox>
 #include <QUrl>
 #include <QDebug>
+#include <QDoubleSpinBox>
 #include <QDoubleValidator>
 
-#include <QWebEngineProfile>
-#include <QStandardPaths>
-#include <QDir>
-
-#include <QWebChannel>
-#include <QWebEnginePage>
+#include "mapservice.h"
+#include "mapsurface.h"
+#include "missionmodel.h"
 #include <QTimer>
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -24,11 +22,30 @@
 #include <QtMath>
 #include "HorizonWidget.h"
 #include <QVBoxLayout>
+#include <QApplication>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QSettings>
+#include <QStandardPaths>
+
+static constexpr double GRAVITY = 9.80665;
+static constexpr int NAV_TICK_MS = 20;              // 50 Hz filtre çıkışı
+static constexpr int COVERAGE_UPLOAD_MS = 1000;     // değişen kapsama karoları
+static constexpr double MIN_COVERAGE_SPEED = 1.0;   // m/s; yerde titreşim boyamasın
+
+static QString geofenceSettingsPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/geofence.ini";
+}
+
+static QString coverageSettingsPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/coverage.ini";
+}
 
 Home::Home(QWidget *parent)
     : QWidget(parent)
     , ui(new Ui::Home)
-    ,bridge(new MapBridge(this))
 {
     ui->setupUi(this);
     auto *hz = new HorizonWidget(ui->horizonPlaceholder);
@@ -42,9 +59,22 @@ Home::Home(QWidget *parent)
     setWindowIcon(QIcon(":/img/logo.jpeg"));
     addStyleSheet();
     serial = new SerialManager(this);
+    m_navClock.start();
+    m_downloader = new MissionDownloader(serial, this);
     listSerialPorts();
     getMap();
     getTriggers();
+
+    // Son yüklenen geofence açılışta tekrar yüklenir
+    QSettings st(geofenceSettingsPath(), QSettings::IniFormat);
+    const QString fencePath = st.value("path").toString();
+    if (!fencePath.isEmpty() && !loadGeofence(fencePath))
+        qDebug() << "Geofence could not be restored from" << fencePath;
+
+    QSettings cov(coverageSettingsPath(), QSettings::IniFormat);
+    ui->spinSwath->setValue(cov.value("swath", m_coverage.swath()).toDouble());
+    m_coverage.setSwath(ui->spinSwath->value());
+    MapService::markPhase(mapReady ? "Home ready (map prewarmed)" : "Home ready (map loading)");
 }
 
 void Home::getTriggers(){
@@ -60,8 +90,7 @@ void Home::getTriggers(){
 
         zoom = qBound(0.0, zoom, 22.0);
 
-        QString js = QString("setMapZoomFromQt(%1);").arg(zoom, 0, 'f', 1);
-        ui->mapView->page()->runJavaScript(js);
+        m_map->setZoom(zoom);
 
         ui->zoomSlider->blockSignals(true);
         ui->zoomSlider->setValue(qRound(zoom * 10.0));
@@ -80,20 +109,68 @@ void Home::getTriggers(){
     });
     connect(ui->btnConnect, &QToolButton::clicked,
             this, &Home::onConnectClicked);
+    connect(ui->btnGeofence, &QPushButton::clicked,
+            this, &Home::onGeofenceClicked);
+    // Yeni genişlik sonraki parçalardan itibaren geçerli
+    connect(ui->spinSwath, &QDoubleSpinBox::valueChanged, this, [this](double swath) {
+        m_coverage.setSwath(swath);
+        QSettings st(coverageSettingsPath(), QSettings::IniFormat);
+        st.setValue("swath", swath);
+    });
+    connect(ui->btnClearCoverage, &QPushButton::clicked, this, [this]() {
+        m_coverage.clear();
+        m_map->clearCoverage();
+        ui->StCoverage->setText("0.00 ha");
+    });
     connect(serial, &SerialManager::messageReceived,
             this, &Home::onSerialMessage);
+    connect(m_downloader, &MissionDownloader::started, this, [this](int) {
+        ui->lblMissionDownload->show();
+    });
+    connect(m_downloader, &MissionDownloader::progress,
+            this, &Home::onDownloadProgress);
+    // Alınanlar geldikçe çizilir; haritaya giden güncellemeler aralıklı
+    connect(m_downloader, &MissionDownloader::partial,
+            this, [this](const QVector<Waypoint> &received) {
+                wps = received;
+                redrawWaypointsOnMap();
+            });
+    connect(m_downloader, &MissionDownloader::finished,
+            this, [this](bool ok, const QVector<Waypoint> &newWps, const QString &message) {
+                wps = newWps;
+                redrawWaypointsOnMap();
+                qDebug() << "STM32: mission download" << (ok ? "OK" : "FAIL") << message << "->" << wps.size();
+                if (ok) {
+                    QTimer::singleShot(3000, ui->lblMissionDownload, &QLabel::hide);
+                } else {
+                    // Kısmi görev çizilmez; sadece kaç öğe geldiği gösterilir
+                    ui->lblMissionDownload->setText(QString("Mission download failed: %1 (%2 of %3 items)")
+                                                        .arg(message)
+                                                        .arg(m_downloader->received())
+                                                        .arg(m_downloader->total()));
+                }
+            });
     portScanTimer = new QTimer(this);
     connect(portScanTimer, &QTimer::timeout, this, &Home::refreshSerialPorts);
     connect(ui->zoomSlider, &QSlider::valueChanged, this, [this](int value) {
         double zoom = value / 10.0;
 
-        QString js = QString("setMapZoomFromQt(%1);").arg(zoom);
-        ui->mapView->page()->runJavaScript(js);
+        m_map->setZoom(zoom);
 
         ui->lblZoom->setText(QString::number(zoom, 'f', 1));
     });
 
     portScanTimer->start(500);
+
+    // Fix'ler arasında IMU ile ilerletilen konum; tüketiciler bu hızda güncellenir
+    m_navTimer = new QTimer(this);
+    m_navTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_navTimer, &QTimer::timeout, this, &Home::onNavTick);
+    m_navTimer->start(NAV_TICK_MS);
+
+    m_coverageTimer = new QTimer(this);
+    connect(m_coverageTimer, &QTimer::timeout, this, &Home::uploadCoverage);
+    m_coverageTimer->start(COVERAGE_UPLOAD_MS);
     pingTimer = new QTimer(this);
     connect(pingTimer, &QTimer::timeout, this, &Home::sendPing);
 
@@ -125,6 +202,7 @@ void Home::onConnectClicked()
 
         currentPort = portName;
         serial->clearRx();
+        m_homeSet = false;          // yeni bağlantıda ilk fix home olur
         serial->send(currentPort, "CONNECT\n");
     } else {
         qDebug() << "Sending DISCONNECT to" << currentPort;
@@ -164,23 +242,16 @@ void Home::onSerialMessage(const QString &port, const QString &msg)
         return;
     }
 
-    if (line.startsWith("WP_BEGIN,")) {
-        wps.clear();
-        wpReading = true;
-        qDebug() << "STM32: " << line;
-        return;
-    }
+    // Görev yükleme cevapları MissionUploader'a ait
+    if (line.startsWith("MU_")) return;
+
+    // Görev indirme (WP_BEGIN / WP / WP_END) MissionDownloader'a ait
+    if (line.startsWith("WP")) return;
 
-    if (line == "WP_END") {
-        wpReading = false;
-        qDebug() << "STM32: WP_END -> total:" << wps.size();
-        redrawWaypointsOnMap();
-        return;
-    }
     if (line.startsWith("GPS,")) {
         QStringList parts = line.split(',');
         if (parts.size() >= 3 && parts[1] == "NOFIX") {
-            ui->mapView->page()->runJavaScript("setGpsFixState(false);");
+            m_map->setGpsFixState(false);
             int sats = parts[2].toInt();
             hasGpsFix = false;
             qDebug().noquote() << QString("[GPS] NO FIX  SATS=%1").arg(sats);
@@ -195,7 +266,7 @@ void Home::onSerialMessage(const QString &port, const QString &msg)
             double speed = parts[4].toDouble(&okSpeed);
             int fix      = parts[5].toInt();
             int sats     = parts[6].toInt();
-            ui->mapView->page()->runJavaScript("setGpsFixState(true);");
+            m_map->setGpsFixState(true);
             if (okLat && okLon && okAlt && okSpeed) {
                 qDebug().noquote()
                 << QString("[GPS] LAT=%1  LON=%2 ALT=%3 SPEED=%4 FIX=%5  SATS=%6")
@@ -208,11 +279,15 @@ void Home::onSerialMessage(const QString &port, const QString &msg)
 
                 lastGpsLat = lat;
                 lastGpsLon = lon;
-                ui->StSpeed->setText(QString::number(speed, 'f', 0) + " km/h");
-                ui->StAlt->setText(QString::number(alt, 'f', 0) +" m ");
                 hasGpsFix  = (fix > 0);
                 if (hasGpsFix) {
-                    updateUavOnMap(lat, lon);
+                    MapService::instance()->rememberPosition(lat, lon);
+                    if (!m_homeSet) setHome(lat, lon, alt);
+                    m_nav.gps(navTime(), lat, lon, alt, speed / 3.6);
+                    onNavTick();            // düzeltilmiş konum bir sonraki tick'i beklemesin
+                } else {
+                    ui->StSpeed->setText(QString::number(speed, 'f', 0) + " km/h");
+                    ui->StAlt->setText(QString::number(alt, 'f', 0) +" m ");
                 }
 
             } else {
@@ -261,36 +336,6 @@ void Home::onSerialMessage(const QString &port, const QString &msg)
     }
 
 
-    if (wpReading && line.startsWith("WP,")) {
-        Waypoint wp{};
-        wp.status = "WAYPOINT";
-
-        QStringList parts = line.split(',');
-        if (parts.size() >= 6) {
-            bool ok1, ok2, ok3, ok4, ok5;
-            wp.lat    = parts[1].toDouble(&ok1);
-            wp.lon    = parts[2].toDouble(&ok2);
-            wp.alt    = parts[3].toDouble(&ok3);
-            wp.dist   = parts[4].toDouble(&ok4);
-            wp.radius = parts[5].toDouble(&ok5);
-
-            int q1 = line.indexOf('"');
-            int q2 = line.lastIndexOf('"');
-            if (q1 != -1 && q2 > q1) {
-                wp.status = line.mid(q1 + 1, q2 - q1 - 1);
-            }
-
-            if (ok1 && ok2 && ok3 && ok4 && ok5) {
-                wps.push_back(wp);
-            } else {
-                qDebug() << "WP parse fail:" << line;
-            }
-        } else {
-            qDebug() << "WP format bad:" << line;
-        }
-        return;
-    }
-
     if (line == "DATA_BEGIN") {
         qDebug() << "STM32: DATA stream started";
         return;
@@ -341,6 +386,12 @@ void Home::onSerialMessage(const QString &port, const QString &msg)
 
                 double dt = yawTimer.restart() / 1000.0; // ms → s
                 yawDeg += gz * dt;
+
+                // Filtre: m/s^2 ve rad/s, gövde ekseni x sağ, y ileri, z yukarı
+                const double acc[3]  = { ax * GRAVITY, ay * GRAVITY, az * GRAVITY };
+                const double gyro[3] = { qDegreesToRadians(gx), qDegreesToRadians(gy),
+                                         qDegreesToRadians(gz) };
+                m_nav.imu(navTime(), acc, gyro);
                 if (m_horizon) {
                     m_horizon->setAttitude(rollDeg, pitchDeg);
                 }
@@ -366,6 +417,7 @@ void Home::handleDisconnectedState()
 {
     isConnected = false;
     hasGpsFix = false;
+    m_nav.reset();
 
     ui->btnConnect->setIcon(QIcon(":/img/connect.png"));
 
@@ -379,6 +431,8 @@ void Home::handleDisconnectedState()
 
     ui->StSpeed->setText("0 km/h");
     ui->StAlt->setText("0 m");
+    ui->StHomeDist->setText("-");
+    ui->StHomeBrg->setText("-");
 
     if (!currentPort.isEmpty()) {
         serial->disconnectSerial(currentPort);
@@ -387,49 +441,227 @@ void Home::handleDisconnectedState()
 }
 void Home::clearWaypoints()
 {
+    m_downloader->cancel();
     wps.clear();
-    wpReading = false;
     redrawWaypointsOnMap();
+    ui->lblMissionDownload->hide();
+}
+
+void Home::onDownloadProgress(int received, int total, double itemsPerSec)
+{
+    ui->lblMissionDownload->setText(QString("Mission download: %1 / %2  (%3 items/s)")
+                                        .arg(received)
+                                        .arg(total)
+                                        .arg(itemsPerSec, 0, 'f', 0));
 }
 
 void Home::redrawWaypointsOnMap()
 {
-    QJsonArray arr;
-    for (const auto &wp : wps) {
-        QJsonArray p;
-        p.append(wp.lat);
-        p.append(wp.lon);
-        p.append(wp.radius);
-        arr.append(p);
+    m_map->setWaypoints(wps);
+
+    // Görev değişti: ilerleme baştan
+    m_tracker.setMission(wps);
+    m_shownLeg = -1;
+    m_map->setActiveLeg(-1);
+    ui->StXtrack->setText("-");
+    ui->StToGo->setText("-");
+    ui->StEta->setText("-");
+    ui->StWp->setText(wps.isEmpty() ? QString("-") : QString("0 / %1").arg(wps.size()));
+}
+
+// Her filtre tick'inde: aktif bacak, çapraz hata, kalan mesafe, ETA
+void Home::updateMissionProgress(double lat, double lon, double speed)
+{
+    const MissionTracker::State &s = m_tracker.update(lat, lon, speed);
+    if (!s.valid) return;
+
+    const int leg = s.finished ? -1 : s.target;
+    if (leg != m_shownLeg && mapReady) {
+        m_map->setActiveLeg(leg);
+        m_shownLeg = leg;
     }
 
-    const QString json = QString::fromUtf8(QJsonDocument(arr).toJson(QJsonDocument::Compact));
-    const QString js = QString("redrawWaypointsFromList(%1);").arg(json);
+    ui->StXtrack->setText(QString("%1 m %2").arg(std::abs(s.crossTrack), 0, 'f', 0)
+                              .arg(s.crossTrack >= 0 ? "R" : "L"));
+    ui->StToGo->setText(QString::number(s.toGo / 1000.0, 'f', 2) + " km");
+    ui->StEta->setText(s.eta >= 0 ? MissionModel::formatDuration(s.eta) : QString("-"));
+    ui->StWp->setText(s.finished ? QString("Done")
+                                 : QString("%1 / %2").arg(s.target + 1).arg(wps.size()));
+}
 
-    ui->mapView->page()->runJavaScript(js);
+// Filtre çıkışı: harita, hız/irtifa, home, görev ilerlemesi ve geofence
+void Home::onNavTick()
+{
+    if (!hasGpsFix) return;
+    const double t = navTime();
+    if (!m_nav.isValid(t)) return;
+
+    const NavFilter::State s = m_nav.state(t);
+    updateUavOnMap(s.lat, s.lon);
+    ui->StSpeed->setText(QString::number(s.speed * 3.6, 'f', 0) + " km/h");
+    ui->StAlt->setText(QString::number(s.alt, 'f', 0) + " m ");
+    updateHomeReadout(s.lat, s.lon);
+    updateMissionProgress(s.lat, s.lon, s.speed);
+    checkGeofence(s.lat, s.lon, s.speed);
+
+    if (m_homeSet && s.speed >= MIN_COVERAGE_SPEED)
+        m_coverage.addPosition(s.lat, s.lon);
+    else
+        m_coverage.breakTrack();
 }
 
-void Home::getMap(){
-    QWebEngineProfile *profile = QWebEngineProfile::defaultProfile();
+// Sadece değişen karolar; maliyet uçuş süresiyle değil, o saniyede boyanan alanla
+void Home::uploadCoverage()
+{
+    if (!mapReady) return;
 
-    const QString cachePath =
-        QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)
-        + "/webengine_cache";
+    const QVector<quint64> dirty = m_coverage.takeDirty();
+    if (dirty.isEmpty()) return;
+    for (quint64 key : dirty) {
+        GeoPoint sw, ne;
+        m_coverage.tileBounds(key, sw, ne);
+        m_map->setCoverageTile(CoverageMap::tileId(key), m_coverage.renderTile(key), sw, ne);
+    }
+    ui->StCoverage->setText(QString::number(m_coverage.coveredArea() / 10000.0, 'f', 2) + " ha");
+}
 
-    QDir().mkpath(cachePath);
+// Home: bağlantıdan sonraki ilk geçerli fix. İzleme ve plan penceresi aynı
+// home merkezli düzlemi kullanır
+void Home::setHome(double lat, double lon, double alt)
+{
+    m_homeFrame = EnuFrame(lat, lon, alt);
+    m_homeSet = true;
+    m_tracker.setFrame(m_homeFrame);
+    m_coverage.setFrame(m_homeFrame);
+    m_map->clearCoverage();
+    ui->StCoverage->setText("0.00 ha");
+    if (fcWin) {
+        fcWin->homeLat = lat;
+        fcWin->homeLon = lon;
+        fcWin->homeSet = true;
+    }
+    qDebug().noquote() << QString("[HOME] %1, %2").arg(lat, 0, 'f', 7).arg(lon, 0, 'f', 7);
+}
 
-    profile->setCachePath(cachePath);
-    profile->setPersistentStoragePath(cachePath);
-    profile->setHttpCacheType(QWebEngineProfile::DiskHttpCache);
-    profile->setHttpCacheMaximumSize(500 * 1024 * 1024);
+void Home::updateHomeReadout(double lat, double lon)
+{
+    double e, n;
+    m_homeFrame.toLocal(lat, lon, e, n);
+    const double d = EnuFrame::distance(e, n);
+    ui->StHomeDist->setText(d < 1000.0 ? QString::number(d, 'f', 0) + " m"
+                                       : QString::number(d / 1000.0, 'f', 2) + " km");
+    // Araçtan home'a kerteriz
+    ui->StHomeBrg->setText(d < 1.0 ? QString("-")
+                                   : QString::number(EnuFrame::bearing(-e, -n), 'f', 0) + QChar(0x00B0));
+}
 
-    auto *channel = new QWebChannel(ui->mapView->page());
-    channel->registerObject("bridge", bridge);
-    ui->mapView->page()->setWebChannel(channel);
+// Her filtre tick'inde: şu anki konum ve hız vektörüyle ileriye bakış
+void Home::checkGeofence(double lat, double lon, double speed)
+{
+    if (m_fence.isEmpty()) return;
+
+    const Geofence::Status s = m_fence.update(lat, lon, speed);
+    auto zoneText = [this](const Geofence::Result &r) {
+        if (r.breach == Geofence::OutsideFence) return QString("outside geofence");
+        const QString name = m_fence.zones().at(r.zone).name;
+        return name.isEmpty() ? QString("no-fly zone") : QString("no-fly zone '%1'").arg(name);
+    };
+
+    if (s.now.breach != Geofence::None) {
+        ui->lblGeofence->setText("GEOFENCE BREACH: " + zoneText(s.now));
+        if (m_fenceAlarm != 2) {
+            m_fenceAlarm = 2;
+            ui->lblGeofence->setStyleSheet("color: white; background-color: #c62828; border-radius: 6px;");
+            ui->lblGeofence->show();
+            QApplication::beep();
+            qDebug().noquote() << QString("[GEOFENCE] BREACH %1 at %2, %3")
+                                      .arg(zoneText(s.now)).arg(lat, 0, 'f', 7).arg(lon, 0, 'f', 7);
+        }
+        // İhlal başına bir kez; araç geri dönünce sıfırlanır
+        if (ui->chkAutoRtl->isChecked() && !m_rtlSent && isConnected) {
+            serial->send(currentPort, "RTL\n");
+            m_rtlSent = true;
+            qDebug() << "[GEOFENCE] RTL sent";
+        }
+        return;
+    }
+
+    m_rtlSent = false;
+    if (s.ahead.breach != Geofence::None) {
+        ui->lblGeofence->setText(QString("Geofence: %1 in %2 s")
+                                     .arg(zoneText(s.ahead)).arg(s.aheadSeconds, 0, 'f', 0));
+        if (m_fenceAlarm != 1) {
+            m_fenceAlarm = 1;
+            ui->lblGeofence->setStyleSheet("color: black; background-color: #ffa000; border-radius: 6px;");
+            ui->lblGeofence->show();
+        }
+        return;
+    }
+
+    if (m_fenceAlarm != 0) {
+        m_fenceAlarm = 0;
+        ui->lblGeofence->hide();
+    }
+}
+
+bool Home::loadGeofence(const QString &path, QString *error)
+{
+    QVector<MissionValidator::Zone> zones;
+    if (!MissionValidator::loadZones(path, zones, error))
+        return false;
+
+    QElapsedTimer t;
+    t.start();
+    m_fence.setZones(zones);
+    qDebug() << "Geofence:" << zones.size() << "zones from" << path
+             << "indexed in" << t.elapsed() << "ms";
+
+    m_fenceAlarm = 0;
+    m_rtlSent = false;
+    ui->lblGeofence->hide();
+    sendGeofenceToMap();
+    return true;
+}
+
+void Home::sendGeofenceToMap()
+{
+    if (!mapReady) return;
+
+    QVector<QVector<GeoPoint>> rings;
+    QVector<bool> inclusion;
+    for (const MissionValidator::Zone &z : m_fence.zones()) {
+        rings.append(z.ring);
+        inclusion.append(z.inclusion);
+    }
+    m_map->setZones(rings, inclusion);
+}
+
+void Home::onGeofenceClicked()
+{
+    const QString path = QFileDialog::getOpenFileName(this, "Load geofence", QString(),
+                                                      "GeoJSON (*.geojson *.json)");
+    if (path.isEmpty()) return;
+
+    QString error;
+    if (!loadGeofence(path, &error)) {
+        QMessageBox::warning(this, "Load geofence", error);
+        return;
+    }
+    QSettings st(geofenceSettingsPath(), QSettings::IniFormat);
+    st.setValue("path", path);
+}
+
+void Home::getMap(){
+    m_map = MapService::instance()->attach(MapService::HomeMap, ui->mapView);
+    bridge = m_map->bridge();
 
-    ui->mapView->setUrl(QUrl("qrc:/map.html?pick=0"));
-    connect(ui->mapView, &QWebEngineView::loadFinished, this, [this](bool ok){
+    // Sayfa önceden yüklenmiş olabilir; mapLoaded tekrar gelmez
+    mapReady = m_map->isReady();
+    connect(bridge, &MapBridge::mapLoaded, this, [this](bool ok){
         mapReady = ok;
+        m_shownLeg = -1;            // sayfa yeniden yüklendi, bir sonraki fix'te gelir
+        sendGeofenceToMap();
+        m_coverage.markAllDirty();
         if (mapReady && hasGpsFix) {
             updateUavOnMap(lastGpsLat, lastGpsLon);
         }
@@ -440,12 +672,7 @@ void Home::updateUavOnMap(double lat, double lon, bool pan)
     if (!mapReady) return;
     if (!std::isfinite(lat) || !std::isfinite(lon)) return;
 
-    const QString js = QString("setUav(%1, %2, %3);")
-                           .arg(lat, 0, 'f', 7)
-                           .arg(lon, 0, 'f', 7)
-                           .arg(pan ? "true" : "false");
-
-    ui->mapView->page()->runJavaScript(js);
+    m_map->setUav(lat, lon, pan);
 }
 
 void Home::addStyleSheet()
@@ -536,6 +763,26 @@ void Home::addStyleSheet()
         "#StAlt {"
         "  color: white;"
         "}"
+        "#lblXtrack, #lblToGo, #lblEta, #lblWp, #lblHomeDist, #lblHomeBrg,"
+        "#StXtrack, #StToGo, #StEta, #StWp, #StHomeDist, #StHomeBrg,"
+        "#lblCoverage, #lblSwath, #StCoverage {"
+        "  color: white;"
+        "}"
+        "#spinSwath {"
+        "  color: white;"
+        "  background-color: #2b2b2b;"
+        "  border: 1px solid white;"
+        "  border-radius: 6px;"
+        "}"
+        "#btnClearCoverage {"
+        "   background-color: #1e1e1e;"
+        "   border: 1px solid #cdcdcd;"
+        "   border-radius: 6px;"
+        "   color: white;"
+        "}"
+        "#btnClearCoverage:hover {"
+        "   border: 1px solid #0078ff;"
+        "}"
         );
     ui->StSpeed->setText("0 km/h");
     ui->StAlt->setText("0 m");
@@ -547,6 +794,29 @@ void Home::addStyleSheet()
         "  padding: 2px 2px;"
         "}"
         );
+    ui->lblMissionDownload->setStyleSheet("color: white;");
+    ui->lblMissionDownload->hide();
+    ui->btnGeofence->setText("Geofence");
+    ui->btnGeofence->setFont(font);
+    ui->btnGeofence->setStyleSheet(
+        "#btnGeofence {"
+        "   background-color: #1e1e1e;"
+        "   border: 1px solid #cdcdcd;"
+        "   border-radius: 6px;"
+        "   color: white;"
+        "   padding: 2px 5px;"
+        "   text-align: center;"
+        "}"
+
+        "#btnGeofence:hover {"
+        "   border: 1px solid #0078ff;"
+        "}"
+        );
+    ui->chkAutoRtl->setText("Auto RTL");
+    ui->chkAutoRtl->setToolTip("Send RTL to the vehicle when it breaches the geofence");
+    ui->chkAutoRtl->setStyleSheet("color: white;");
+    ui->lblGeofence->setAlignment(Qt::AlignCenter);
+    ui->lblGeofence->hide();
 
 }
 void Home::refreshSerialPorts()
@@ -648,7 +918,18 @@ void Home::listSerialPorts(){
 
 void Home::on_btnFC_clicked()
 {
+    // Plan penceresi zaten açıksa yenisini yaratma
+    if (fcWin) {
+        fcWin->showMaximized();
+        fcWin->raise();
+        fcWin->activateWindow();
+        return;
+    }
+
     fcWin = new FlightController(serial, wps);
+    fcWin->homeLat = m_homeFrame.lat0();
+    fcWin->homeLon = m_homeFrame.lon0();
+    fcWin->homeSet = m_homeSet;
     connect(fcWin, &FlightController::waypointsUpdated,
             this, [this](const QVector<Waypoint>& newWps){
                 this->wps = newWps;
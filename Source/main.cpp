@@ -1,10 +1,12 @@
 #include "main.h"
 #include "./ui_main.h"
+#include "mapservice.h"
 #include <QPixmap>
 #include <QDebug>
 #include <QLabel>
 #include <QHBoxLayout>
 #include <QWidget>
+#include <QTimer>
 
 Main::Main(QWidget *parent)
     : QMainWindow(parent)
@@ -14,6 +16,12 @@ Main::Main(QWidget *parent)
     addStyleSheet();
     setWindowTitle("Flight Controller");
     setWindowIcon(QIcon(":/img/logo.jpeg"));
+
+    // Kullanıcı UAV/UGV seçerken Home haritasını arka planda hazırla.
+    // singleShot(0): önce seçim ekranı çizilsin.
+    QTimer::singleShot(0, this, []() {
+        MapService::instance()->prewarm(MapService::HomeMap);
+    });
 }
 void Main::addStyleSheet()
 {
@@ -55,12 +63,14 @@ void Main::addStyleSheet()
 
 void Main::on_btnUAV_clicked()
 {
+    MapService::markPhase("UAV selected");
     homeWin = new Home();
     homeWin->show();
     this->close();
 }
 void Main::on_btnUGV_clicked()
 {
+    MapService::markPhase("UGV selected");
     homeWin = new Home();
     homeWin->show();
     this->close();
@@ -97,10 +107,24 @@ Main::~Main()
 }
 int main(int argc, char *argv[])
 {
+    MapService::markPhase("main");
+
+    // Chromium bayrakları QApplication'dan önce set edilmeli.
+    // process-per-site: Home ve Plan sayfaları aynı renderer sürecini paylaşır.
+    qputenv("QTWEBENGINE_CHROMIUM_FLAGS",
+            "--enable-gpu-rasterization --enable-zero-copy --process-per-site");
     QApplication a(argc, argv);
+
+    MapService *maps = MapService::instance();
+    maps->setBackend(MapService::backendFromArguments(a.arguments()));
+
+    // WebEngine profili uygulama başında bir kez ayarlanır
+    if (maps->backend() == MapService::WebBackend)
+        maps->profile();
+    MapService::markPhase("map service ready");
+
     Main w;
-    qputenv("QTWEBENGINE_CHROMIUM_FLAGS",
-            "--enable-gpu-rasterization --enable-zero-copy");
     w.show();
+    MapService::markPhase("chooser shown");
     return a.exec();
 }
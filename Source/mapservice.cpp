@@ -0,0 +1,221 @@
+#include "mapservice.h"
+#include "mapsurface.h"
+#include "nativemap.h"
+#include "tilestore.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QUrl>
+#include <QUrlQuery>
+#include <QWebChannel>
+#include <QWebEngineProfile>
+#include <QWebEngineView>
+#include <cmath>
+
+MapPage::MapPage(QWebEngineProfile *profile, const QUrl &url, QObject *parent)
+    : QWebEnginePage(profile, parent),
+    m_bridge(new MapBridge(this))
+{
+    auto *channel = new QWebChannel(this);
+    channel->registerObject("bridge", m_bridge);
+    setWebChannel(channel);
+
+    connect(this, &QWebEnginePage::loadFinished, this, [this](bool ok){
+        m_ready = ok;
+        MapService::markPhase(ok ? "map page loaded" : "map page load FAILED");
+        emit m_bridge->mapLoaded(ok);
+    });
+
+    load(url);
+}
+
+MapService *MapService::instance()
+{
+    static MapService *service = nullptr;
+    if (!service)
+        service = new MapService(qApp);
+    return service;
+}
+
+MapService::Backend MapService::backendFromArguments(const QStringList &args)
+{
+    if (args.contains("--native-map"))
+        return NativeBackend;
+    if (args.contains("--web-map"))
+        return WebBackend;
+
+    const QByteArray env = qgetenv("KUZGUN_MAP_BACKEND").trimmed().toLower();
+    return env == "native" ? NativeBackend : WebBackend;
+}
+
+// Varsayılan konum (map.html ile aynı)
+static constexpr double DEFAULT_LAT = 40.808616;
+static constexpr double DEFAULT_LNG = 29.359141;
+static constexpr int PREWARM_ZOOM = 16;
+static constexpr int PREWARM_RADIUS = 2;   // karo; (2r+1)^2 karo
+
+MapService::MapService(QObject *parent)
+    : QObject(parent),
+    m_lastPos(DEFAULT_LAT, DEFAULT_LNG)
+{
+    loadSettings();
+
+    // Sayfalar profil ve QApplication kapanmadan önce silinmeli
+    connect(qApp, &QCoreApplication::aboutToQuit, this, [this]() {
+        saveSettings();
+        releasePages();
+    });
+}
+
+void MapService::markPhase(const char *phase)
+{
+    static QElapsedTimer timer;
+    if (!timer.isValid())
+        timer.start();
+    qDebug().noquote() << QString("[startup] %1 ms  %2").arg(timer.elapsed(), 6).arg(phase);
+}
+
+static QString settingsPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/map.ini";
+}
+
+void MapService::loadSettings()
+{
+    QSettings st(settingsPath(), QSettings::IniFormat);
+    bool okLat = false, okLon = false;
+    const double lat = st.value("lastLat").toDouble(&okLat);
+    const double lon = st.value("lastLon").toDouble(&okLon);
+    if (okLat && okLon)
+        m_lastPos = QPointF(lat, lon);
+}
+
+void MapService::saveSettings()
+{
+    if (!m_positionDirty) return;
+    QSettings st(settingsPath(), QSettings::IniFormat);
+    st.setValue("lastLat", m_lastPos.x());
+    st.setValue("lastLon", m_lastPos.y());
+    m_positionDirty = false;
+}
+
+void MapService::rememberPosition(double lat, double lon)
+{
+    m_lastPos = QPointF(lat, lon);
+    m_positionDirty = true;
+}
+
+QUrl MapService::pageUrl(Role role) const
+{
+    QUrl url("qrc:/map.html");
+    QUrlQuery q;
+    q.addQueryItem("pick", role == PlanMap ? "1" : "0");
+    q.addQueryItem("lat", QString::number(m_lastPos.x(), 'f', 7));
+    q.addQueryItem("lng", QString::number(m_lastPos.y(), 'f', 7));
+    url.setQuery(q);
+    return url;
+}
+
+void MapService::prewarm(Role role)
+{
+    markPhase("prewarm started");
+    const double lat = m_lastPos.x();
+    const double lon = m_lastPos.y();
+
+    if (m_backend == NativeBackend) {
+        // Son konum etrafındaki karoları diskten/ağdan belleğe al
+        const int n = 1 << PREWARM_ZOOM;
+        const double s = std::sin(lat * M_PI / 180.0);
+        const int cx = int((lon + 180.0) / 360.0 * n);
+        const int cy = int((0.5 - std::log((1.0 + s) / (1.0 - s)) / (4.0 * M_PI)) * n);
+        for (int dy = -PREWARM_RADIUS; dy <= PREWARM_RADIUS; ++dy)
+            for (int dx = -PREWARM_RADIUS; dx <= PREWARM_RADIUS; ++dx)
+                tileStore()->request(PREWARM_ZOOM, cx + dx, cy + dy);
+        return;
+    }
+
+    // Sayfa oluşturulur ve view olmadan yüklenir
+    MapPage *p = page(role);
+    auto prefetch = [p, lat, lon]() {
+        p->runJavaScript(QString("prefetchTiles(%1, %2, %3, %4);")
+                             .arg(lat, 0, 'f', 7)
+                             .arg(lon, 0, 'f', 7)
+                             .arg(PREWARM_ZOOM)
+                             .arg(PREWARM_RADIUS));
+    };
+    if (p->isReady())
+        prefetch();
+    else
+        connect(p->bridge(), &MapBridge::mapLoaded, p, [prefetch](bool ok) {
+            if (ok) prefetch();
+        }, Qt::SingleShotConnection);
+}
+
+QWebEngineProfile *MapService::profile()
+{
+    if (!m_profile)
+        configureProfile();
+    return m_profile;
+}
+
+void MapService::configureProfile()
+{
+    m_profile = QWebEngineProfile::defaultProfile();
+
+    const QString cachePath =
+        QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)
+        + "/webengine_cache";
+    QDir().mkpath(cachePath);
+
+    m_profile->setCachePath(cachePath);
+    m_profile->setPersistentStoragePath(cachePath);
+    m_profile->setHttpCacheType(QWebEngineProfile::DiskHttpCache);
+    m_profile->setHttpCacheMaximumSize(500 * 1024 * 1024);
+}
+
+TileStore *MapService::tileStore()
+{
+    if (!m_tiles)
+        m_tiles = new TileStore(this);
+    return m_tiles;
+}
+
+MapPage *MapService::page(Role role)
+{
+    if (MapPage *p = m_pages.value(role))
+        return p;
+
+    auto *p = new MapPage(profile(), pageUrl(role), this);
+    m_pages.insert(role, p);
+    return p;
+}
+
+MapSurface *MapService::attach(Role role, QWebEngineView *view)
+{
+    if (m_backend == NativeBackend) {
+        auto *w = new NativeMapWidget(tileStore(), role == PlanMap, view->parentWidget());
+        w->centerOn(m_lastPos.x(), m_lastPos.y());
+        w->setGeometry(view->geometry());
+        w->stackUnder(view);
+        w->show();
+
+        // WebEngine view hiç sayfa yüklemeden kaldırılır
+        view->hide();
+        view->deleteLater();
+        return w;
+    }
+
+    MapPage *p = page(role);
+    view->setPage(p);   // aynı sayfa ise Qt bir şey yapmaz
+    return new WebMapSurface(view, p, view);
+}
+
+void MapService::releasePages()
+{
+    qDeleteAll(m_pages);
+    m_pages.clear();
+}
@@ -0,0 +1,176 @@
+#include "mapsurface.h"
+#include "mapservice.h"
+
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QWebEngineView>
+
+WebMapSurface::WebMapSurface(QWebEngineView *view, MapPage *page, QObject *parent)
+    : QObject(parent),
+    m_view(view),
+    m_page(page)
+{
+}
+
+QWidget *WebMapSurface::widget() const
+{
+    return m_view;
+}
+
+MapBridge *WebMapSurface::bridge() const
+{
+    return m_page->bridge();
+}
+
+bool WebMapSurface::isReady() const
+{
+    return m_page->isReady();
+}
+
+void WebMapSurface::runJs(const QString &js)
+{
+    m_page->runJavaScript(js);
+}
+
+void WebMapSurface::setUav(double lat, double lon, bool pan)
+{
+    runJs(QString("setUav(%1, %2, %3);")
+              .arg(lat, 0, 'f', 7)
+              .arg(lon, 0, 'f', 7)
+              .arg(pan ? "true" : "false"));
+}
+
+void WebMapSurface::setGpsFixState(bool fix)
+{
+    runJs(fix ? "setGpsFixState(true);" : "setGpsFixState(false);");
+}
+
+void WebMapSurface::setZoom(double zoom)
+{
+    runJs(QString("setMapZoomFromQt(%1);").arg(zoom, 0, 'f', 1));
+}
+
+void WebMapSurface::setWaypoints(const QVector<Waypoint> &wps)
+{
+    QJsonArray arr;
+    for (const auto &wp : wps) {
+        QJsonArray p;
+        p.append(wp.lat);
+        p.append(wp.lon);
+        p.append(wp.radius);
+        arr.append(p);
+    }
+
+    const QString json = QString::fromUtf8(QJsonDocument(arr).toJson(QJsonDocument::Compact));
+    runJs(QString("redrawWaypointsFromList(%1);").arg(json));
+}
+
+void WebMapSurface::clearWaypoints()
+{
+    runJs("clearWaypointsOnMap();");
+}
+
+void WebMapSurface::updateWaypoint(int index, const Waypoint &wp)
+{
+    runJs(QString("updateWaypointAt(%1, %2, %3, %4);")
+              .arg(index)
+              .arg(wp.lat, 0, 'f', 7)
+              .arg(wp.lon, 0, 'f', 7)
+              .arg(wp.radius, 0, 'f', 1));
+}
+
+void WebMapSurface::insertWaypoint(int index, const Waypoint &wp)
+{
+    runJs(QString("insertWaypointAt(%1, %2, %3, %4);")
+              .arg(index)
+              .arg(wp.lat, 0, 'f', 7)
+              .arg(wp.lon, 0, 'f', 7)
+              .arg(wp.radius, 0, 'f', 1));
+}
+
+void WebMapSurface::removeWaypoint(int index)
+{
+    runJs(QString("removeWaypointAt(%1);").arg(index));
+}
+
+void WebMapSurface::setPolygonDrawMode(bool on)
+{
+    runJs(on ? "setPolygonDrawMode(true);" : "setPolygonDrawMode(false);");
+}
+
+void WebMapSurface::setZones(const QVector<QVector<GeoPoint>> &rings, const QVector<bool> &inclusion)
+{
+    QJsonArray arr;
+    for (int i = 0; i < rings.size(); ++i) {
+        QJsonArray ring;
+        for (const GeoPoint &g : rings[i])
+            ring.append(QJsonArray{g.lat, g.lon});
+        QJsonObject zone;
+        zone["ring"] = ring;
+        zone["inclusion"] = inclusion.value(i);
+        arr.append(zone);
+    }
+
+    const QString json = QString::fromUtf8(QJsonDocument(arr).toJson(QJsonDocument::Compact));
+    runJs(QString("setZones(%1);").arg(json));
+}
+
+void WebMapSurface::setLegHighlights(const QVector<int> &legs)
+{
+    QJsonArray arr;
+    for (int leg : legs)
+        arr.append(leg);
+
+    const QString json = QString::fromUtf8(QJsonDocument(arr).toJson(QJsonDocument::Compact));
+    runJs(QString("setLegHighlights(%1);").arg(json));
+}
+
+// Binlerce nokta olabilir: QJsonArray yerine düz [lat, lng, lat, lng, ...]
+void WebMapSurface::setFlightPath(const QVector<GeoPoint> &path)
+{
+    QByteArray js;
+    js.reserve(path.size() * 24 + 32);
+    js += "setFlightPath([";
+    for (int i = 0; i < path.size(); ++i) {
+        if (i) js += ',';
+        js += QByteArray::number(path[i].lat, 'f', 7);
+        js += ',';
+        js += QByteArray::number(path[i].lon, 'f', 7);
+    }
+    js += "]);";
+    runJs(QString::fromLatin1(js));
+}
+
+void WebMapSurface::setDragWaypoint(int index)
+{
+    runJs(QString("setDragWaypoint(%1);").arg(index));
+}
+
+void WebMapSurface::setActiveLeg(int index)
+{
+    runJs(QString("setActiveLeg(%1);").arg(index));
+}
+
+// PNG data URL olarak; seyrek karo çoğunlukla boş, birkaç KB
+void WebMapSurface::setCoverageTile(const QString &id, const QImage &image,
+                                    const GeoPoint &sw, const GeoPoint &ne)
+{
+    QByteArray png;
+    QBuffer buf(&png);
+    buf.open(QIODevice::WriteOnly);
+    image.save(&buf, "PNG");
+
+    runJs(QString("setCoverageTile('%1', 'data:image/png;base64,%2', %3, %4, %5, %6);")
+              .arg(id, QString::fromLatin1(png.toBase64()))
+              .arg(sw.lat, 0, 'f', 7)
+              .arg(sw.lon, 0, 'f', 7)
+              .arg(ne.lat, 0, 'f', 7)
+              .arg(ne.lon, 0, 'f', 7));
+}
+
+void WebMapSurface::clearCoverage()
+{
+    runJs("clearCoverage();");
+}
@@ -4,45 +4,19 @@
 #include <QUrl>
 #include <QDebug>
 
-#include <QWebEngineProfile>
-#include <QStandardPaths>
-#include <QDir>
-
-#include <QWebChannel>
-#include <QWebEnginePage>
+#include "mapservice.h"
 
 MapWindow::MapWindow(QWidget *parent)
     : QWidget(parent),
-    ui(new Ui::MapWindow),
-    bridge(new MapBridge(this))
+    ui(new Ui::MapWindow)
 {
     ui->setupUi(this);
 
-    // ⚠️ NOT: qputenv idealde main() içinde, QApplication'dan önce set edilmeli.
-    // Burada kalsın istersen çalışır ama en doğrusu main'e taşımak.
-
-
-    // ✅ Disk cache (yazılabilir bir klasör seç)
-    QWebEngineProfile *profile = QWebEngineProfile::defaultProfile();
-
-    const QString cachePath =
-        QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)
-        + "/webengine_cache";
-
-    QDir().mkpath(cachePath);
-
-    profile->setCachePath(cachePath);
-    profile->setPersistentStoragePath(cachePath);
-    profile->setHttpCacheType(QWebEngineProfile::DiskHttpCache);
-    profile->setHttpCacheMaximumSize(500 * 1024 * 1024);
-
-    // ✅ WebChannel kur
-    auto *channel = new QWebChannel(ui->mapView->page());
-    channel->registerObject("bridge", bridge);
-    ui->mapView->page()->setWebChannel(channel);
-
-    // ✅ Haritayı yükle
-    ui->mapView->setUrl(QUrl("qrc:/map.html"));
+    // Profil MapService'te bir kez ayarlanır; bu pencere sadece kendi sayfasını açar
+    auto *page = new MapPage(MapService::instance()->profile(),
+                             QUrl("qrc:/map.html"), this);
+    bridge = page->bridge();
+    ui->mapView->setPage(page);
 }
 
 MapWindow::~MapWindow()
@@ -0,0 +1,35 @@
+#include "mission.h"
+
+const QStringList &Mission::commandNames()
+{
+    static const QStringList names = {
+        "WAYPOINT",
+        "TAKEOFF",
+        "LAND",
+        "VTOL_TAKEOFF",
+        "VTOL_LAND",
+        "LOITER",
+        "RTL"
+    };
+    return names;
+}
+
+QString Mission::commandName(MissionCommand cmd)
+{
+    const int i = int(cmd);
+    const QStringList &names = commandNames();
+    return (i >= 0 && i < names.size()) ? names[i] : names[0];
+}
+
+MissionCommand Mission::commandFromName(QStringView name, bool *ok)
+{
+    const QStringList &names = commandNames();
+    for (int i = 0; i < names.size(); ++i) {
+        if (name.compare(names[i], Qt::CaseInsensitive) == 0) {
+            if (ok) *ok = true;
+            return MissionCommand(i);
+        }
+    }
+    if (ok) *ok = false;
+    return MissionCommand::Waypoint;
+}
@@ -0,0 +1,105 @@
+#include "missiondelegates.h"
+#include "missionmodel.h"
+
+#include <QComboBox>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QTimer>
+
+// ------------------------------------------------------------------ Status
+
+void StatusDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                           const QModelIndex &index) const
+{
+    QStyledItemDelegate::paint(painter, option, index);
+
+    // Açılır liste olduğunu belli eden küçük ok
+    const QRect r = option.rect.adjusted(0, 0, -6, 0);
+    painter->save();
+    painter->setPen(QColor("#aaaaaa"));
+    painter->drawText(r, Qt::AlignRight | Qt::AlignVCenter, QStringLiteral("▾"));
+    painter->restore();
+}
+
+QWidget *StatusDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &,
+                                      const QModelIndex &) const
+{
+    auto *cb = new QComboBox(parent);
+    cb->addItems(Mission::commandNames());
+
+    // Seçim yapılınca hemen yaz ve kapat
+    auto *self = const_cast<StatusDelegate*>(this);
+    connect(cb, &QComboBox::activated, self, [self, cb](int) {
+        emit self->commitData(cb);
+        emit self->closeEditor(cb);
+    });
+
+    QTimer::singleShot(0, cb, &QComboBox::showPopup);
+    return cb;
+}
+
+void StatusDelegate::setEditorData(QWidget *editor, const QModelIndex &index) const
+{
+    auto *cb = static_cast<QComboBox*>(editor);
+    const int idx = cb->findText(index.data(Qt::DisplayRole).toString());
+    cb->setCurrentIndex(idx >= 0 ? idx : 0);
+}
+
+void StatusDelegate::setModelData(QWidget *editor, QAbstractItemModel *model,
+                                  const QModelIndex &index) const
+{
+    auto *cb = static_cast<QComboBox*>(editor);
+    model->setData(index, cb->currentText(), Qt::EditRole);
+}
+
+// ------------------------------------------------------------------ Remove
+
+void RemoveButtonDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                                 const QModelIndex &index) const
+{
+    const bool hover   = option.state & QStyle::State_MouseOver;
+    const bool pressed = m_pressed.isValid() && m_pressed == index;
+
+    QColor bg("#1e1e1e");
+    if (pressed)    bg = QColor("#700");
+    else if (hover) bg = QColor("#a33");
+
+    const QRectF r = QRectF(option.rect).adjusted(2, 2, -2, -2);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing, true);
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(bg);
+    painter->drawRoundedRect(r, 4, 4);
+
+    QFont f = option.font;
+    f.setPixelSize(14);
+    f.setBold(true);
+    painter->setFont(f);
+    painter->setPen(Qt::white);
+    painter->drawText(r, Qt::AlignCenter, QStringLiteral("X"));
+    painter->restore();
+}
+
+bool RemoveButtonDelegate::editorEvent(QEvent *event, QAbstractItemModel *,
+                                       const QStyleOptionViewItem &option,
+                                       const QModelIndex &index)
+{
+    if (event->type() == QEvent::MouseButtonPress) {
+        auto *me = static_cast<QMouseEvent*>(event);
+        if (me->button() == Qt::LeftButton && option.rect.contains(me->position().toPoint())) {
+            m_pressed = index;
+            return true;
+        }
+    } else if (event->type() == QEvent::MouseButtonRelease) {
+        auto *me = static_cast<QMouseEvent*>(event);
+        const bool hit = m_pressed.isValid() && m_pressed == index
+                         && option.rect.contains(me->position().toPoint());
+        m_pressed = QPersistentModelIndex();
+        if (hit) {
+            emit removeClicked(index.row());
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,351 @@
+#include "missiondownloader.h"
+#include "SerialManager.h"
+
+#include <QDebug>
+#include <QStringList>
+#include <QTimer>
+
+static constexpr int TICK_MS = 50;
+static constexpr int STALL_MS = 1000;               // bu kadar satır gelmezse akış durdu say
+static constexpr int REQUEST_TIMEOUT_MS = 600;      // WP_GET cevabı
+static constexpr int REQUEST_BATCH = 8;             // bir turda istenen eksik sayısı
+static constexpr int MAX_REPAIR_ROUNDS = 6;         // ilerlemesiz tur
+static constexpr int MAX_FULL_RETRIES = 1;          // seq'siz akışta WP_GET,ALL
+static constexpr int MAX_ITEMS = 100000;            // bozuk WP_BEGIN'e karşı
+static constexpr int PROGRESS_INTERVAL_MS = 100;
+static constexpr int PARTIAL_INTERVAL_MS = 150;
+
+MissionDownloader::MissionDownloader(SerialManager *serial, QObject *parent)
+    : QObject(parent),
+    m_serial(serial),
+    m_tick(new QTimer(this))
+{
+    m_tick->setInterval(TICK_MS);
+    connect(m_tick, &QTimer::timeout, this, &MissionDownloader::onTick);
+    connect(m_serial, &SerialManager::messageReceived, this, &MissionDownloader::onLine);
+    connect(m_serial, &SerialManager::disconnected, this, &MissionDownloader::onDisconnected);
+    m_clock.start();
+}
+
+double MissionDownloader::itemsPerSec() const
+{
+    const qint64 ms = m_clock.elapsed() - m_startedAt;
+    return ms > 0 ? m_received * 1000.0 / ms : 0.0;
+}
+
+QVector<Waypoint> MissionDownloader::receivedWaypoints() const
+{
+    QVector<Waypoint> out;
+    out.reserve(m_received);
+    for (int i = 0; i < m_wps.size(); ++i)
+        if (m_have[i]) out.push_back(m_wps[i]);
+    return out;
+}
+
+bool MissionDownloader::write(const QByteArray &data)
+{
+    return m_serial->write(data);
+}
+
+// ------------------------------------------------------------------ durum
+
+void MissionDownloader::begin(int announced)
+{
+    // WP_GET,ALL cevabı da yeni bir WP_BEGIN ile gelir; o hakkı sıfırlama
+    if (!isBusy())
+        m_fullRetries = 0;
+
+    m_countKnown = announced >= 0;
+    const int n = m_countKnown ? announced : 0;
+    m_wps = QVector<Waypoint>(n, Waypoint{});
+    m_have.fill(false, n);
+    m_received = 0;
+    m_next = 0;
+    m_indexed = false;
+    m_ended = false;
+    m_gaps = 0;
+    m_repairRounds = 0;
+    m_repairCursor = 0;
+    m_partialCount = 0;
+
+    m_state = Receiving;
+    m_startedAt = m_lastLineAt = m_lastPartialAt = m_lastProgressAt = m_clock.elapsed();
+    m_tick->start();
+
+    qDebug() << "[DOWNLOAD] WP_BEGIN, announced" << (m_countKnown ? QString::number(n) : QString("?"));
+    emit started(n);
+    reportProgress();
+}
+
+void MissionDownloader::cancel()
+{
+    if (!isBusy()) return;
+    finish(false, "cancelled");
+}
+
+void MissionDownloader::finish(bool ok, const QString &message)
+{
+    m_tick->stop();
+    m_state = ok ? Done : Failed;
+    reportProgress();
+
+    // Eksik görev yayınlanmaz: boşluklar sıkıştırılınca indeksler kayar
+    const QVector<Waypoint> wps = ok ? m_wps : QVector<Waypoint>();
+    const double secs = (m_clock.elapsed() - m_startedAt) / 1000.0;
+    qDebug().noquote() << QString("[DOWNLOAD] %1: %2  (%3/%4 items, %5 s, %6 items/s, %7 gaps)")
+                              .arg(QLatin1String(ok ? "OK" : "FAIL"), message)
+                              .arg(m_received)
+                              .arg(total())
+                              .arg(secs, 0, 'f', 2)
+                              .arg(itemsPerSec(), 0, 'f', 0)
+                              .arg(m_gaps);
+    emit finished(ok, wps, message);
+}
+
+void MissionDownloader::reportProgress()
+{
+    emit progress(m_received, total(), itemsPerSec());
+    m_lastProgressAt = m_clock.elapsed();
+}
+
+void MissionDownloader::pushPartial()
+{
+    m_lastPartialAt = m_clock.elapsed();
+    if (m_received == m_partialCount) return;
+    m_partialCount = m_received;
+    emit partial(receivedWaypoints());
+}
+
+// ------------------------------------------------------------------ alım
+
+void MissionDownloader::onLine(const QString &, const QString &msg)
+{
+    if (!msg.startsWith("WP")) return;
+    const QString line = msg.trimmed();
+
+    if (line.startsWith("WP_BEGIN")) {
+        bool ok = false;
+        const int n = line.section(',', 1, 1).toInt(&ok);
+        begin(ok && n >= 0 && n <= MAX_ITEMS ? n : -1);
+        return;
+    }
+
+    if (!isBusy()) return;
+
+    if (line.startsWith("WP,")) {
+        onItem(line);
+        return;
+    }
+
+    if (line == "WP_END") {
+        onEnd();
+        return;
+    }
+}
+
+void MissionDownloader::onItem(const QString &line)
+{
+    m_lastLineAt = m_clock.elapsed();
+
+    // Tırnaklı komut alanı ayrı tutulur. Seq'li satır: "WP,<int>" + 5 sayı.
+    // Diğer her şey eski satırdır (en az 5 sayı; komut tırnaksız da olabilir).
+    const int q1 = line.indexOf('"');
+    QStringList parts = (q1 != -1 ? line.left(q1) : line).split(',');
+    if (parts.size() > 1 && parts.last().trimmed().isEmpty())
+        parts.removeLast();
+
+    auto numbers = [&parts](int from, int count) {
+        for (int i = from; i < from + count; ++i) {
+            bool ok = false;
+            parts[i].toDouble(&ok);
+            if (!ok) return false;
+        }
+        return true;
+    };
+
+    int seq = -1;
+    int f = 1;
+    bool indexed = false;
+    if (parts.size() >= 7) {
+        parts[1].toInt(&indexed);
+        indexed = indexed && numbers(2, 5);
+    }
+    if (indexed) {
+        seq = parts[1].toInt();
+        m_indexed = true;
+        f = 2;
+    } else if (parts.size() >= 6) {
+        seq = m_next;
+    } else {
+        qDebug() << "[DOWNLOAD] WP format bad:" << line;
+        return;
+    }
+
+    Waypoint wp{};
+    wp.command = MissionCommand::Waypoint;
+    bool ok1, ok2, ok3, ok4, ok5;
+    wp.lat    = parts[f + 0].toDouble(&ok1);
+    wp.lon    = parts[f + 1].toDouble(&ok2);
+    wp.alt    = parts[f + 2].toFloat(&ok3);
+    wp.dist   = parts[f + 3].toFloat(&ok4);
+    wp.radius = parts[f + 4].toFloat(&ok5);
+    if (!(ok1 && ok2 && ok3 && ok4 && ok5)) {
+        // Eski akışta bu satır kayıp sayılır; sıradaki yine bir sonraki indekse
+        qDebug() << "[DOWNLOAD] WP parse fail:" << line;
+        if (!m_indexed) ++m_next;
+        return;
+    }
+
+    const int q2 = line.lastIndexOf('"');
+    if (q1 != -1 && q2 > q1)
+        wp.command = Mission::commandFromName(QStringView(line).mid(q1 + 1, q2 - q1 - 1));
+    else if (parts.size() > f + 5)
+        wp.command = Mission::commandFromName(QStringView(parts[f + 5]).trimmed());
+
+    if (seq < 0 || seq >= MAX_ITEMS) return;
+    if (seq >= m_wps.size()) {
+        if (m_countKnown) {
+            qDebug() << "[DOWNLOAD] WP seq out of range:" << seq << ">=" << total();
+            return;
+        }
+        m_wps.resize(seq + 1);
+        m_have.resize(seq + 1);
+    }
+
+    if (m_state == Receiving && seq > m_next) {
+        ++m_gaps;
+        qDebug() << "[DOWNLOAD] gap: expected" << m_next << "got" << seq;
+    }
+    if (seq >= m_next)
+        m_next = seq + 1;
+
+    if (!m_have[seq]) {
+        m_have[seq] = true;
+        ++m_received;
+    }
+    m_wps[seq] = wp;
+
+    if (m_state == Repairing && m_received == total()) {
+        finish(true, "mission complete (repaired)");
+        return;
+    }
+
+    const qint64 now = m_clock.elapsed();
+    if (now - m_lastPartialAt >= PARTIAL_INTERVAL_MS)
+        pushPartial();
+    if (now - m_lastProgressAt >= PROGRESS_INTERVAL_MS)
+        reportProgress();
+}
+
+void MissionDownloader::onEnd()
+{
+    m_ended = true;
+    m_lastLineAt = m_clock.elapsed();
+
+    if (!m_countKnown) {
+        // Sayı bilinmiyordu: gelen kadarı görev
+        m_wps = receivedWaypoints();
+        m_have.fill(true, m_wps.size());
+        m_received = m_wps.size();
+        finish(true, "mission received (count not announced)");
+        return;
+    }
+
+    if (m_received == total() && (m_indexed || m_next == total())) {
+        finish(true, "mission complete");
+        return;
+    }
+
+    startRepair();
+}
+
+void MissionDownloader::startRepair()
+{
+    if (!m_indexed) {
+        // Eski akış: hangi satırın kaybolduğu bilinemez
+        if (m_fullRetries++ < MAX_FULL_RETRIES) {
+            qDebug() << "[DOWNLOAD] incomplete legacy stream" << m_received << "/" << total()
+                     << "-> WP_GET,ALL";
+            m_ended = false;
+            m_lastLineAt = m_clock.elapsed();
+            write(QByteArray("WP_GET,ALL\n"));
+            return;
+        }
+        finish(false, QString("incomplete: %1 of %2 items").arg(m_received).arg(total()));
+        return;
+    }
+
+    m_state = Repairing;
+    m_repairRounds = 0;
+    m_repairCursor = 0;
+    pushPartial();
+    qDebug() << "[DOWNLOAD] missing" << total() - m_received << "items, requesting";
+    requestMissing();
+}
+
+// Eksiklerden en fazla REQUEST_BATCH tanesini ister; sonraki tur kaldığı yerden
+void MissionDownloader::requestMissing()
+{
+    const int n = total();
+    int sent = 0;
+    for (int k = 0; k < n && sent < REQUEST_BATCH; ++k) {
+        const int seq = (m_repairCursor + k) % n;
+        if (m_have[seq]) continue;
+        write("WP_GET," + QByteArray::number(seq) + '\n');
+        ++sent;
+        m_repairCursor = (seq + 1) % n;
+    }
+    m_lastRequestAt = m_clock.elapsed();
+    m_receivedAtRequest = m_received;
+}
+
+void MissionDownloader::onTick()
+{
+    const qint64 now = m_clock.elapsed();
+
+    switch (m_state) {
+    case Receiving:
+        if (now - m_lastPartialAt >= PARTIAL_INTERVAL_MS)
+            pushPartial();
+        if (now - m_lastProgressAt >= PROGRESS_INTERVAL_MS)
+            reportProgress();
+        if (now - m_lastLineAt < STALL_MS) break;
+
+        // Akış durdu (WP_END kaybolmuş olabilir)
+        if (m_countKnown && m_received == total() && (m_indexed || m_next == total())) {
+            finish(true, m_ended ? "mission complete" : "mission complete (WP_END missing)");
+            break;
+        }
+        if (m_countKnown && (m_indexed || m_fullRetries < MAX_FULL_RETRIES)) {
+            startRepair();
+            break;
+        }
+        finish(false, QString("stream stalled: %1 of %2 items").arg(m_received).arg(total()));
+        break;
+
+    case Repairing: {
+        if (now - m_lastRequestAt < REQUEST_TIMEOUT_MS || now - m_lastLineAt < REQUEST_TIMEOUT_MS)
+            break;
+        // Son turdan beri yeni öğe geldiyse sayaç sıfırlanır
+        if (m_received > m_receivedAtRequest)
+            m_repairRounds = 0;
+        if (++m_repairRounds > MAX_REPAIR_ROUNDS) {
+            finish(false, QString("%1 items missing after repair").arg(total() - m_received));
+            break;
+        }
+        pushPartial();
+        reportProgress();
+        requestMissing();
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+void MissionDownloader::onDisconnected()
+{
+    if (!isBusy()) return;
+    finish(false, "link lost");
+}
@@ -0,0 +1,138 @@
+#include "missiongeometry.h"
+#include "geodesy.h"
+
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+static inline int lowbit(int i) { return i & -i; }
+
+static constexpr double MIN_GROUND_SPEED = 1.0;     // m/s
+
+LegMetrics MissionGeometry::legBetween(double lat1, double lon1, double alt1,
+                                       double lat2, double lon2, double alt2,
+                                       MissionCommand to, const VehicleProfile &vehicle)
+{
+    return legFrom(Geodesy::haversine(lat1, lon1, lat2, lon2),
+                   Geodesy::bearing(lat1, lon1, lat2, lon2), alt2 - alt1, to, vehicle);
+}
+
+double MissionGeometry::groundSpeed(double course, const VehicleProfile &vehicle)
+{
+    if (vehicle.windSpeed <= 0.0) return vehicle.cruise;
+
+    // Rüzgarın estiği yönle rota arasındaki açı: yan bileşen yengeç açısıyla
+    // karşılanır, kalan hava hızı + kuyruk bileşeni yer hızıdır
+    const double rel = qDegreesToRadians(course - (vehicle.windFrom + 180.0));
+    const double along = vehicle.windSpeed * std::cos(rel);
+    const double cross = vehicle.windSpeed * std::sin(rel);
+    const double v2 = vehicle.cruise * vehicle.cruise - cross * cross;
+    const double gs = (v2 > 0.0 ? std::sqrt(v2) : 0.0) + along;
+    return std::max(gs, MIN_GROUND_SPEED);
+}
+
+LegMetrics MissionGeometry::legFrom(double dist, double course, double dz,
+                                    MissionCommand to, const VehicleProfile &vehicle)
+{
+    LegMetrics m;
+    m.dist = dist;
+    m.climb = std::max(0.0, dz);
+
+    // Yatay ve dikey hareket aynı anda yapılır; yavaş olan belirler
+    const double tH = vehicle.cruise > 0 && dist > 0 ? dist / groundSpeed(course, vehicle) : 0.0;
+    const double tV = dz >= 0 ? (vehicle.climb > 0 ? dz / vehicle.climb : 0.0)
+                              : (vehicle.sink  > 0 ? -dz / vehicle.sink : 0.0);
+    m.time = std::max(tH, tV);
+
+    const bool vtol = to == MissionCommand::VtolTakeoff || to == MissionCommand::VtolLand;
+    if (vtol) {
+        // Dikey kısım hover'da, sonra yatay kısım ileri uçuşta; geçiş sabit
+        m.time = tV + tH + vehicle.transitionTime;
+        m.energy = (vehicle.hoverPower * (tV + vehicle.transitionTime) + vehicle.cruisePower * tH) / 3600.0;
+        return m;
+    }
+
+    const double verticalPower = dz >= 0 ? vehicle.climbPower : vehicle.sinkPower;
+    m.energy = (vehicle.cruisePower * (m.time - tV) + verticalPower * tV) / 3600.0;
+    return m;
+}
+
+void MissionGeometry::clear()
+{
+    m_legs.clear();
+    m_tree.clear();
+}
+
+void MissionGeometry::assign(const QVector<LegMetrics> &legs)
+{
+    m_legs = legs;
+    rebuild();
+}
+
+// O(n) kurulum: her düğüm kendi değerini ebeveynine ekler
+void MissionGeometry::rebuild()
+{
+    const int n = m_legs.size();
+    m_tree.resize(n + 1);
+    m_tree[0] = LegMetrics();
+    for (int i = 1; i <= n; ++i)
+        m_tree[i] = m_legs[i - 1];
+    for (int i = 1; i <= n; ++i) {
+        const int p = i + lowbit(i);
+        if (p <= n) m_tree[p] += m_tree[i];
+    }
+}
+
+// Sona ekleme O(log n): yeni düğüm (i - lowbit(i), i] aralığını tutar
+void MissionGeometry::append(const LegMetrics &leg)
+{
+    if (m_tree.isEmpty())
+        m_tree.append(LegMetrics());
+
+    m_legs.append(leg);
+    const int i = m_legs.size();
+    const LegMetrics node = leg + prefix(i - 2) - prefix(i - lowbit(i) - 1);
+    m_tree.append(node);
+}
+
+void MissionGeometry::insert(int i, const LegMetrics &leg)
+{
+    if (i >= m_legs.size()) {
+        append(leg);
+        return;
+    }
+    m_legs.insert(std::max(0, i), leg);
+    rebuild();
+}
+
+void MissionGeometry::remove(int i)
+{
+    if (i < 0 || i >= m_legs.size()) return;
+
+    if (i == m_legs.size() - 1) {
+        // Son düğüm başka bir düğüme katkı yapmaz
+        m_legs.removeAt(i);
+        m_tree.removeAt(i + 1);
+        return;
+    }
+    m_legs.removeAt(i);
+    rebuild();
+}
+
+void MissionGeometry::setLeg(int i, const LegMetrics &leg)
+{
+    if (i < 0 || i >= m_legs.size()) return;
+
+    const LegMetrics delta = leg - m_legs[i];
+    m_legs[i] = leg;
+    for (int k = i + 1; k < m_tree.size(); k += lowbit(k))
+        m_tree[k] += delta;
+}
+
+LegMetrics MissionGeometry::prefix(int k) const
+{
+    LegMetrics sum;
+    for (int i = std::min(k + 1, int(m_legs.size())); i > 0; i -= lowbit(i))
+        sum += m_tree[i];
+    return sum;
+}
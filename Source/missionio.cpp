@@ -0,0 +1,767 @@
+#include "missionio.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QXmlStreamReader>
+
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <string_view>
+
+namespace MissionIO {
+
+static constexpr float DEFAULT_RADIUS = 50.0f;     // FlightController::appendWaypoint ile aynı
+
+static inline void setError(QString *error, const QString &message)
+{
+    if (error) *error = message;
+}
+
+// ---------------------------------------------------------------- MAVLink
+
+// QGC .plan "command" alanı: MAV_CMD_NAV_*
+enum MavCmd : int {
+    MAV_CMD_NAV_WAYPOINT      = 16,
+    MAV_CMD_NAV_LOITER_UNLIM  = 17,
+    MAV_CMD_NAV_LOITER_TURNS  = 18,
+    MAV_CMD_NAV_LOITER_TIME   = 19,
+    MAV_CMD_NAV_RTL           = 20,
+    MAV_CMD_NAV_LAND          = 21,
+    MAV_CMD_NAV_TAKEOFF       = 22,
+    MAV_CMD_NAV_LOITER_TO_ALT = 31,
+    MAV_CMD_NAV_VTOL_TAKEOFF  = 84,
+    MAV_CMD_NAV_VTOL_LAND     = 85
+};
+
+// Konumsuz komutlar (DO_*, kamera, hız ...) görevde karşılığı olmadığı için atlanır
+static bool commandFromMav(int mav, MissionCommand &cmd)
+{
+    switch (mav) {
+    case MAV_CMD_NAV_WAYPOINT:      cmd = MissionCommand::Waypoint;    return true;
+    case MAV_CMD_NAV_LOITER_UNLIM:
+    case MAV_CMD_NAV_LOITER_TURNS:
+    case MAV_CMD_NAV_LOITER_TIME:
+    case MAV_CMD_NAV_LOITER_TO_ALT: cmd = MissionCommand::Loiter;      return true;
+    case MAV_CMD_NAV_RTL:           cmd = MissionCommand::Rtl;         return true;
+    case MAV_CMD_NAV_LAND:          cmd = MissionCommand::Land;        return true;
+    case MAV_CMD_NAV_TAKEOFF:       cmd = MissionCommand::Takeoff;     return true;
+    case MAV_CMD_NAV_VTOL_TAKEOFF:  cmd = MissionCommand::VtolTakeoff; return true;
+    case MAV_CMD_NAV_VTOL_LAND:     cmd = MissionCommand::VtolLand;    return true;
+    default:                                                           return false;
+    }
+}
+
+static int mavFromCommand(MissionCommand cmd)
+{
+    switch (cmd) {
+    case MissionCommand::Takeoff:     return MAV_CMD_NAV_TAKEOFF;
+    case MissionCommand::Land:        return MAV_CMD_NAV_LAND;
+    case MissionCommand::VtolTakeoff: return MAV_CMD_NAV_VTOL_TAKEOFF;
+    case MissionCommand::VtolLand:    return MAV_CMD_NAV_VTOL_LAND;
+    case MissionCommand::Loiter:      return MAV_CMD_NAV_LOITER_UNLIM;
+    case MissionCommand::Rtl:         return MAV_CMD_NAV_RTL;
+    default:                          return MAV_CMD_NAV_WAYPOINT;
+    }
+}
+
+// ---------------------------------------------------------------- JSON tarayıcı
+
+// Sadece .plan okumak için: değerler yerinde taranır, ilgilenilmeyen
+// alt ağaçlar tek döngüyle atlanır. Kaçışlı dizgiler çözülmez (anahtarlar
+// ve "type" değerleri ASCII).
+class JsonScanner
+{
+public:
+    JsonScanner(const char *begin, const char *end) : m_begin(begin), m_p(begin), m_end(end) {}
+
+    bool failed() const { return m_fail; }
+    qsizetype offset() const { return m_p - m_begin; }
+
+    bool consume(char c)
+    {
+        skipWs();
+        if (m_p < m_end && *m_p == c) { ++m_p; return true; }
+        return false;
+    }
+
+    bool expect(char c)
+    {
+        if (consume(c)) return true;
+        return fail();
+    }
+
+    bool string(std::string_view &out)
+    {
+        if (!expect('"')) return false;
+        const char *start = m_p;
+        while (m_p < m_end) {
+            const char c = *m_p;
+            if (c == '"') {
+                out = std::string_view(start, size_t(m_p - start));
+                ++m_p;
+                return true;
+            }
+            m_p += (c == '\\') ? 2 : 1;
+        }
+        return fail();
+    }
+
+    // null -> NaN
+    bool number(double &v)
+    {
+        skipWs();
+        if (m_end - m_p >= 4 && std::string_view(m_p, 4) == "null") {
+            m_p += 4;
+            v = std::numeric_limits<double>::quiet_NaN();
+            return true;
+        }
+        const auto r = std::from_chars(m_p, m_end, v);
+        if (r.ec != std::errc()) return fail();
+        m_p = r.ptr;
+        return true;
+    }
+
+    bool skipValue()
+    {
+        skipWs();
+        if (m_p >= m_end) return fail();
+
+        const char c = *m_p;
+        if (c == '"') {
+            std::string_view unused;
+            return string(unused);
+        }
+        if (c == '{' || c == '[') {
+            int depth = 0;
+            while (m_p < m_end) {
+                const char d = *m_p++;
+                if (d == '"') {
+                    while (m_p < m_end && *m_p != '"')
+                        m_p += (*m_p == '\\') ? 2 : 1;
+                    ++m_p;
+                } else if (d == '{' || d == '[') {
+                    ++depth;
+                } else if (d == '}' || d == ']') {
+                    if (--depth == 0) return true;
+                }
+            }
+            return fail();
+        }
+        // sayı, true, false, null
+        const char *start = m_p;
+        while (m_p < m_end && std::string_view("+-0123456789.eEtruefalsn").find(*m_p) != std::string_view::npos)
+            ++m_p;
+        return m_p != start || fail();
+    }
+
+    // { "k": v, ... } -- f(key) değeri tüketir
+    template <typename F>
+    bool forEachMember(F &&f)
+    {
+        if (!expect('{')) return false;
+        if (consume('}')) return true;
+        do {
+            std::string_view key;
+            if (!string(key) || !expect(':') || !f(key)) return false;
+        } while (consume(','));
+        return expect('}');
+    }
+
+    // [ v, ... ] -- f(index) değeri tüketir
+    template <typename F>
+    bool forEachElement(F &&f)
+    {
+        if (!expect('[')) return false;
+        if (consume(']')) return true;
+        int i = 0;
+        do {
+            if (!f(i++)) return false;
+        } while (consume(','));
+        return expect(']');
+    }
+
+private:
+    void skipWs()
+    {
+        while (m_p < m_end && (*m_p == ' ' || *m_p == '\n' || *m_p == '\r' || *m_p == '\t'))
+            ++m_p;
+    }
+
+    bool fail()
+    {
+        m_fail = true;
+        return false;
+    }
+
+    const char *m_begin;
+    const char *m_p;
+    const char *m_end;
+    bool m_fail = false;
+};
+
+struct PlanItem {
+    std::string_view type;
+    int command = -1;
+    double params[7];
+    double altitude = std::numeric_limits<double>::quiet_NaN();
+};
+
+static bool parsePlanItems(JsonScanner &s, QVector<Waypoint> &out);
+
+static void appendPlanItem(const PlanItem &it, QVector<Waypoint> &out)
+{
+    MissionCommand cmd;
+    if (!commandFromMav(it.command, cmd)) return;
+
+    Waypoint wp{};
+    wp.command = cmd;
+    wp.lat = it.params[4];
+    wp.lon = it.params[5];
+    const double alt = std::isfinite(it.params[6]) ? it.params[6] : it.altitude;
+    wp.alt = std::isfinite(alt) ? float(alt) : 0.0f;
+
+    // RTL ve bazı iniş öğelerinde konum yok: önceki noktada kalır
+    if (!std::isfinite(wp.lat) || !std::isfinite(wp.lon) || (wp.lat == 0.0 && wp.lon == 0.0)) {
+        if (out.isEmpty()) return;
+        wp.lat = out.constLast().lat;
+        wp.lon = out.constLast().lon;
+        if (!std::isfinite(alt)) wp.alt = out.constLast().alt;
+    }
+
+    // Kabul yarıçapı param2, loiter yarıçapı param3 (işaret yönü belirtir)
+    double r = 0.0;
+    if (it.command == MAV_CMD_NAV_WAYPOINT)
+        r = it.params[1];
+    else if (cmd == MissionCommand::Loiter)
+        r = std::fabs(it.params[2]);
+    wp.radius = (std::isfinite(r) && r > 0.0) ? float(r) : DEFAULT_RADIUS;
+
+    out.push_back(wp);
+}
+
+static bool parsePlanItem(JsonScanner &s, QVector<Waypoint> &out)
+{
+    PlanItem it;
+    for (double &p : it.params) p = std::numeric_limits<double>::quiet_NaN();
+
+    const bool ok = s.forEachMember([&](std::string_view key) {
+        if (key == "type")
+            return s.string(it.type);
+        if (key == "command") {
+            double v;
+            if (!s.number(v)) return false;
+            it.command = std::isfinite(v) ? int(v) : -1;
+            return true;
+        }
+        if (key == "params") {
+            return s.forEachElement([&](int i) {
+                return i < 7 ? s.number(it.params[i]) : s.skipValue();
+            });
+        }
+        if (key == "Altitude")
+            return s.number(it.altitude);
+        if (key == "TransectStyleComplexItem") {
+            // Survey / koridor taraması: üretilmiş öğeler "Items" altında
+            return s.forEachMember([&](std::string_view k) {
+                return k == "Items" ? parsePlanItems(s, out) : s.skipValue();
+            });
+        }
+        return s.skipValue();
+    });
+    if (!ok) return false;
+
+    if (it.type == "SimpleItem" || (it.type.empty() && it.command >= 0))
+        appendPlanItem(it, out);
+    return true;
+}
+
+static bool parsePlanItems(JsonScanner &s, QVector<Waypoint> &out)
+{
+    return s.forEachElement([&](int) { return parsePlanItem(s, out); });
+}
+
+bool parsePlan(QByteArrayView data, QVector<Waypoint> &out, QString *error)
+{
+    JsonScanner s(data.data(), data.data() + data.size());
+    bool isPlan = false;
+    bool hasMission = false;
+
+    const bool ok = s.forEachMember([&](std::string_view key) {
+        if (key == "fileType") {
+            std::string_view v;
+            if (!s.string(v)) return false;
+            isPlan = (v == "Plan");
+            return true;
+        }
+        if (key == "mission") {
+            hasMission = true;
+            return s.forEachMember([&](std::string_view k) {
+                return k == "items" ? parsePlanItems(s, out) : s.skipValue();
+            });
+        }
+        return s.skipValue();
+    });
+
+    if (!ok) {
+        setError(error, QString("JSON syntax error at byte %1").arg(s.offset()));
+        return false;
+    }
+    if (!isPlan || !hasMission) {
+        setError(error, "Not a QGroundControl plan file");
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------- XML ortak
+
+// "lon,lat[,alt] lon,lat[,alt] ..." (KML coordinates)
+template <typename F>
+static void forEachKmlTuple(QStringView text, F &&f)
+{
+    const qsizetype n = text.size();
+    qsizetype i = 0;
+    while (i < n) {
+        while (i < n && text[i].isSpace()) ++i;
+        const qsizetype start = i;
+        while (i < n && !text[i].isSpace()) ++i;
+        if (i == start) break;
+
+        const QStringView tuple = text.mid(start, i - start);
+        double v[3] = {0.0, 0.0, 0.0};
+        int k = 0;
+        qsizetype from = 0;
+        bool ok = true;
+        while (k < 3 && from <= tuple.size()) {
+            qsizetype comma = tuple.indexOf(u',', from);
+            if (comma < 0) comma = tuple.size();
+            v[k++] = tuple.mid(from, comma - from).toDouble(&ok);
+            if (!ok) break;
+            from = comma + 1;
+        }
+        if (ok && k >= 2)
+            f(v[1], v[0], v[2]);
+    }
+}
+
+static QString xmlError(const QXmlStreamReader &xml)
+{
+    return QString("XML error at line %1: %2").arg(xml.lineNumber()).arg(xml.errorString());
+}
+
+static inline QByteArray fmt(double v, int prec)
+{
+    return QByteArray::number(v, 'f', prec);
+}
+
+// ---------------------------------------------------------------- KML
+
+bool parseKml(QByteArrayView data, QVector<Waypoint> &out, QString *error)
+{
+    QXmlStreamReader xml(QByteArray::fromRawData(data.data(), data.size()));
+
+    enum Geom { NoGeom, PointGeom, LineGeom };
+    enum Field { NoField, CommandField, RadiusField };
+
+    QVector<Waypoint> line;         // nokta yoksa ilk LineString görev olur
+    bool inPlacemark = false;
+    bool hasPoint = false;
+    Geom geom = NoGeom;
+    Field field = NoField;
+    Waypoint cur{};
+
+    auto fresh = [] {
+        Waypoint wp{};
+        wp.radius = DEFAULT_RADIUS;
+        wp.command = MissionCommand::Waypoint;
+        return wp;
+    };
+
+    while (!xml.atEnd()) {
+        const QXmlStreamReader::TokenType t = xml.readNext();
+
+        if (t == QXmlStreamReader::StartElement) {
+            const QStringView name = xml.name();
+            if (name == u"Placemark") {
+                inPlacemark = true;
+                hasPoint = false;
+                cur = fresh();
+            } else if (!inPlacemark) {
+                continue;
+            } else if (name == u"Point") {
+                geom = PointGeom;
+            } else if (name == u"LineString") {
+                geom = LineGeom;
+            } else if (name == u"coordinates") {
+                const QString text = xml.readElementText();
+                if (geom == PointGeom) {
+                    forEachKmlTuple(text, [&](double lat, double lon, double alt) {
+                        if (hasPoint) return;
+                        cur.lat = lat;
+                        cur.lon = lon;
+                        cur.alt = float(alt);
+                        hasPoint = true;
+                    });
+                } else if (geom == LineGeom && line.isEmpty() && out.isEmpty()) {
+                    forEachKmlTuple(text, [&](double lat, double lon, double alt) {
+                        Waypoint wp = fresh();
+                        wp.lat = lat;
+                        wp.lon = lon;
+                        wp.alt = float(alt);
+                        line.push_back(wp);
+                    });
+                }
+            } else if (name == u"Data") {
+                const QStringView key = xml.attributes().value(u"name");
+                field = key == u"command" ? CommandField
+                      : key == u"radius"  ? RadiusField
+                                          : NoField;
+            } else if (name == u"value" && field != NoField) {
+                const QString text = xml.readElementText();
+                if (field == CommandField) {
+                    cur.command = Mission::commandFromName(QStringView(text).trimmed());
+                } else {
+                    bool ok = false;
+                    const float r = QStringView(text).trimmed().toFloat(&ok);
+                    if (ok && r > 0.0f) cur.radius = r;
+                }
+                field = NoField;
+            }
+        } else if (t == QXmlStreamReader::EndElement) {
+            const QStringView name = xml.name();
+            if (name == u"Placemark") {
+                if (hasPoint) out.push_back(cur);
+                inPlacemark = false;
+                geom = NoGeom;
+            } else if (name == u"Point" || name == u"LineString") {
+                geom = NoGeom;
+            }
+        }
+    }
+
+    if (xml.hasError()) {
+        setError(error, xmlError(xml));
+        return false;
+    }
+    if (out.isEmpty())
+        out.swap(line);
+    return true;
+}
+
+QByteArray writeKml(const QVector<Waypoint> &wps)
+{
+    QByteArray b;
+    b.reserve(wps.size() * 330 + 512);
+    b += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+         "<kml xmlns=\"http://www.opengis.net/kml/2.2\">\n"
+         "<Document>\n"
+         "<name>Kuzgun mission</name>\n";
+
+    for (int i = 0; i < wps.size(); ++i) {
+        const Waypoint &wp = wps[i];
+        b += "<Placemark><name>WP ";
+        b += QByteArray::number(i + 1);
+        b += "</name><ExtendedData><Data name=\"command\"><value>";
+        b += Mission::commandName(wp.command).toLatin1();
+        b += "</value></Data><Data name=\"radius\"><value>";
+        b += fmt(wp.radius, 2);
+        b += "</value></Data></ExtendedData><Point><altitudeMode>relativeToGround</altitudeMode><coordinates>";
+        b += fmt(wp.lon, 7); b += ',';
+        b += fmt(wp.lat, 7); b += ',';
+        b += fmt(wp.alt, 2);
+        b += "</coordinates></Point></Placemark>\n";
+    }
+
+    if (wps.size() >= 2) {
+        b += "<Placemark><name>Path</name><LineString><altitudeMode>relativeToGround</altitudeMode><coordinates>\n";
+        for (const Waypoint &wp : wps) {
+            b += fmt(wp.lon, 7); b += ',';
+            b += fmt(wp.lat, 7); b += ',';
+            b += fmt(wp.alt, 2); b += '\n';
+        }
+        b += "</coordinates></LineString></Placemark>\n";
+    }
+
+    b += "</Document>\n</kml>\n";
+    return b;
+}
+
+// ---------------------------------------------------------------- GPX
+
+static constexpr QLatin1String KUZGUN_GPX_NS("urn:kuzgun:gpx:1");
+
+bool parseGpx(QByteArrayView data, QVector<Waypoint> &out, QString *error, double homeAmsl)
+{
+    QXmlStreamReader xml(QByteArray::fromRawData(data.data(), data.size()));
+
+    // Öncelik: rota (rtept), sonra wpt, sonra iz (trkpt)
+    enum Kind { Route, Wpt, Track, KindCount, NoKind = KindCount };
+    QVector<Waypoint> lists[KindCount];
+    Kind in = NoKind;
+    Waypoint cur{};
+    double ele = NAN;       // AMSL
+    bool hasRelAlt = false;
+
+    while (!xml.atEnd()) {
+        const QXmlStreamReader::TokenType t = xml.readNext();
+
+        if (t == QXmlStreamReader::StartElement) {
+            const QStringView name = xml.name();
+            const Kind k = name == u"rtept" ? Route
+                         : name == u"wpt"   ? Wpt
+                         : name == u"trkpt" ? Track
+                                            : NoKind;
+            if (k != NoKind) {
+                const QXmlStreamAttributes attrs = xml.attributes();
+                bool okLat = false, okLon = false;
+                cur = Waypoint{};
+                cur.lat = attrs.value(u"lat").toDouble(&okLat);
+                cur.lon = attrs.value(u"lon").toDouble(&okLon);
+                cur.radius = DEFAULT_RADIUS;
+                cur.command = MissionCommand::Waypoint;
+                ele = NAN;
+                hasRelAlt = false;
+                in = (okLat && okLon) ? k : NoKind;
+            } else if (in == NoKind) {
+                continue;
+            } else if (name == u"ele") {
+                bool ok = false;
+                const double v = QStringView(xml.readElementText()).trimmed().toDouble(&ok);
+                if (ok) ele = v;
+            } else if (name == u"relAlt" && xml.namespaceUri() == KUZGUN_GPX_NS) {
+                bool ok = false;
+                const float v = QStringView(xml.readElementText()).trimmed().toFloat(&ok);
+                if (ok) {
+                    cur.alt = v;
+                    hasRelAlt = true;
+                }
+            } else if (name == u"type") {
+                bool ok = false;
+                const MissionCommand c = Mission::commandFromName(QStringView(xml.readElementText()).trimmed(), &ok);
+                if (ok) cur.command = c;
+            }
+        } else if (t == QXmlStreamReader::EndElement && in != NoKind) {
+            const QStringView name = xml.name();
+            if (name == u"rtept" || name == u"wpt" || name == u"trkpt") {
+                if (!hasRelAlt && !std::isnan(ele))
+                    cur.alt = float(std::isnan(homeAmsl) ? ele : ele - homeAmsl);
+                lists[in].push_back(cur);
+                in = NoKind;
+            }
+        }
+    }
+
+    if (xml.hasError()) {
+        setError(error, xmlError(xml));
+        return false;
+    }
+    for (QVector<Waypoint> &l : lists) {
+        if (!l.isEmpty()) {
+            out.swap(l);
+            break;
+        }
+    }
+    return true;
+}
+
+QByteArray writeGpx(const QVector<Waypoint> &wps, double homeAmsl)
+{
+    QByteArray b;
+    b.reserve(wps.size() * 190 + 320);
+    b += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+         "<gpx version=\"1.1\" creator=\"Kuzgun\" xmlns=\"http://www.topografix.com/GPX/1/1\"\n"
+         "     xmlns:kuzgun=\"";
+    b += KUZGUN_GPX_NS.data();
+    b += "\">\n"
+         "<rte>\n<name>Kuzgun mission</name>\n";
+
+    for (int i = 0; i < wps.size(); ++i) {
+        const Waypoint &wp = wps[i];
+        b += "<rtept lat=\"";
+        b += fmt(wp.lat, 7);
+        b += "\" lon=\"";
+        b += fmt(wp.lon, 7);
+        b += "\">";
+        if (!std::isnan(homeAmsl)) {
+            b += "<ele>";
+            b += fmt(wp.alt + homeAmsl, 2);
+            b += "</ele>";
+        }
+        b += "<name>WP ";
+        b += QByteArray::number(i + 1);
+        b += "</name><type>";
+        b += Mission::commandName(wp.command).toLatin1();
+        b += "</type><extensions><kuzgun:relAlt>";
+        b += fmt(wp.alt, 2);
+        b += "</kuzgun:relAlt></extensions></rtept>\n";
+    }
+
+    b += "</rte>\n</gpx>\n";
+    return b;
+}
+
+// ---------------------------------------------------------------- .plan
+
+QByteArray writePlan(const QVector<Waypoint> &wps)
+{
+    QByteArray b;
+    b.reserve(wps.size() * 300 + 1024);
+    b += "{\n"
+         "    \"fileType\": \"Plan\",\n"
+         "    \"geoFence\": {\n"
+         "        \"circles\": [],\n"
+         "        \"polygons\": [],\n"
+         "        \"version\": 2\n"
+         "    },\n"
+         "    \"groundStation\": \"Kuzgun\",\n"
+         "    \"mission\": {\n"
+         "        \"cruiseSpeed\": 15,\n"
+         "        \"firmwareType\": 12,\n"
+         "        \"hoverSpeed\": 5,\n"
+         "        \"items\": [\n";
+
+    for (int i = 0; i < wps.size(); ++i) {
+        const Waypoint &wp = wps[i];
+        const int mav = mavFromCommand(wp.command);
+        const QByteArray alt = fmt(wp.alt, 2);
+        const QByteArray radius = fmt(wp.radius, 2);
+
+        b += "            {\n"
+             "                \"AMSLAltAboveTerrain\": null,\n"
+             "                \"Altitude\": ";
+        b += alt;
+        b += ",\n"
+             "                \"AltitudeMode\": 1,\n"
+             "                \"autoContinue\": true,\n"
+             "                \"command\": ";
+        b += QByteArray::number(mav);
+        b += ",\n"
+             "                \"doJumpId\": ";
+        b += QByteArray::number(i + 1);
+        b += ",\n"
+             "                \"frame\": 3,\n"
+             "                \"params\": [0, ";
+        // param2 kabul yarıçapı (WAYPOINT), param3 loiter yarıçapı
+        b += mav == MAV_CMD_NAV_WAYPOINT ? radius : QByteArray("0");
+        b += ", ";
+        b += mav == MAV_CMD_NAV_LOITER_UNLIM ? radius : QByteArray("0");
+        b += ", null, ";
+        b += fmt(wp.lat, 7);
+        b += ", ";
+        b += fmt(wp.lon, 7);
+        b += ", ";
+        b += alt;
+        b += "],\n"
+             "                \"type\": \"SimpleItem\"\n"
+             "            }";
+        b += (i + 1 < wps.size()) ? ",\n" : "\n";
+    }
+
+    b += "        ],\n"
+         "        \"plannedHomePosition\": [";
+    if (!wps.isEmpty()) {
+        b += fmt(wps[0].lat, 7); b += ", ";
+        b += fmt(wps[0].lon, 7); b += ", 0";
+    } else {
+        b += "0, 0, 0";
+    }
+    b += "],\n"
+         "        \"vehicleType\": 1,\n"
+         "        \"version\": 2\n"
+         "    },\n"
+         "    \"rallyPoints\": {\n"
+         "        \"points\": [],\n"
+         "        \"version\": 2\n"
+         "    },\n"
+         "    \"version\": 1\n"
+         "}\n";
+    return b;
+}
+
+// ---------------------------------------------------------------- dosya
+
+Format formatForPath(const QString &path)
+{
+    const QString ext = QFileInfo(path).suffix().toLower();
+    if (ext == "plan") return Format::QgcPlan;
+    if (ext == "kml")  return Format::Kml;
+    if (ext == "gpx")  return Format::Gpx;
+    return Format::Unknown;
+}
+
+QString fileFilter()
+{
+    return "Mission files (*.plan *.kml *.gpx);;"
+           "QGroundControl plan (*.plan);;"
+           "KML (*.kml);;"
+           "GPX (*.gpx)";
+}
+
+bool load(const QString &path, QVector<Waypoint> &out, QString *error, double homeAmsl)
+{
+    const Format format = formatForPath(path);
+    if (format == Format::Unknown) {
+        setError(error, "Unknown mission file type: " + path);
+        return false;
+    }
+
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        setError(error, f.errorString());
+        return false;
+    }
+
+    // Eşlenemezse (ör. bazı ağ sürücüleri) bir kerede okunur
+    const qint64 size = f.size();
+    uchar *mapped = size > 0 ? f.map(0, size) : nullptr;
+    QByteArray buffer;
+    QByteArrayView data;
+    if (mapped) {
+        data = QByteArrayView(reinterpret_cast<const char *>(mapped), size);
+    } else {
+        buffer = f.readAll();
+        data = buffer;
+    }
+
+    QVector<Waypoint> wps;
+    wps.reserve(int(qMin<qint64>(size / 128, 1 << 20)));
+
+    bool ok = false;
+    switch (format) {
+    case Format::QgcPlan: ok = parsePlan(data, wps, error); break;
+    case Format::Kml:     ok = parseKml(data, wps, error);  break;
+    case Format::Gpx:     ok = parseGpx(data, wps, error, homeAmsl); break;
+    default: break;
+    }
+
+    if (mapped) f.unmap(mapped);
+    if (!ok) return false;
+
+    wps.squeeze();
+    out.swap(wps);
+    return true;
+}
+
+bool save(const QString &path, const QVector<Waypoint> &wps, QString *error, double homeAmsl)
+{
+    QByteArray bytes;
+    switch (formatForPath(path)) {
+    case Format::QgcPlan: bytes = writePlan(wps); break;
+    case Format::Kml:     bytes = writeKml(wps);  break;
+    case Format::Gpx:     bytes = writeGpx(wps, homeAmsl); break;
+    default:
+        setError(error, "Unknown mission file type: " + path);
+        return false;
+    }
+
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly) || f.write(bytes) != bytes.size() || !f.commit()) {
+        setError(error, f.errorString());
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,643 @@
+#include "missionmodel.h"
+#include "geodesy.h"
+
+#include <QColor>
+#include <QUndoStack>
+#include <QtMath>
+#include <cmath>
+#include <vector>
+
+static constexpr int UNDO_LIMIT = 500;
+
+// Web Mercator, [0,1) normalize; ekrandaki piksel mesafesiyle orantılı
+static void mercator(double lat, double lon, double &x, double &y)
+{
+    const double s = std::sin(qDegreesToRadians(qBound(-85.05112878, lat, 85.05112878)));
+    x = (lon + 180.0) / 360.0;
+    y = 0.5 - std::log((1.0 + s) / (1.0 - s)) / (4.0 * M_PI);
+}
+
+// Tek düzenleme: önceki/sonraki sürüm ve değişen satır. redo/undo modele
+// sadece farkı uygular; toplu (Reset) değişiklikte tablo yeniden kurulur.
+class MissionEditCommand : public QUndoCommand
+{
+public:
+    enum Kind {
+        SetRow,
+        InsertRow,
+        RemoveRow,
+        AppendRows,
+        Reset
+    };
+
+    MissionEditCommand(MissionModel *model, Kind kind, int row,
+                       const MissionModel::Version &before, const MissionModel::Version &after,
+                       const QString &text)
+        : QUndoCommand(text),
+        m_model(model), m_kind(kind), m_row(row), m_before(before), m_after(after)
+    {
+    }
+
+    void redo() override
+    {
+        switch (m_kind) {
+        case SetRow:     m_model->applySet(m_row, m_after.at(m_row));    break;
+        case InsertRow:  m_model->applyInsert(m_row, m_after.at(m_row)); break;
+        case RemoveRow:  m_model->applyRemove(m_row);                     break;
+        case AppendRows: m_model->applyAppend(m_after, m_before.size());  break;
+        case Reset:      m_model->applyReset(m_after);                    break;
+        }
+        m_model->m_version = m_after;
+    }
+
+    void undo() override
+    {
+        switch (m_kind) {
+        case SetRow:     m_model->applySet(m_row, m_before.at(m_row));    break;
+        case InsertRow:  m_model->applyRemove(m_row);                     break;
+        case RemoveRow:  m_model->applyInsert(m_row, m_before.at(m_row)); break;
+        case AppendRows: m_model->applyTruncate(m_before.size());         break;
+        case Reset:      m_model->applyReset(m_before);                   break;
+        }
+        m_model->m_version = m_before;
+    }
+
+private:
+    MissionModel *m_model;
+    Kind m_kind;
+    int m_row;
+    MissionModel::Version m_before;
+    MissionModel::Version m_after;
+};
+
+MissionModel::MissionModel(QObject *parent)
+    : QAbstractTableModel(parent),
+    m_undo(new QUndoStack(this))
+{
+    m_undo->setUndoLimit(UNDO_LIMIT);
+}
+
+QString MissionModel::formatDuration(double seconds)
+{
+    const int t = qMax(0, qRound(seconds));
+    const int h = t / 3600, m = (t / 60) % 60, sec = t % 60;
+    if (h > 0)
+        return QString("%1:%2:%3").arg(h).arg(m, 2, 10, QChar('0')).arg(sec, 2, 10, QChar('0'));
+    return QString("%1:%2").arg(m, 2, 10, QChar('0')).arg(sec, 2, 10, QChar('0'));
+}
+
+// Kalkışla başlayan görevde ilk bacak yerden ilk irtifaya tırmanıştır
+static inline bool startsFromGround(MissionCommand c)
+{
+    return c == MissionCommand::Takeoff || c == MissionCommand::VtolTakeoff;
+}
+
+LegMetrics MissionModel::computeLeg(int row) const
+{
+    if (row < 0 || row >= m_wps.size()) return LegMetrics();
+
+    const Waypoint &wp = m_wps[row];
+    if (row == 0) {
+        if (!startsFromGround(wp.command)) return LegMetrics();
+        return MissionGeometry::legFrom(0.0, 0.0, wp.alt, wp.command, m_vehicle);
+    }
+    const Waypoint &prev = m_wps[row - 1];
+    return MissionGeometry::legBetween(prev.lat, prev.lon, prev.alt,
+                                       wp.lat, wp.lon, wp.alt, wp.command, m_vehicle);
+}
+
+// Sadece bu bacak hesaplanır; kümülatif toplamlar O(log n) güncellenir
+void MissionModel::recomputeLeg(int row)
+{
+    if (row < 0 || row >= m_wps.size()) return;
+
+    const LegMetrics m = computeLeg(row);
+    storeDist(row, m.dist);
+    m_geo.setLeg(row, m);
+}
+
+// Liste Home ile paylaşılıyor olabilir (COW): değer aynıysa yazıp
+// kopyalanmasına sebep olma
+void MissionModel::storeDist(int row, double dist)
+{
+    if (m_wps.at(row).dist != float(dist))
+        m_wps[row].dist = float(dist);
+}
+
+// Tüm bacaklar: mesafe ve rotalar tek batch çağrısıyla (SoA) hesaplanır
+void MissionModel::rebuildGeometry()
+{
+    const int n = m_wps.size();
+    const Waypoint *w = m_wps.constData();
+    std::vector<double> lat(n), lon(n), dist(n, 0.0), course(n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        lat[i] = w[i].lat;
+        lon[i] = w[i].lon;
+    }
+    if (n > 1) {
+        Geodesy::haversineBatch(lat.data(), lon.data(), lat.data() + 1, lon.data() + 1,
+                                dist.data() + 1, n - 1);
+        // Rüzgar yoksa rota süreyi etkilemez
+        if (m_vehicle.windSpeed > 0.0)
+            Geodesy::bearingBatch(lat.data(), lon.data(), lat.data() + 1, lon.data() + 1,
+                                  course.data() + 1, n - 1);
+    }
+
+    QVector<LegMetrics> legs;
+    legs.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        LegMetrics m;
+        if (i > 0)
+            m = MissionGeometry::legFrom(dist[i], course[i], double(w[i].alt) - double(w[i - 1].alt),
+                                         w[i].command, m_vehicle);
+        else if (startsFromGround(w[0].command))
+            m = MissionGeometry::legFrom(0.0, 0.0, w[0].alt, w[0].command, m_vehicle);
+        storeDist(i, m.dist);
+        w = m_wps.constData();      // storeDist kopyalamış olabilir
+        legs.append(m);
+    }
+    m_geo.assign(legs);
+}
+
+void MissionModel::emitLegsChanged(int first)
+{
+    first = qMax(first, 0);
+    if (first < m_wps.size())
+        emit dataChanged(index(first, ColDist), index(m_wps.size() - 1, ColBattery),
+                         {Qt::DisplayRole, Qt::ForegroundRole});
+    emit totalsChanged();
+}
+
+void MissionModel::setVehicle(const VehicleProfile &vehicle)
+{
+    m_vehicle = vehicle;
+    rebuildGeometry();
+    emitLegsChanged(0);
+
+    // Minimum dönüş yarıçapı seyir hızına bağlı
+    MissionValidator::Rules rules = m_validator.rules();
+    rules.cruiseSpeed = vehicle.cruise;
+    setValidationRules(rules);
+}
+
+void MissionModel::setValidationRules(const MissionValidator::Rules &rules)
+{
+    m_validator.setRules(rules);
+    revalidateAll();
+}
+
+void MissionModel::setZones(const QVector<MissionValidator::Zone> &zones)
+{
+    m_validator.setZones(zones);
+    revalidateAll();
+}
+
+void MissionModel::revalidateAll()
+{
+    const int before = m_validator.offendingRows();
+    m_validator.validateAll(m_wps);
+    if (!m_wps.isEmpty())
+        emit dataChanged(index(0, 0), index(m_wps.size() - 1, ColumnCount - 1),
+                         {Qt::BackgroundRole, Qt::ToolTipRole});
+    if (before != 0 || m_validator.offendingRows() != 0)
+        emit validationChanged();
+}
+
+// notify: satır eklendi/silindi ve sorunlu bacak indeksleri kaymış olabilir
+void MissionModel::emitIssuesChanged(int first, int last, bool notify)
+{
+    if (first <= last)
+        emit dataChanged(index(first, 0), index(last, ColumnCount - 1), {Qt::BackgroundRole, Qt::ToolTipRole});
+    if (first <= last || notify)
+        emit validationChanged();
+}
+
+void MissionModel::setTerrain(const ElevationService::Profile &profile, double minClearance)
+{
+    if (profile.ground.size() != m_wps.size()) return;
+
+    m_terrain.resize(m_wps.size());
+    m_homeGround = profile.homeGround;
+    m_minClearance = minClearance;
+    m_terrainLowLegs = profile.lowLegs;
+    for (int i = 0; i < m_wps.size(); ++i) {
+        const bool known = profile.homeKnown && !std::isnan(profile.ground[i]);
+        m_terrain[i].ground = known ? profile.ground[i] : NAN;
+        m_terrain[i].legClearance = profile.homeKnown && i > 0 ? profile.legs[i].minClearance : NAN;
+    }
+    if (!m_wps.isEmpty())
+        emit dataChanged(index(0, ColGround), index(m_wps.size() - 1, ColAgl),
+                         {Qt::DisplayRole, Qt::ForegroundRole, Qt::ToolTipRole});
+}
+
+void MissionModel::clearTerrain()
+{
+    m_terrain.clear();
+    m_terrainLowLegs = 0;
+}
+
+void MissionModel::setWaypoints(const QVector<Waypoint> &wps)
+{
+    beginResetModel();
+    m_wps = wps;
+    clearTerrain();
+    rebuildGeometry();
+    reindex();
+    endResetModel();
+    m_version = Version::fromArray(m_wps.constData(), m_wps.size());
+    m_undo->clear();
+    revalidateAll();
+    emit totalsChanged();
+}
+
+void MissionModel::replaceAll(const QVector<Waypoint> &wps, const QString &text)
+{
+    const Version after = Version::fromArray(wps.constData(), wps.size());
+    m_undo->push(new MissionEditCommand(this, MissionEditCommand::Reset, 0, m_version, after, text));
+}
+
+void MissionModel::append(const Waypoint &wp)
+{
+    const int row = m_wps.size();
+    m_undo->push(new MissionEditCommand(this, MissionEditCommand::InsertRow, row,
+                                        m_version, m_version.append(wp),
+                                        QString("Add waypoint %1").arg(row + 1)));
+}
+
+void MissionModel::append(const QVector<Waypoint> &wps)
+{
+    if (wps.isEmpty()) return;
+
+    Version after = m_version;
+    for (const Waypoint &wp : wps)
+        after = after.append(wp);
+    m_undo->push(new MissionEditCommand(this, MissionEditCommand::AppendRows, m_wps.size(),
+                                        m_version, after,
+                                        QString("Add %1 waypoints").arg(wps.size())));
+}
+
+void MissionModel::removeAt(int row)
+{
+    if (row < 0 || row >= m_wps.size()) return;
+
+    m_undo->push(new MissionEditCommand(this, MissionEditCommand::RemoveRow, row,
+                                        m_version, m_version.erase(row),
+                                        QString("Remove waypoint %1").arg(row + 1)));
+}
+
+void MissionModel::clear()
+{
+    if (m_wps.isEmpty()) return;
+    m_undo->push(new MissionEditCommand(this, MissionEditCommand::Reset, 0,
+                                        m_version, Version(), "Clear mission"));
+}
+
+// ------------------------------------------------------------------ uygulama
+
+void MissionModel::applySet(int row, const Waypoint &wp)
+{
+    const Waypoint old = m_wps.at(row);
+    // Komut da bacağı değiştirir (VTOL geçişi, kalkış tırmanışı)
+    const bool moved = old.lat != wp.lat || old.lon != wp.lon || old.alt != wp.alt
+                    || old.command != wp.command;
+    const bool redraw = old.lat != wp.lat || old.lon != wp.lon || old.radius != wp.radius;
+
+    Waypoint &dst = m_wps[row];
+    dst = wp;
+    dst.dist = old.dist;            // mesafe sürümde tutulmaz, burada hesaplanır
+
+    emit dataChanged(index(row, 0), index(row, ColumnCount - 1), {Qt::DisplayRole, Qt::EditRole});
+
+    if (moved) {
+        // Bu noktaya giren ve çıkan bacaklar; sonrası sadece kümülatif kayar
+        recomputeLeg(row);
+        recomputeLeg(row + 1);
+        emitLegsChanged(row);
+    }
+    if (redraw) {
+        double x, y;
+        mercator(wp.lat, wp.lon, x, y);
+        m_index.set(row, x, y);
+        emit geometryChanged(row);
+    }
+
+    int first, last;
+    m_validator.rowChanged(m_wps, row, first, last);
+    emitIssuesChanged(first, last, false);
+}
+
+void MissionModel::applyInsert(int row, const Waypoint &wp)
+{
+    beginInsertRows(QModelIndex(), row, row);
+    if (m_terrain.size() == m_wps.size())
+        m_terrain.insert(row, TerrainRow{NAN, NAN});
+    m_wps.insert(row, wp);
+    const LegMetrics m = computeLeg(row);
+    storeDist(row, m.dist);
+    m_geo.insert(row, m);
+    double x, y;
+    mercator(wp.lat, wp.lon, x, y);
+    m_index.insert(row, x, y);
+    endInsertRows();
+
+    // Araya eklendiyse sonraki noktaya giren bacak da değişir
+    recomputeLeg(row + 1);
+    emitLegsChanged(row);
+
+    int first, last;
+    m_validator.rowInserted(m_wps, row, first, last);
+    emitIssuesChanged(first, last, m_validator.offendingRows() != 0);
+}
+
+void MissionModel::applyRemove(int row)
+{
+    beginRemoveRows(QModelIndex(), row, row);
+    if (m_terrain.size() == m_wps.size())
+        m_terrain.removeAt(row);
+    m_wps.removeAt(row);
+    m_geo.remove(row);
+    m_index.remove(row);
+    if (m_wps.isEmpty()) clearTerrain();
+    endRemoveRows();
+
+    // Sadece silinen noktanın yerine gelen bacak değişir
+    recomputeLeg(row);
+    emitLegsChanged(row);
+
+    const bool hadIssues = m_validator.offendingRows() != 0;
+    int first, last;
+    m_validator.rowRemoved(m_wps, row, first, last);
+    emitIssuesChanged(first, last, hadIssues);
+}
+
+void MissionModel::applyAppend(const Version &v, int first)
+{
+    const int last = v.size() - 1;
+    if (last < first) return;
+
+    beginInsertRows(QModelIndex(), first, last);
+    if (m_terrain.size() == m_wps.size())
+        m_terrain.resize(v.size(), TerrainRow{NAN, NAN});
+    m_wps.reserve(v.size());
+    for (int i = first; i <= last; ++i) {
+        m_wps.append(v.at(i));
+        const LegMetrics m = computeLeg(i);
+        storeDist(i, m.dist);
+        m_geo.append(m);
+        double x, y;
+        mercator(m_wps[i].lat, m_wps[i].lon, x, y);
+        m_index.insert(i, x, y);
+    }
+    endInsertRows();
+    revalidateAll();
+    emit totalsChanged();
+}
+
+void MissionModel::applyTruncate(int size)
+{
+    const int last = m_wps.size() - 1;
+    if (last < size) return;
+
+    beginRemoveRows(QModelIndex(), size, last);
+    if (m_terrain.size() == m_wps.size())
+        m_terrain.resize(size);
+    m_wps.resize(size);
+    for (int i = last; i >= size; --i)
+        m_geo.remove(i);            // sondan silme O(1)
+    m_index.truncate(size);
+    if (m_wps.isEmpty()) clearTerrain();
+    endRemoveRows();
+    revalidateAll();
+    emit totalsChanged();
+}
+
+void MissionModel::applyReset(const Version &v)
+{
+    QVector<Waypoint> wps(v.size());
+    v.copyTo(wps.data());
+
+    beginResetModel();
+    m_wps = wps;
+    clearTerrain();
+    rebuildGeometry();
+    reindex();
+    endResetModel();
+    revalidateAll();
+    emit totalsChanged();
+}
+
+void MissionModel::reindex()
+{
+    std::vector<double> x(m_wps.size()), y(m_wps.size());
+    for (int i = 0; i < m_wps.size(); ++i)
+        mercator(m_wps[i].lat, m_wps[i].lon, x[i], y[i]);
+    m_index.assign(x, y);
+}
+
+int MissionModel::rowAt(double lat, double lon, double zoom, double tolPx) const
+{
+    double x, y;
+    mercator(lat, lon, x, y);
+    return m_index.nearest(x, y, tolPx / (256.0 * std::pow(2.0, zoom)));
+}
+
+// ------------------------------------------------------------------ sürükleme
+
+void MissionModel::beginMove(int row)
+{
+    m_moveRow = row >= 0 && row < m_wps.size() ? row : -1;
+}
+
+void MissionModel::moveTo(double lat, double lon)
+{
+    if (m_moveRow < 0 || m_moveRow >= m_wps.size()) return;
+
+    Waypoint wp = m_wps.at(m_moveRow);
+    wp.lat = qBound(-90.0, lat, 90.0);
+    wp.lon = qBound(-180.0, lon, 180.0);
+    applySet(m_moveRow, wp);        // m_version hâlâ sürükleme öncesi
+}
+
+void MissionModel::endMove()
+{
+    const int row = m_moveRow;
+    m_moveRow = -1;
+    if (row < 0 || row >= m_wps.size() || row >= m_version.size()) return;
+
+    const Waypoint &now = m_wps.at(row);
+    const Waypoint was = m_version.at(row);
+    if (now.lat == was.lat && now.lon == was.lon) return;
+
+    m_undo->push(new MissionEditCommand(this, MissionEditCommand::SetRow, row,
+                                        m_version, m_version.set(row, now),
+                                        QString("Move waypoint %1").arg(row + 1)));
+}
+
+double MissionModel::batteryRemaining(int row) const
+{
+    if (m_vehicle.batteryWh <= 0.0) return 0.0;
+    return 100.0 * (1.0 - m_geo.prefix(row).energy / m_vehicle.batteryWh);
+}
+
+int MissionModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_wps.size();
+}
+
+int MissionModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant MissionModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_wps.size()) return {};
+
+    const Waypoint &wp = m_wps.at(index.row());
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+        case ColStatus: return Mission::commandName(wp.command);
+        case ColLat:    return QString::number(wp.lat,    'f', 7);
+        case ColLon:    return QString::number(wp.lon,    'f', 7);
+        case ColAlt:    return QString::number(wp.alt,    'f', 1);
+        case ColGround:
+            if (!hasTerrain(index.row()) || std::isnan(m_terrain[index.row()].ground)) return QStringLiteral("-");
+            return QString::number(m_terrain[index.row()].ground, 'f', 0);
+        case ColAgl:
+            if (!hasTerrain(index.row()) || std::isnan(m_terrain[index.row()].ground)) return QStringLiteral("-");
+            return QString::number(m_homeGround + wp.alt - m_terrain[index.row()].ground, 'f', 0);
+        case ColDist:   return QString::number(wp.dist,   'f', 1);
+        case ColTotal:  return QString::number(m_geo.prefix(index.row()).dist, 'f', 1);
+        case ColEta:    return formatDuration(m_geo.prefix(index.row()).time);
+        case ColBattery: return QString::number(batteryRemaining(index.row()), 'f', 0);
+        case ColRadius: return QString::number(wp.radius, 'f', 1);
+        case ColRemove: return QStringLiteral("X");
+        }
+    } else if (role == Qt::EditRole) {
+        switch (index.column()) {
+        case ColStatus: return Mission::commandName(wp.command);
+        case ColLat:    return wp.lat;
+        case ColLon:    return wp.lon;
+        case ColAlt:    return wp.alt;
+        case ColRadius: return wp.radius;
+        }
+    } else if (role == Qt::BackgroundRole) {
+        if (m_validator.issues(index.row()) != MissionValidator::NoIssue)
+            return QColor("#5a1e1e");
+    } else if (role == Qt::ForegroundRole && index.column() == ColBattery) {
+        if (batteryRemaining(index.row()) < m_vehicle.reservePct)
+            return QColor("#ff5050");
+    } else if (role == Qt::ForegroundRole && index.column() == ColAgl) {
+        // lowClearanceLegs ile aynı kural: kalkış/iniş bacakları sayılmaz
+        const int row = index.row();
+        if (row > 0 && hasTerrain(row) && m_terrain[row].legClearance < m_minClearance   // NaN: false
+            && !ElevationService::isGroundLeg(m_wps[row - 1].command, wp.command))
+            return QColor("#ff9f1a");
+    } else if (role == Qt::ToolTipRole) {
+        QString tip = MissionValidator::describe(m_validator.issues(index.row()));
+        if (index.column() == ColAgl && hasTerrain(index.row())
+            && !std::isnan(m_terrain[index.row()].legClearance)) {
+            if (!tip.isEmpty()) tip += "; ";
+            tip += QString("lowest clearance on incoming leg %1 m (minimum %2 m)")
+                       .arg(m_terrain[index.row()].legClearance, 0, 'f', 0)
+                       .arg(m_minClearance, 0, 'f', 0);
+        }
+        if (!tip.isEmpty())
+            return tip;
+    } else if (role == Qt::TextAlignmentRole && index.column() == ColRemove) {
+        return int(Qt::AlignCenter);
+    }
+    return {};
+}
+
+bool MissionModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    if (role != Qt::EditRole || !index.isValid() || index.row() >= m_wps.size())
+        return false;
+
+    const int row = index.row();
+
+    Waypoint wp = m_wps.at(row);
+
+    if (index.column() == ColStatus) {
+        bool ok = false;
+        const MissionCommand cmd = Mission::commandFromName(value.toString(), &ok);
+        if (!ok) return false;
+        wp.command = cmd;
+    } else {
+        QString text = value.toString().trimmed();
+        text.replace(',', '.');
+        bool ok = false;
+        double v = text.toDouble(&ok);
+        if (!ok) return false;
+
+        switch (index.column()) {
+        case ColLat:
+            wp.lat = qBound(-90.0, v, 90.0);
+            break;
+        case ColLon:
+            wp.lon = qBound(-180.0, v, 180.0);
+            break;
+        case ColAlt:
+            wp.alt = float(v);
+            break;
+        case ColRadius:
+            wp.radius = float(qBound(1.0, v, 5000.0));     // Limit
+            break;
+        default:
+            return false;
+        }
+    }
+
+    const Waypoint &old = m_wps.at(row);
+    if (wp.lat == old.lat && wp.lon == old.lon && wp.alt == old.alt
+        && wp.radius == old.radius && wp.command == old.command)
+        return true;
+
+    m_undo->push(new MissionEditCommand(this, MissionEditCommand::SetRow, row,
+                                        m_version, m_version.set(row, wp),
+                                        QString("Edit waypoint %1").arg(row + 1)));
+    return true;
+}
+
+QVariant MissionModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole) return {};
+    if (orientation == Qt::Vertical) return section + 1;
+
+    switch (section) {
+    case ColStatus: return QStringLiteral("Status");
+    case ColLat:    return QStringLiteral("Latitude");
+    case ColLon:    return QStringLiteral("Longitude");
+    case ColAlt:    return QStringLiteral("Altitude(m)");
+    case ColGround: return QStringLiteral("Ground(m)");
+    case ColAgl:    return QStringLiteral("AGL(m)");
+    case ColDist:   return QStringLiteral("Distance(m)");
+    case ColTotal:  return QStringLiteral("Total(m)");
+    case ColEta:    return QStringLiteral("ETA");
+    case ColBattery: return QStringLiteral("Battery(%)");
+    case ColRadius: return QStringLiteral("Radius(m)");
+    case ColRemove: return QStringLiteral("Remove");
+    }
+    return {};
+}
+
+Qt::ItemFlags MissionModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid()) return Qt::NoItemFlags;
+
+    Qt::ItemFlags f = Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+    switch (index.column()) {
+    case ColStatus:
+    case ColLat:
+    case ColLon:
+    case ColAlt:
+    case ColRadius:
+        f |= Qt::ItemIsEditable;
+        break;
+    default:
+        break;
+    }
+    return f;
+}
@@ -0,0 +1,99 @@
+#include "missiontracker.h"
+
+#include <QtMath>
+#include <cmath>
+
+static constexpr double MIN_ACCEPT_M = 2.0;         // radius 0 olan noktalar için
+static constexpr double MIN_SPEED = 0.5;            // m/s; altında ETA yok
+
+void MissionTracker::setMission(const QVector<Waypoint> &wps)
+{
+    m_wps = wps;
+
+    m_end = 0;
+    while (m_end < m_wps.size() && m_wps[m_end].command != MissionCommand::Rtl)
+        ++m_end;
+
+    if (!m_hasFrame && !m_wps.isEmpty())
+        m_frame = EnuFrame(m_wps[0].lat, m_wps[0].lon);
+    project();
+    reset();
+}
+
+void MissionTracker::setFrame(const EnuFrame &frame)
+{
+    m_frame = frame;
+    m_hasFrame = true;
+    project();
+}
+
+void MissionTracker::project()
+{
+    m_x.resize(m_end);
+    m_y.resize(m_end);
+    for (int i = 0; i < m_end; ++i)
+        m_frame.toLocal(m_wps[i].lat, m_wps[i].lon, m_x[i], m_y[i]);
+
+    m_remaining.fill(0.0, m_end);
+    for (int i = m_end - 2; i >= 0; --i)
+        m_remaining[i] = m_remaining[i + 1] + std::hypot(m_x[i + 1] - m_x[i], m_y[i + 1] - m_y[i]);
+}
+
+void MissionTracker::reset()
+{
+    m_state = State();
+    m_state.target = m_end > 0 ? 0 : -1;
+}
+
+// Hedefe giden bacağa göre konum; varıldıysa true
+bool MissionTracker::arrived(int target, double x, double y, double &toTarget,
+                             double &along, double &cross) const
+{
+    const double bx = m_x[target], by = m_y[target];
+    toTarget = std::hypot(bx - x, by - y);
+    along = cross = 0.0;
+    if (toTarget <= qMax(double(m_wps[target].radius), MIN_ACCEPT_M))
+        return true;
+    if (target == 0)
+        return false;
+
+    // A -> B bacağına izdüşüm; çapraz hata rotanın sağında pozitif
+    const double ax = m_x[target - 1], ay = m_y[target - 1];
+    const double legLength = m_remaining[target - 1] - m_remaining[target];
+    if (legLength < 1e-6)
+        return true;                        // A ile aynı nokta
+    const double ux = (bx - ax) / legLength, uy = (by - ay) / legLength;
+    const double px = x - ax, py = y - ay;
+    along = px * ux + py * uy;
+    cross = px * uy - py * ux;
+    return along >= legLength;              // hedefin hizası geçildi
+}
+
+const MissionTracker::State &MissionTracker::update(double lat, double lon, double speed)
+{
+    State &s = m_state;
+    if (m_end == 0 || s.finished) return s;
+    s.valid = true;
+
+    double x, y;
+    m_frame.toLocal(lat, lon, x, y);
+
+    double toTarget, along, cross;
+    while (arrived(s.target, x, y, toTarget, along, cross)) {
+        ++s.reached;
+        if (++s.target >= m_end) {
+            s.finished = true;
+            s.target = m_end - 1;
+            s.crossTrack = s.alongTrack = s.toTarget = s.toGo = 0.0;
+            s.eta = 0.0;
+            return s;
+        }
+    }
+
+    s.crossTrack = cross;
+    s.alongTrack = along;
+    s.toTarget = toTarget;
+    s.toGo = toTarget + m_remaining[s.target];
+    s.eta = speed >= MIN_SPEED ? s.toGo / speed : -1.0;
+    return s;
+}
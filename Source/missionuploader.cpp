@@ -0,0 +1,418 @@
+#include "missionuploader.h"
+#include "SerialManager.h"
+
+#include <QDebug>
+#include <QTimer>
+#include <QtMath>
+
+static constexpr int TICK_MS = 20;
+static constexpr int CONTROL_TIMEOUT_MS = 1200;     // MU_BEGIN / MU_END cevabı
+static constexpr int HANDSHAKE_TRIES = 3;           // sonra eski protokol
+static constexpr int RESUME_TRIES = 15;             // resume'da eski protokole düşme
+static constexpr int MAX_ITEM_RETRIES = 12;
+static constexpr qint64 MIN_RTO_MS = 150;
+static constexpr qint64 MAX_RTO_MS = 5000;
+static constexpr int PROGRESS_INTERVAL_MS = 100;
+
+MissionUploader::MissionUploader(SerialManager *serial, QObject *parent)
+    : QObject(parent),
+    m_serial(serial),
+    m_tick(new QTimer(this))
+{
+    m_tick->setInterval(TICK_MS);
+    connect(m_tick, &QTimer::timeout, this, &MissionUploader::onTick);
+    connect(m_serial, &SerialManager::messageReceived, this, &MissionUploader::onLine);
+    connect(m_serial, &SerialManager::disconnected, this, &MissionUploader::onDisconnected);
+    connect(m_serial, &SerialManager::connected, this, &MissionUploader::onConnected);
+    m_clock.start();
+}
+
+// ------------------------------------------------------------------ kodlama
+
+QByteArray MissionUploader::itemPayload(int seq, const Waypoint &wp)
+{
+    return QString("%1,%2,%3,%4,%5,%6,%7")
+        .arg(seq)
+        .arg(wp.lat,    0, 'f', 7)
+        .arg(wp.lon,    0, 'f', 7)
+        .arg(wp.alt,    0, 'f', 2)
+        .arg(wp.dist,   0, 'f', 2)
+        .arg(wp.radius, 0, 'f', 2)
+        .arg(Mission::commandName(wp.command))
+        .toLatin1();
+}
+
+quint32 MissionUploader::crc32(const QByteArray &data, quint32 crc)
+{
+    static quint32 table[256];
+    static bool init = false;
+    if (!init) {
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            table[i] = c;
+        }
+        init = true;
+    }
+
+    crc = ~crc;
+    for (char ch : data)
+        crc = table[(crc ^ quint8(ch)) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// ------------------------------------------------------------------ durum
+
+void MissionUploader::start(const QVector<Waypoint> &wps)
+{
+    if (isBusy()) return;
+
+    m_wps = wps;
+    const int n = wps.size();
+    m_lines.resize(n);
+    m_item.fill(Pending, n);
+    m_sentAt.fill(0, n);
+    m_retries.fill(0, n);
+
+    m_crc = 0;
+    for (int i = 0; i < n; ++i) {
+        const QByteArray payload = itemPayload(i, wps[i]);
+        m_crc = crc32(payload, m_crc);
+        const quint16 c = qChecksum(QByteArrayView(payload));
+        m_lines[i] = "MU," + payload + ',' + QByteArray::number(c, 16).rightJustified(4, '0') + '\n';
+    }
+
+    m_inFlight = 0;
+    m_cursor = 0;
+    m_ackedCount = 0;
+    m_protocolConfirmed = false;
+    m_crcRestarts = 0;
+    m_srtt = m_rttVar = 0.0;
+
+    qDebug() << "[UPLOAD] start n =" << n << "crc32 =" << QString::number(m_crc, 16)
+             << "window =" << m_window;
+
+    m_attempts = 0;
+    m_vehicleHeard = false;
+    m_state = Handshake;
+    m_ackedBytes = 0;
+    m_startedAt = m_clock.elapsed();
+    sendBegin();
+    m_tick->start();
+}
+
+void MissionUploader::resume()
+{
+    if (m_state != Paused) return;
+    if (!m_serial->isConnected()) return;
+
+    // Yoldaki her şey kayıp sayılır; araç elindekini MU_READY ile söyler
+    for (int i = 0; i < m_item.size(); ++i)
+        if (m_item[i] == InFlight) m_item[i] = Pending;
+    m_inFlight = 0;
+    m_cursor = 0;
+
+    qDebug() << "[UPLOAD] resume at" << m_ackedCount << "/" << total();
+
+    m_attempts = 0;
+    m_vehicleHeard = false;
+    m_state = Handshake;
+    m_ackedBytes = 0;
+    m_startedAt = m_clock.elapsed();
+    sendBegin();
+    m_tick->start();
+}
+
+void MissionUploader::cancel()
+{
+    if (m_state == Idle || m_state == Done || m_state == Unverified || m_state == Failed) return;
+    finish(Failed, "cancelled");
+}
+
+void MissionUploader::finish(State result, const QString &message)
+{
+    m_tick->stop();
+    m_state = result;
+    reportProgress();
+
+    const double secs = (m_clock.elapsed() - m_startedAt) / 1000.0;
+    qDebug().noquote() << QString("[UPLOAD] %1: %2  (%3 items, %4 s, %5 B/s, line %6 B/s)")
+                              .arg(QLatin1String(result == Done ? "OK" : result == Unverified ? "UNVERIFIED" : "FAIL"), message)
+                              .arg(total())
+                              .arg(secs, 0, 'f', 2)
+                              .arg(goodputBytesPerSec(), 0, 'f', 0)
+                              .arg(lineRateBytesPerSec(), 0, 'f', 0);
+    emit finished(result, message);
+}
+
+double MissionUploader::goodputBytesPerSec() const
+{
+    const qint64 ms = m_clock.elapsed() - m_startedAt;
+    return ms > 0 ? m_ackedBytes * 1000.0 / ms : 0.0;
+}
+
+double MissionUploader::lineRateBytesPerSec() const
+{
+    return m_serial->baudRate() / 10.0;
+}
+
+void MissionUploader::reportProgress()
+{
+    const double bps = goodputBytesPerSec();
+    const double line = lineRateBytesPerSec();
+    emit progress(m_ackedCount, total(), bps, line > 0 ? 100.0 * bps / line : 0.0);
+    m_lastProgressAt = m_clock.elapsed();
+}
+
+// ------------------------------------------------------------------ gönderim
+
+bool MissionUploader::write(const QByteArray &data)
+{
+    return m_serial->write(data);
+}
+
+void MissionUploader::sendBegin()
+{
+    write(QString("MU_BEGIN,%1,%2,%3\n")
+              .arg(total())
+              .arg(m_crc, 8, 16, QChar('0'))
+              .arg(m_window)
+              .toLatin1());
+    m_lastControlAt = m_clock.elapsed();
+    ++m_attempts;
+}
+
+void MissionUploader::sendItem(int seq)
+{
+    if (m_item[seq] != InFlight) {
+        m_item[seq] = InFlight;
+        ++m_inFlight;
+    }
+    m_sentAt[seq] = m_clock.elapsed();
+    write(m_lines[seq]);
+}
+
+void MissionUploader::fillWindow()
+{
+    const int n = total();
+    while (m_inFlight < m_window) {
+        while (m_cursor < n && m_item[m_cursor] != Pending) ++m_cursor;
+        if (m_cursor >= n) break;
+        sendItem(m_cursor++);
+    }
+
+    if (m_ackedCount == n && m_state == Sending) {
+        m_state = Finishing;
+        m_attempts = 1;
+        write(QString("MU_END,%1\n").arg(m_crc, 8, 16, QChar('0')).toLatin1());
+        m_lastControlAt = m_clock.elapsed();
+    }
+}
+
+qint64 MissionUploader::rto() const
+{
+    if (m_srtt <= 0.0) {
+        // Henüz ölçüm yok: pencere kadar satırın hatta geçme süresi + pay
+        const double line = qMax(1.0, lineRateBytesPerSec());
+        const double bytes = m_lines.isEmpty() ? 64.0 : m_lines[0].size();
+        return qBound(MIN_RTO_MS, qint64(m_window * bytes / line * 1000.0 * 2.0) + 300, MAX_RTO_MS);
+    }
+    return qBound(MIN_RTO_MS, qint64(m_srtt + 4.0 * m_rttVar), MAX_RTO_MS);
+}
+
+void MissionUploader::onAck(int seq)
+{
+    if (seq < 0 || seq >= total() || m_item[seq] == Acked) return;
+
+    if (m_item[seq] == InFlight) {
+        --m_inFlight;
+        // Karn: yeniden gönderilmiş öğeden RTT ölçülmez
+        if (m_retries[seq] == 0) {
+            const double rtt = m_clock.elapsed() - m_sentAt[seq];
+            if (m_srtt <= 0.0) {
+                m_srtt = rtt;
+                m_rttVar = rtt / 2.0;
+            } else {
+                m_rttVar = 0.75 * m_rttVar + 0.25 * qAbs(m_srtt - rtt);
+                m_srtt = 0.875 * m_srtt + 0.125 * rtt;
+            }
+        }
+    }
+    m_item[seq] = Acked;
+    ++m_ackedCount;
+    m_ackedBytes += m_lines[seq].size();
+}
+
+// ------------------------------------------------------------------ alım
+
+void MissionUploader::onLine(const QString &, const QString &line)
+{
+    // Telemetri vb. her satır aracın canlı olduğunu gösterir (eski protokole düşme şartı)
+    if (m_state == Handshake) m_vehicleHeard = true;
+    if (!line.startsWith("MU_")) return;
+    if (m_state == Idle || m_state == Done || m_state == Unverified || m_state == Failed) return;
+
+    const QStringList p = line.split(',');
+    const QString &cmd = p[0];
+
+    if (cmd == "MU_READY" && m_state == Handshake) {
+        const int n = p.value(1).toInt();
+        const int have = qBound(0, p.value(2).toInt(), total());
+        if (n != total()) {
+            qDebug() << "[UPLOAD] MU_READY count mismatch" << n << total();
+            return;
+        }
+        m_protocolConfirmed = true;
+
+        // Aracın zaten aldığı öğeler (resume)
+        for (int i = 0; i < have; ++i)
+            if (m_item[i] != Acked) {
+                m_item[i] = Acked;
+                ++m_ackedCount;
+            }
+        m_state = Sending;
+        fillWindow();
+        reportProgress();
+        return;
+    }
+
+    if (cmd == "MU_ACK" && m_state == Sending) {
+        onAck(p.value(1).toInt());
+        fillWindow();
+        if (m_clock.elapsed() - m_lastProgressAt >= PROGRESS_INTERVAL_MS)
+            reportProgress();
+        return;
+    }
+
+    if (cmd == "MU_NAK" && m_state == Sending) {
+        // CRC tutmadı ya da sıra atlandı: sadece bu öğe tekrar
+        bool ok = false;
+        const int seq = p.value(1).toInt(&ok);
+        if (!ok || seq < 0 || seq >= total() || m_item[seq] == Acked) return;
+        if (++m_retries[seq] > MAX_ITEM_RETRIES) {
+            finish(Failed, QString("item %1 rejected too many times").arg(seq));
+            return;
+        }
+        sendItem(seq);
+        return;
+    }
+
+    if (cmd == "MU_DONE" && m_state == Finishing) {
+        finish(Done, "mission verified");
+        return;
+    }
+
+    if (cmd == "MU_FAIL" && (m_state == Finishing || m_state == Sending)) {
+        // Görev CRC'si tutmadı: bir kez baştan dene
+        qDebug() << "[UPLOAD] vehicle reported" << line;
+        if (m_crcRestarts++ >= 1) {
+            finish(Failed, p.value(1, "vehicle rejected mission"));
+            return;
+        }
+        m_item.fill(Pending);
+        m_retries.fill(0);
+        m_inFlight = 0;
+        m_cursor = 0;
+        m_ackedCount = 0;
+        m_state = Handshake;
+        m_attempts = 0;
+        write(QByteArray("MU_ABORT\n"));
+        sendBegin();
+        return;
+    }
+}
+
+void MissionUploader::onTick()
+{
+    const qint64 now = m_clock.elapsed();
+
+    switch (m_state) {
+    case Handshake:
+        if (now - m_lastControlAt < CONTROL_TIMEOUT_MS) break;
+        if (!m_protocolConfirmed && m_vehicleHeard && m_attempts >= HANDSHAKE_TRIES && m_ackedCount == 0) {
+            sendLegacy();
+            break;
+        }
+        if (m_attempts >= RESUME_TRIES) {
+            // Bağlantı var ama araç susuyor: kesin hata, otomatik resume yok
+            finish(Failed, QString("no answer from vehicle at %1 / %2").arg(m_ackedCount).arg(total()));
+            break;
+        }
+        sendBegin();
+        break;
+
+    case Sending: {
+        // Zaman aşımına uğrayan öğeleri tekrar gönder
+        const qint64 timeout = rto();
+        for (int i = 0; i < total(); ++i) {
+            if (m_item[i] != InFlight || now - m_sentAt[i] < timeout) continue;
+            if (++m_retries[i] > MAX_ITEM_RETRIES) {
+                finish(Failed, QString("item %1 not acknowledged").arg(i));
+                return;
+            }
+            sendItem(i);
+        }
+        if (now - m_lastProgressAt >= PROGRESS_INTERVAL_MS)
+            reportProgress();
+        break;
+    }
+
+    case Finishing:
+        if (now - m_lastControlAt < CONTROL_TIMEOUT_MS) break;
+        if (m_attempts++ >= HANDSHAKE_TRIES) {
+            finish(Failed, "MU_END not confirmed");
+            break;
+        }
+        write(QString("MU_END,%1\n").arg(m_crc, 8, 16, QChar('0')).toLatin1());
+        m_lastControlAt = now;
+        break;
+
+    default:
+        break;
+    }
+}
+
+void MissionUploader::onDisconnected()
+{
+    if (!isBusy()) return;
+    m_tick->stop();
+    m_state = Paused;
+    qDebug() << "[UPLOAD] link lost, paused at" << m_ackedCount << "/" << total();
+    emit paused(m_ackedCount, total());
+}
+
+// Sadece bağlantı kopmasıyla duraklayan yükleme sürer; finished henüz gelmedi
+void MissionUploader::onConnected()
+{
+    if (m_state == Paused)
+        QTimer::singleShot(CONTROL_TIMEOUT_MS, this, &MissionUploader::resume);
+}
+
+// ------------------------------------------------------------------ eski protokol
+
+// MU_* bilmeyen araçlar: onaysız WP_BEGIN / WP / WP_END
+void MissionUploader::sendLegacy()
+{
+    qDebug() << "[UPLOAD] vehicle talks but no MU_READY, falling back to WP_BEGIN/WP/WP_END";
+
+    QByteArray out;
+    out.reserve(m_wps.size() * 72 + 32);
+    out += "WP_BEGIN," + QByteArray::number(m_wps.size()) + '\n';
+    for (const Waypoint &wp : std::as_const(m_wps)) {
+        out += QString("WP,%1,%2,%3,%4,%5,\"%6\"\n")
+                   .arg(wp.lat,    0, 'f', 7)
+                   .arg(wp.lon,    0, 'f', 7)
+                   .arg(wp.alt,    0, 'f', 2)
+                   .arg(wp.dist,   0, 'f', 2)
+                   .arg(wp.radius, 0, 'f', 2)
+                   .arg(Mission::commandName(wp.command))
+                   .toLatin1();
+    }
+    out += "WP_END\n";
+
+    write(out);
+    m_ackedCount = total();
+    m_ackedBytes = out.size();
+    finish(Unverified, "sent with legacy protocol, vehicle did not confirm");
+}
@@ -0,0 +1,327 @@
+#include "missionvalidator.h"
+#include "geodesy.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+
+#include <cmath>
+
+static constexpr double GRAVITY = 9.80665;
+
+// ---------------------------------------------------------------- geometri
+
+// x = boylam, y = enlem
+static inline double cross(double ax, double ay, double bx, double by, double cx, double cy)
+{
+    return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+static inline bool onSegment(double ax, double ay, double bx, double by, double px, double py)
+{
+    return std::min(ax, bx) <= px && px <= std::max(ax, bx)
+        && std::min(ay, by) <= py && py <= std::max(ay, by);
+}
+
+static bool segmentsIntersect(const GeoPoint &a, const GeoPoint &b, const GeoPoint &c, const GeoPoint &d)
+{
+    const double d1 = cross(c.lon, c.lat, d.lon, d.lat, a.lon, a.lat);
+    const double d2 = cross(c.lon, c.lat, d.lon, d.lat, b.lon, b.lat);
+    const double d3 = cross(a.lon, a.lat, b.lon, b.lat, c.lon, c.lat);
+    const double d4 = cross(a.lon, a.lat, b.lon, b.lat, d.lon, d.lat);
+
+    if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0)))
+        return true;
+
+    // Değme / doğrudaşlık
+    return (d1 == 0 && onSegment(c.lon, c.lat, d.lon, d.lat, a.lon, a.lat))
+        || (d2 == 0 && onSegment(c.lon, c.lat, d.lon, d.lat, b.lon, b.lat))
+        || (d3 == 0 && onSegment(a.lon, a.lat, b.lon, b.lat, c.lon, c.lat))
+        || (d4 == 0 && onSegment(a.lon, a.lat, b.lon, b.lat, d.lon, d.lat));
+}
+
+// Işın atma (çift-tek kuralı)
+static bool pointInRing(const GeoPoint &p, const QVector<GeoPoint> &ring)
+{
+    bool inside = false;
+    const int n = ring.size();
+    for (int i = 0, j = n - 1; i < n; j = i++) {
+        const GeoPoint &a = ring[i];
+        const GeoPoint &b = ring[j];
+        if ((a.lat > p.lat) != (b.lat > p.lat)) {
+            const double x = a.lon + (p.lat - a.lat) * (b.lon - a.lon) / (b.lat - a.lat);
+            if (p.lon < x) inside = !inside;
+        }
+    }
+    return inside;
+}
+
+static bool segmentCrossesRing(const GeoPoint &a, const GeoPoint &b, const QVector<GeoPoint> &ring)
+{
+    const RBox seg{std::min(a.lon, b.lon), std::min(a.lat, b.lat),
+                   std::max(a.lon, b.lon), std::max(a.lat, b.lat)};
+    const int n = ring.size();
+    for (int i = 0, j = n - 1; i < n; j = i++) {
+        const GeoPoint &c = ring[j];
+        const GeoPoint &d = ring[i];
+        // Kenar kutusu bacak kutusuyla kesişmiyorsa kesin test gereksiz
+        if (std::max(c.lon, d.lon) < seg.minX || std::min(c.lon, d.lon) > seg.maxX
+            || std::max(c.lat, d.lat) < seg.minY || std::min(c.lat, d.lat) > seg.maxY)
+            continue;
+        if (segmentsIntersect(a, b, c, d)) return true;
+    }
+    return false;
+}
+
+static inline bool isGroundCommand(MissionCommand c)
+{
+    return c == MissionCommand::Takeoff || c == MissionCommand::VtolTakeoff
+        || c == MissionCommand::Land || c == MissionCommand::VtolLand
+        || c == MissionCommand::Rtl;
+}
+
+static inline bool isTerminalCommand(MissionCommand c)
+{
+    return c == MissionCommand::Land || c == MissionCommand::VtolLand || c == MissionCommand::Rtl;
+}
+
+// ---------------------------------------------------------------- bölgeler
+
+void MissionValidator::setZones(const QVector<Zone> &zones)
+{
+    m_zones = zones;
+    m_zoneBoxes.clear();
+    m_zoneBoxes.reserve(zones.size());
+    m_hasFence = false;
+
+    for (const Zone &z : zones) {
+        RBox b{1e9, 1e9, -1e9, -1e9};
+        for (const GeoPoint &g : z.ring)
+            b.expand(RBox{g.lon, g.lat, g.lon, g.lat});
+        m_zoneBoxes.push_back(b);
+        m_hasFence = m_hasFence || z.inclusion;
+    }
+    m_tree.build(m_zoneBoxes);
+}
+
+static void appendRing(const QJsonArray &ring, const QString &name, bool inclusion,
+                       QVector<MissionValidator::Zone> &out)
+{
+    MissionValidator::Zone z;
+    z.name = name;
+    z.inclusion = inclusion;
+    z.ring.reserve(ring.size());
+    for (const QJsonValue &v : ring) {
+        const QJsonArray c = v.toArray();
+        if (c.size() >= 2)
+            z.ring.append(GeoPoint{c[1].toDouble(), c[0].toDouble()});     // [lon, lat]
+    }
+    // GeoJSON halkaları kapalıdır; son tekrar eden köşe gereksiz
+    if (z.ring.size() > 1 && z.ring.first().lat == z.ring.last().lat
+        && z.ring.first().lon == z.ring.last().lon)
+        z.ring.removeLast();
+    if (z.ring.size() >= 3)
+        out.append(z);
+}
+
+static void appendGeometry(const QJsonObject &geom, const QJsonObject &props,
+                           QVector<MissionValidator::Zone> &out)
+{
+    const QString type = geom.value("type").toString();
+    const QString kind = props.value("type").toString().toLower();
+    const bool inclusion = kind == "inclusion" || kind == "geofence" || props.value("inclusion").toBool();
+    const QString name = props.value("name").toString();
+
+    // Sadece dış halka; delikler yok sayılır
+    if (type == "Polygon") {
+        appendRing(geom.value("coordinates").toArray().at(0).toArray(), name, inclusion, out);
+    } else if (type == "MultiPolygon") {
+        for (const QJsonValue &poly : geom.value("coordinates").toArray())
+            appendRing(poly.toArray().at(0).toArray(), name, inclusion, out);
+    }
+}
+
+bool MissionValidator::loadZones(const QString &path, QVector<Zone> &out, QString *error)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        if (error) *error = f.errorString();
+        return false;
+    }
+
+    QJsonParseError pe;
+    const QJsonDocument doc = QJsonDocument::fromJson(f.readAll(), &pe);
+    if (pe.error != QJsonParseError::NoError || !doc.isObject()) {
+        if (error) *error = QString("GeoJSON parse error: %1").arg(pe.errorString());
+        return false;
+    }
+
+    out.clear();
+    const QJsonObject root = doc.object();
+    const QString type = root.value("type").toString();
+    if (type == "FeatureCollection") {
+        for (const QJsonValue &fv : root.value("features").toArray()) {
+            const QJsonObject feature = fv.toObject();
+            appendGeometry(feature.value("geometry").toObject(), feature.value("properties").toObject(), out);
+        }
+    } else if (type == "Feature") {
+        appendGeometry(root.value("geometry").toObject(), root.value("properties").toObject(), out);
+    } else {
+        appendGeometry(root, QJsonObject(), out);
+    }
+
+    if (out.isEmpty()) {
+        if (error) *error = "No polygons in " + path;
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------- kontroller
+
+double MissionValidator::minTurnRadius() const
+{
+    const double bank = qBound(5.0, m_rules.maxBankDeg, 80.0) * M_PI / 180.0;
+    return m_rules.cruiseSpeed * m_rules.cruiseSpeed / (GRAVITY * std::tan(bank));
+}
+
+quint16 MissionValidator::checkLeg(const Waypoint &a, const Waypoint &b) const
+{
+    if (m_tree.isEmpty()) return NoIssue;
+
+    const GeoPoint pa{a.lat, a.lon};
+    const GeoPoint pb{b.lat, b.lon};
+    const RBox box{std::min(a.lon, b.lon), std::min(a.lat, b.lat),
+                   std::max(a.lon, b.lon), std::max(a.lat, b.lat)};
+
+    quint16 out = NoIssue;
+    bool insideFence = false;
+    m_tree.query(box, [&](int id) {
+        const Zone &z = m_zones[id];
+        if (z.inclusion) {
+            if (!insideFence && pointInRing(pa, z.ring) && pointInRing(pb, z.ring)
+                && !segmentCrossesRing(pa, pb, z.ring))
+                insideFence = true;
+        } else if (!(out & InNoFlyZone)) {
+            if (pointInRing(pa, z.ring) || pointInRing(pb, z.ring) || segmentCrossesRing(pa, pb, z.ring))
+                out |= InNoFlyZone;
+        }
+    });
+    if (m_hasFence && !insideFence)
+        out |= OutsideFence;
+    return out;
+}
+
+quint16 MissionValidator::checkRow(const QVector<Waypoint> &wps, int row) const
+{
+    const int n = wps.size();
+    const Waypoint &wp = wps[row];
+    quint16 out = checkLeg(row > 0 ? wps[row - 1] : wp, wp);
+
+    if (wp.alt > m_rules.maxAlt)
+        out |= AltitudeHigh;
+    if (wp.alt < m_rules.minAlt && !isGroundCommand(wp.command))
+        out |= AltitudeLow;
+
+    const double rMin = minTurnRadius();
+    if (wp.command == MissionCommand::Loiter && wp.radius < rMin)
+        out |= LoiterTooTight;
+
+    // Geçiş (fly-by) dönüşü: dönüş yayının başlangıcı kabul yarıçapının içinde olmalı
+    if (wp.command == MissionCommand::Waypoint && row > 0 && row + 1 < n) {
+        const Waypoint &prev = wps[row - 1];
+        const Waypoint &next = wps[row + 1];
+        const bool degenerate = (prev.lat == wp.lat && prev.lon == wp.lon)
+                             || (next.lat == wp.lat && next.lon == wp.lon);
+        if (!degenerate && !isGroundCommand(next.command)) {
+            const double in = Geodesy::bearing(prev.lat, prev.lon, wp.lat, wp.lon);
+            const double outB = Geodesy::bearing(wp.lat, wp.lon, next.lat, next.lon);
+            double turn = std::fabs(outB - in);
+            if (turn > 180.0) turn = 360.0 - turn;
+            const double lead = turn >= 179.0 ? 1e12 : rMin * std::tan(turn * M_PI / 360.0);
+            if (lead > wp.radius)
+                out |= TurnTooTight;
+        }
+    }
+
+    const bool takeoff = wp.command == MissionCommand::Takeoff || wp.command == MissionCommand::VtolTakeoff;
+    if ((takeoff && row != 0) || (row > 0 && isTerminalCommand(wps[row - 1].command)))
+        out |= BadSequence;
+
+    return out;
+}
+
+void MissionValidator::setIssues(int row, quint16 v)
+{
+    quint16 &cur = m_issues[row];
+    if (cur == v) return;
+    m_offending += (v != 0) - (cur != 0);
+    cur = v;
+}
+
+void MissionValidator::recheck(const QVector<Waypoint> &wps, int from, int to, int &first, int &last)
+{
+    from = qMax(from, 0);
+    to = qMin(to, wps.size() - 1);
+    first = wps.size();
+    last = -1;
+    for (int r = from; r <= to; ++r) {
+        const quint16 v = checkRow(wps, r);
+        if (v == m_issues[r]) continue;
+        setIssues(r, v);
+        first = qMin(first, r);
+        last = r;
+    }
+}
+
+void MissionValidator::validateAll(const QVector<Waypoint> &wps)
+{
+    m_issues.fill(0, wps.size());
+    m_offending = 0;
+    for (int r = 0; r < wps.size(); ++r)
+        setIssues(r, checkRow(wps, r));
+}
+
+// r'yi kullanan kontroller: r-1 (dönüş), r, r+1 (giren bacak, dönüş, sıra)
+void MissionValidator::rowChanged(const QVector<Waypoint> &wps, int row, int &first, int &last)
+{
+    recheck(wps, row - 1, row + 1, first, last);
+}
+
+void MissionValidator::rowInserted(const QVector<Waypoint> &wps, int row, int &first, int &last)
+{
+    m_issues.insert(row, quint16(0));
+    recheck(wps, row - 1, row + 1, first, last);
+}
+
+void MissionValidator::rowRemoved(const QVector<Waypoint> &wps, int row, int &first, int &last)
+{
+    setIssues(row, 0);
+    m_issues.removeAt(row);
+    recheck(wps, row - 1, row, first, last);
+}
+
+QVector<int> MissionValidator::offendingLegs() const
+{
+    QVector<int> legs;
+    if (m_offending == 0) return legs;
+    for (int r = 1; r < m_issues.size(); ++r)
+        if (m_issues[r] & (InNoFlyZone | OutsideFence | AltitudeLow | AltitudeHigh))
+            legs.append(r);
+    return legs;
+}
+
+QString MissionValidator::describe(quint16 issues)
+{
+    QStringList parts;
+    if (issues & InNoFlyZone)    parts << "leg enters a no-fly zone";
+    if (issues & OutsideFence)   parts << "leg leaves the geofence";
+    if (issues & AltitudeLow)    parts << "altitude below minimum";
+    if (issues & AltitudeHigh)   parts << "altitude above maximum";
+    if (issues & TurnTooTight)   parts << "turn does not fit in the acceptance radius";
+    if (issues & LoiterTooTight) parts << "loiter radius below minimum turn radius";
+    if (issues & BadSequence)    parts << "command out of sequence";
+    return parts.join("; ");
+}
@@ -0,0 +1,720 @@
+#include "nativemap.h"
+#include "tilestore.h"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <QPaintEvent>
+#include <QToolButton>
+#include <QWheelEvent>
+#include <QSet>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+static constexpr double DEFAULT_LAT = 40.808616;
+static constexpr double DEFAULT_LNG = 29.359141;
+static constexpr double MIN_ZOOM = 0.0;
+static constexpr double MAX_ZOOM = 22.0;
+static constexpr double EARTH_CIRCUMFERENCE = 40075016.686;   // metre
+
+// Karo yoksa en fazla kaç üst seviyeden ölçeklenerek çizilsin
+static constexpr int FALLBACK_LEVELS = 4;
+
+// Waypoint katmanı (piksel), map.html WaypointLayer ile aynı değerler
+static constexpr double CLUSTER_CELL = 48.0;
+static constexpr int    CLUSTER_MIN  = 3;
+static constexpr double LABEL_CELL_W = 64.0;
+static constexpr double LABEL_CELL_H = 22.0;
+static constexpr double MIN_ARROW_PX = 40.0;
+
+NativeMapWidget::NativeMapWidget(TileStore *tiles, bool pickVisible, QWidget *parent)
+    : QWidget(parent),
+    m_tiles(tiles),
+    m_bridge(new MapBridge(this)),
+    m_center(project(DEFAULT_LAT, DEFAULT_LNG)),
+    m_uavLat(DEFAULT_LAT),
+    m_uavLon(DEFAULT_LNG),
+    m_uavIcon(QPixmap(":/img/uav.png").scaled(64, 64, Qt::KeepAspectRatio, Qt::SmoothTransformation)),
+    m_markerIcon(":/img/leaflet/images/marker-icon.png")
+{
+    setAttribute(Qt::WA_OpaquePaintEvent, true);
+    setMinimumSize(200, 200);
+
+    const QString btnStyle =
+        "QToolButton {"
+        "   background: rgba(30,30,30,0.9);"
+        "   color: white;"
+        "   font-size: 26px;"
+        "   font-weight: bold;"
+        "   border: 1px solid #555;"
+        "}"
+        "QToolButton:hover { background: #0078ff; }"
+        "QToolButton:checked { background: #00b35a; }";
+
+    auto makeButton = [this, &btnStyle](const QString &text) {
+        auto *b = new QToolButton(this);
+        b->setText(text);
+        b->setFixedSize(54, 54);
+        b->setCursor(Qt::PointingHandCursor);
+        b->setStyleSheet(btnStyle);
+        return b;
+    };
+
+    m_btnZoomIn  = makeButton("+");
+    m_btnZoomOut = makeButton(QString::fromUtf8("−"));
+    m_btnPick    = makeButton("PICK");
+    m_btnPick->setCheckable(true);
+    m_btnPick->setStyleSheet(btnStyle + "QToolButton { font-size: 16px; }");
+    m_btnPick->setVisible(pickVisible);
+
+    connect(m_btnZoomIn,  &QToolButton::clicked, this, [this]() { zoomStep(+1.0); });
+    connect(m_btnZoomOut, &QToolButton::clicked, this, [this]() { zoomStep(-1.0); });
+    connect(m_btnPick,    &QToolButton::clicked, this, &NativeMapWidget::togglePick);
+
+    connect(m_tiles, &TileStore::tileReady, this, &NativeMapWidget::onTileReady);
+
+    layoutButtons();
+}
+
+/* -------------------- Projeksiyon -------------------- */
+
+QPointF NativeMapWidget::project(double lat, double lon)
+{
+    lat = qBound(-85.05112878, lat, 85.05112878);
+    const double x = (lon + 180.0) / 360.0;
+    const double s = std::sin(qDegreesToRadians(lat));
+    const double y = 0.5 - std::log((1.0 + s) / (1.0 - s)) / (4.0 * M_PI);
+    return QPointF(x, y);
+}
+
+void NativeMapWidget::unproject(const QPointF &n, double &lat, double &lon)
+{
+    lon = n.x() * 360.0 - 180.0;
+    lat = qRadiansToDegrees(std::atan(std::sinh(M_PI * (1.0 - 2.0 * n.y()))));
+}
+
+double NativeMapWidget::worldSize() const
+{
+    return TileStore::TILE_SIZE * std::pow(2.0, m_zoom);
+}
+
+QPointF NativeMapWidget::toScreen(const QPointF &n) const
+{
+    const double ws = worldSize();
+    return QPointF((n.x() - m_center.x()) * ws + width()  * 0.5,
+                   (n.y() - m_center.y()) * ws + height() * 0.5);
+}
+
+QPointF NativeMapWidget::toScreen(double lat, double lon) const
+{
+    return toScreen(project(lat, lon));
+}
+
+void NativeMapWidget::toGeo(const QPointF &screen, double &lat, double &lon) const
+{
+    const double ws = worldSize();
+    const QPointF n(m_center.x() + (screen.x() - width()  * 0.5) / ws,
+                    m_center.y() + (screen.y() - height() * 0.5) / ws);
+    unproject(n, lat, lon);
+}
+
+double NativeMapWidget::metersPerPixel(double lat) const
+{
+    return EARTH_CIRCUMFERENCE * std::cos(qDegreesToRadians(lat)) / worldSize();
+}
+
+QRectF NativeMapWidget::tileScreenRect(int z, int x, int y) const
+{
+    const double n = double(1 << z);
+    const QPointF tl = toScreen(QPointF(x / n, y / n));
+    const double size = worldSize() / n;
+    return QRectF(tl, QSizeF(size, size));
+}
+
+QRect NativeMapWidget::uavRect() const
+{
+    const QPointF c = toScreen(m_uavLat, m_uavLon);
+    return QRect(int(c.x()) - 34, int(c.y()) - 34, 68, 68);
+}
+
+/* -------------------- MapSurface -------------------- */
+
+void NativeMapWidget::setUav(double lat, double lon, bool pan)
+{
+    const QRect oldRect = uavRect();
+    m_uavLat = lat;
+    m_uavLon = lon;
+    m_hasGpsFix = true;
+
+    if (pan && m_follow) {
+        m_center = project(lat, lon);
+        update();
+        return;
+    }
+
+    // Sadece eski ve yeni ikon bölgesi
+    update(oldRect);
+    update(uavRect());
+}
+
+void NativeMapWidget::setPolygonDrawMode(bool on)
+{
+    if (m_polyDrawMode && !on) {
+        if (m_polygon.size() >= 3)
+            emit m_bridge->polygonDrawn(m_polygon);
+        m_polygon.clear();
+        update();
+    }
+    m_polyDrawMode = on;
+}
+
+void NativeMapWidget::setZones(const QVector<QVector<GeoPoint>> &rings, const QVector<bool> &inclusion)
+{
+    m_zones.clear();
+    m_zones.reserve(rings.size());
+    for (int i = 0; i < rings.size(); ++i) {
+        ZoneShape z;
+        z.inclusion = inclusion.value(i);
+        z.ring.reserve(rings[i].size());
+        for (const GeoPoint &g : rings[i])
+            z.ring << project(g.lat, g.lon);
+        z.bounds = z.ring.boundingRect();
+        m_zones.append(z);
+    }
+    update();
+}
+
+void NativeMapWidget::setLegHighlights(const QVector<int> &legs)
+{
+    if (legs == m_badLegs) return;
+    m_badLegs = legs;
+    update();
+}
+
+void NativeMapWidget::setActiveLeg(int index)
+{
+    if (index == m_activeLeg) return;
+    m_activeLeg = index;
+    update();
+}
+
+void NativeMapWidget::setCoverageTile(const QString &id, const QImage &image,
+                                      const GeoPoint &sw, const GeoPoint &ne)
+{
+    const QPointF tl = project(ne.lat, sw.lon);
+    const QPointF br = project(sw.lat, ne.lon);
+    m_coverage.insert(id, CoverageTile{image, QRectF(tl, br)});
+    update();
+}
+
+void NativeMapWidget::clearCoverage()
+{
+    if (m_coverage.isEmpty()) return;
+    m_coverage.clear();
+    update();
+}
+
+void NativeMapWidget::setDragWaypoint(int index)
+{
+    // Sadece basılıyken anlamlı; bırakınca mouseReleaseEvent sıfırlar
+    m_dragRow = m_pressed ? index : -1;
+    if (m_dragRow >= 0)
+        setCursor(Qt::SizeAllCursor);
+}
+
+void NativeMapWidget::setFlightPath(const QVector<GeoPoint> &path)
+{
+    m_flightPath.resize(path.size());
+    for (int i = 0; i < path.size(); ++i)
+        m_flightPath[i] = project(path[i].lat, path[i].lon);
+    update();
+}
+
+void NativeMapWidget::centerOn(double lat, double lon)
+{
+    m_center = project(lat, lon);
+    update();
+}
+
+void NativeMapWidget::setGpsFixState(bool fix)
+{
+    m_hasGpsFix = fix;
+}
+
+void NativeMapWidget::setZoom(double zoom)
+{
+    zoomAround(zoom, QPointF(width() * 0.5, height() * 0.5));
+}
+
+void NativeMapWidget::setWaypoints(const QVector<Waypoint> &wps)
+{
+    m_wps = wps;
+    m_flightPath.clear();
+    update();
+}
+
+void NativeMapWidget::clearWaypoints()
+{
+    m_wps.clear();
+    m_flightPath.clear();
+    update();
+}
+
+void NativeMapWidget::updateWaypoint(int index, const Waypoint &wp)
+{
+    if (index < 0 || index >= m_wps.size()) return;
+    m_wps[index] = wp;
+    m_flightPath.clear();       // yeni yol gelene kadar düz çizgi
+    update();
+}
+
+void NativeMapWidget::insertWaypoint(int index, const Waypoint &wp)
+{
+    m_wps.insert(qBound(0, index, int(m_wps.size())), wp);
+    m_flightPath.clear();
+    update();
+}
+
+void NativeMapWidget::removeWaypoint(int index)
+{
+    if (index < 0 || index >= m_wps.size()) return;
+    m_wps.removeAt(index);
+    m_flightPath.clear();
+    update();
+}
+
+/* -------------------- Zoom / pan -------------------- */
+
+void NativeMapWidget::zoomAround(double zoom, const QPointF &anchor)
+{
+    zoom = qBound(MIN_ZOOM, std::round(zoom * 10.0) / 10.0, MAX_ZOOM);
+    if (qFuzzyCompare(zoom, m_zoom))
+        return;
+
+    // anchor noktası ekranda sabit kalsın
+    const QPointF offset(anchor.x() - width() * 0.5, anchor.y() - height() * 0.5);
+    const QPointF anchorN = m_center + offset / worldSize();
+    m_zoom = zoom;
+    m_center = anchorN - offset / worldSize();
+
+    update();
+    m_bridge->onZoomChangedFromJs(m_zoom);
+}
+
+void NativeMapWidget::zoomStep(double delta)
+{
+    // Sınırdayken hiçbir şey yapma (görünüm UAV'a atlamasın)
+    const double zoom = qBound(MIN_ZOOM, m_zoom + delta, MAX_ZOOM);
+    if (qFuzzyCompare(zoom, m_zoom))
+        return;
+
+    // map.html: zoom merkezi GPS varsa UAV, yoksa varsayılan nokta.
+    // UAV'a dönüldüğü için takip yeniden açılır.
+    m_center = m_hasGpsFix ? project(m_uavLat, m_uavLon)
+                           : project(DEFAULT_LAT, DEFAULT_LNG);
+    m_follow = true;
+    setZoom(zoom);
+    update();
+}
+
+void NativeMapWidget::togglePick()
+{
+    m_pickMode = m_btnPick->isChecked();
+    m_bridge->pickModeChanged(m_pickMode);
+}
+
+void NativeMapWidget::layoutButtons()
+{
+    const int x = width() - 15 - 54;
+    int y = height() - 40 - 54;
+
+    QToolButton *buttons[] = { m_btnPick, m_btnZoomOut, m_btnZoomIn };
+    for (QToolButton *b : buttons) {
+        if (b == m_btnPick && !m_btnPick->isVisibleTo(this)) continue;
+        b->move(x, y);
+        y -= 54 + 8;
+    }
+}
+
+void NativeMapWidget::onTileReady(int z, int x, int y)
+{
+    const QRect r = tileScreenRect(z, x, y).toAlignedRect() & rect();
+    if (!r.isEmpty())
+        update(r);
+}
+
+void NativeMapWidget::resizeEvent(QResizeEvent *e)
+{
+    QWidget::resizeEvent(e);
+    layoutButtons();
+}
+
+void NativeMapWidget::mousePressEvent(QMouseEvent *e)
+{
+    if (e->button() != Qt::LeftButton) return;
+    m_pressed = true;
+    m_dragging = false;
+    m_pressPos = e->position().toPoint();
+    m_lastPos = m_pressPos;
+
+    // Bağlantı doğrudan: cevap (setDragWaypoint) bu çağrı içinde gelir
+    m_dragRow = -1;
+    if (!m_pickMode && !m_polyDrawMode) {
+        double lat, lon;
+        toGeo(e->position(), lat, lon);
+        m_bridge->onMapPressed(lat, lon, m_zoom);
+    }
+}
+
+void NativeMapWidget::mouseMoveEvent(QMouseEvent *e)
+{
+    if (!m_pressed) return;
+
+    if (m_dragRow >= 0) {
+        double lat, lon;
+        toGeo(e->position(), lat, lon);
+        m_bridge->onMapDragged(lat, lon);
+        return;
+    }
+
+    const QPoint pos = e->position().toPoint();
+    if (!m_dragging && (pos - m_pressPos).manhattanLength() < 4)
+        return;
+
+    m_dragging = true;
+    m_follow = false;               // bir sonraki fix görünümü geri çekmesin
+    setCursor(Qt::ClosedHandCursor);
+
+    const QPoint d = pos - m_lastPos;
+    m_lastPos = pos;
+    m_center -= QPointF(d) / worldSize();
+
+    // Var olan pikselleri kaydır, sadece açılan şeritler boyansın.
+    // rect() verilince çocuk butonlar yerinde kalır.
+    scroll(d.x(), d.y(), rect());
+}
+
+void NativeMapWidget::mouseReleaseEvent(QMouseEvent *e)
+{
+    if (e->button() != Qt::LeftButton || !m_pressed) return;
+    m_pressed = false;
+
+    if (m_dragRow >= 0) {
+        m_dragRow = -1;
+        unsetCursor();
+        double lat, lon;
+        toGeo(e->position(), lat, lon);
+        m_bridge->onMapReleased(lat, lon);
+        return;
+    }
+
+    if (m_dragging) {
+        m_dragging = false;
+        unsetCursor();
+        return;
+    }
+
+    if (m_polyDrawMode) {
+        GeoPoint g;
+        toGeo(e->position(), g.lat, g.lon);
+        m_polygon.append(g);
+        update();
+        return;
+    }
+
+    if (!m_pickMode) return;       // seçim basınca (onMapPressed)
+
+    double lat, lon;
+    toGeo(e->position(), lat, lon);
+    m_bridge->onMapClicked(lat, lon, int(e->position().x()), int(e->position().y()));
+}
+
+void NativeMapWidget::wheelEvent(QWheelEvent *e)
+{
+    const double notches = e->angleDelta().y() / 120.0;
+    if (notches == 0.0) return;
+    zoomAround(m_zoom + notches * 0.5, e->position());
+    e->accept();
+}
+
+/* -------------------- Çizim -------------------- */
+
+void NativeMapWidget::paintEvent(QPaintEvent *e)
+{
+    QPainter p(this);
+    const QRect dirty = e->rect();
+    p.fillRect(dirty, Qt::black);
+
+    paintTiles(p, dirty);
+
+    paintCoverage(p);
+    p.setRenderHint(QPainter::Antialiasing, true);
+    paintZones(p);
+    paintWaypoints(p);
+    paintPolygon(p);
+    paintUav(p);
+}
+
+void NativeMapWidget::paintTiles(QPainter &p, const QRect &dirty)
+{
+    const int z = qBound(0, int(std::floor(m_zoom)), TileStore::MAX_NATIVE_ZOOM);
+    const int n = 1 << z;
+    const double tilePx = worldSize() / n;
+
+    // Kesirli zoom'da karolar ölçeklenir
+    const bool scaled = std::abs(tilePx - TileStore::TILE_SIZE) > 0.01;
+    p.setRenderHint(QPainter::SmoothPixmapTransform, scaled);
+
+    const double ws = worldSize();
+    const double left = m_center.x() * ws - width()  * 0.5;
+    const double top  = m_center.y() * ws - height() * 0.5;
+
+    const int tx0 = int(std::floor((left + dirty.left())   / tilePx));
+    const int tx1 = int(std::floor((left + dirty.right())  / tilePx));
+    const int ty0 = qMax(0,     int(std::floor((top + dirty.top())    / tilePx)));
+    const int ty1 = qMin(n - 1, int(std::floor((top + dirty.bottom()) / tilePx)));
+
+    for (int ty = ty0; ty <= ty1; ++ty) {
+        for (int tx = tx0; tx <= tx1; ++tx) {
+            const int wx = ((tx % n) + n) % n;   // yatayda sarmal
+            const QRectF target(tx * tilePx - left, ty * tilePx - top, tilePx, tilePx);
+
+            const QImage img = m_tiles->tile(z, wx, ty);
+            if (!img.isNull()) {
+                p.drawImage(target, img);
+                continue;
+            }
+
+            // Yüklenene kadar üst seviyedeki karodan ölçekleyerek doldur
+            for (int d = 1; d <= FALLBACK_LEVELS && z - d >= 0; ++d) {
+                const int pz = z - d;
+                const int px = wx >> d;
+                const int py = ty >> d;
+                if (!m_tiles->contains(pz, px, py)) continue;
+
+                const QImage parent = m_tiles->tile(pz, px, py);
+                const double sub = double(TileStore::TILE_SIZE) / (1 << d);
+                const QRectF source((wx & ((1 << d) - 1)) * sub,
+                                    (ty & ((1 << d) - 1)) * sub, sub, sub);
+                p.drawImage(target, parent, source);
+                break;
+            }
+        }
+    }
+}
+
+quint64 NativeMapWidget::cellKey(int cx, int cy)
+{
+    return (quint64(quint32(cx + 32768)) << 32) | quint32(cy + 32768);
+}
+
+// map.html WaypointLayer ile aynı: tek geçiş, kümeleme, etiket ayıklama
+void NativeMapWidget::paintWaypoints(QPainter &p)
+{
+    if (m_wps.isEmpty()) return;
+
+    const int n = m_wps.size();
+
+    // Kümeler ve etiket hücreleri dünya pikselinde (zoom'a bağlı): pan
+    // (scroll + kısmi boyama) sırasında üyelik değişmez. Görünür alan küme
+    // hücrelerine hizalanır; kenardaki bir hücrenin üyeleri eksik kalmaz.
+    const QPointF origin = m_center * worldSize() - QPointF(width() * 0.5, height() * 0.5);
+    const double x0 = std::floor((origin.x() - 60.0) / CLUSTER_CELL) * CLUSTER_CELL;
+    const double y0 = std::floor((origin.y() - 60.0) / CLUSTER_CELL) * CLUSTER_CELL;
+    const double x1 = std::ceil((origin.x() + width() + 60.0) / CLUSTER_CELL) * CLUSTER_CELL;
+    const double y1 = std::ceil((origin.y() + height() + 60.0) / CLUSTER_CELL) * CLUSTER_CELL;
+    const QRectF view(QPointF(x0, y0) - origin, QPointF(x1, y1) - origin);
+
+    QVector<QPointF> pts(n);
+    QVector<int> visible;
+    for (int i = 0; i < n; ++i) {
+        pts[i] = toScreen(m_wps[i].lat, m_wps[i].lon);
+        if (view.contains(pts[i]))
+            visible.append(i);
+    }
+
+    // Yarıçap çemberleri (kesikli beyaz)
+    QPen circlePen(Qt::white, 2);
+    circlePen.setDashPattern({3, 4});
+    p.setPen(circlePen);
+    p.setBrush(Qt::NoBrush);
+    for (int i : visible) {
+        const double r = m_wps[i].radius / metersPerPixel(m_wps[i].lat);
+        if (r >= 2.0)
+            p.drawEllipse(pts[i], r, r);
+    }
+
+    // Rota
+    p.setPen(QPen(QColor("#3b82f6"), 3, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+    if (!m_flightPath.isEmpty()) {
+        QVector<QPointF> flown(m_flightPath.size());
+        for (int i = 0; i < m_flightPath.size(); ++i)
+            flown[i] = toScreen(m_flightPath[i]);
+        p.drawPolyline(flown.constData(), flown.size());
+    } else {
+        p.drawPolyline(pts.constData(), pts.size());
+    }
+
+    // Doğrulamadan geçemeyen bacaklar rotanın üstüne kırmızı
+    if (!m_badLegs.isEmpty()) {
+        p.setPen(QPen(QColor("#ef4444"), 5, Qt::SolidLine, Qt::RoundCap));
+        for (int i : std::as_const(m_badLegs))
+            if (i >= 1 && i < n)
+                p.drawLine(pts[i - 1], pts[i]);
+    }
+
+    // Uçuşta aktif bacak; hedef noktaya kadar
+    if (m_activeLeg >= 0 && m_activeLeg < n) {
+        p.setPen(QPen(QColor("#22c55e"), 6, Qt::SolidLine, Qt::RoundCap));
+        if (m_activeLeg >= 1)
+            p.drawLine(pts[m_activeLeg - 1], pts[m_activeLeg]);
+        p.setBrush(Qt::NoBrush);
+        p.drawEllipse(pts[m_activeLeg], 12, 12);
+    }
+
+    // Segment ortasında sarı ok (kısa ya da ekran dışı segmentlerde yok)
+    p.setPen(QPen(QColor("yellow"), 2));
+    p.setBrush(QColor("yellow"));
+    for (int i = 0; i + 1 < n; ++i) {
+        const QPointF d = pts[i + 1] - pts[i];
+        const double len = std::hypot(d.x(), d.y());
+        if (len < MIN_ARROW_PX) continue;
+
+        const QPointF mid = (pts[i] + pts[i + 1]) * 0.5;
+        if (!rect().contains(mid.toPoint())) continue;
+
+        const QPointF u = d / len;
+        const QPointF nrm(-u.y(), u.x());
+        const double s = 7.0;
+        const QPointF tri[3] = {
+            mid + u * s,
+            mid - u * s + nrm * s,
+            mid - u * s - nrm * s
+        };
+        p.drawPolygon(tri, 3);
+    }
+
+    // Kümeleme
+    QHash<quint64, QVector<int>> cells;
+    for (int i : visible) {
+        const QPointF pt = pts[i] + origin;
+        cells[cellKey(int(std::floor(pt.x() / CLUSTER_CELL)),
+                      int(std::floor(pt.y() / CLUSTER_CELL)))].append(i);
+    }
+
+    QFont f = font();
+    f.setPixelSize(13);
+    f.setWeight(QFont::DemiBold);
+    p.setFont(f);
+
+    QVector<int> singles;
+    for (const QVector<int> &b : std::as_const(cells)) {
+        if (b.size() < CLUSTER_MIN) {
+            singles += b;
+            continue;
+        }
+
+        QPointF c;
+        for (int i : b) c += pts[i];
+        c /= b.size();
+        const double r = 12.0 + qMin(12.0, std::log2(double(b.size())) * 2.0);
+
+        p.setPen(QPen(Qt::white, 2));
+        p.setBrush(QColor(59, 130, 246, 217));
+        p.drawEllipse(c, r, r);
+        p.drawText(QRectF(c.x() - r, c.y() - r, 2 * r, 2 * r), Qt::AlignCenter,
+                   QString::number(b.size()));
+    }
+
+    std::sort(singles.begin(), singles.end());
+    for (int i : std::as_const(singles))
+        p.drawPixmap(QPointF(pts[i].x() - 12, pts[i].y() - 41), m_markerIcon);
+
+    // Etiketler: her etiket hücresine bir tane
+    f.setPixelSize(14);
+    p.setFont(f);
+    const QFontMetrics fm(f);
+    QSet<quint64> taken;
+    for (int i : std::as_const(singles)) {
+        const QPointF lc(pts[i].x(), pts[i].y() - 41 - 10 - 10);
+        const QPointF lw = lc + origin;
+        const quint64 k = cellKey(int(std::floor(lw.x() / LABEL_CELL_W)),
+                                  int(std::floor(lw.y() / LABEL_CELL_H)));
+        if (taken.contains(k)) continue;
+        taken.insert(k);
+
+        const QString label = QString("WP %1").arg(i + 1);
+        QRectF box(0, 0, fm.horizontalAdvance(label) + 8, 20);
+        box.moveCenter(lc);
+
+        p.setPen(QColor("#777"));
+        p.setBrush(QColor(30, 30, 30, 217));
+        p.drawRoundedRect(box, 4, 4);
+        p.setPen(Qt::white);
+        p.drawText(box, Qt::AlignCenter, label);
+    }
+}
+
+void NativeMapWidget::paintPolygon(QPainter &p)
+{
+    if (m_polygon.isEmpty()) return;
+
+    QPolygonF poly;
+    for (const GeoPoint &g : std::as_const(m_polygon))
+        poly << toScreen(g.lat, g.lon);
+
+    QPen pen(QColor("#ffb000"), 2);
+    pen.setDashPattern({2, 3});
+    p.setPen(pen);
+    p.setBrush(QColor(255, 176, 0, 38));
+    p.drawPolygon(poly);
+}
+
+// Görünür alanla kesişmeyen bölgeler atlanır
+void NativeMapWidget::paintZones(QPainter &p)
+{
+    if (m_zones.isEmpty()) return;
+
+    const double ws = worldSize();
+    const QPointF origin(m_center.x() * ws - width() * 0.5, m_center.y() * ws - height() * 0.5);
+    const QRectF view(origin.x() / ws, origin.y() / ws, width() / ws, height() / ws);
+
+    const QColor noFly("#ef4444");
+    const QColor fence("#22c55e");
+    for (const ZoneShape &z : std::as_const(m_zones)) {
+        if (!view.intersects(z.bounds)) continue;
+
+        QPolygonF poly;
+        poly.reserve(z.ring.size());
+        for (const QPointF &n : z.ring)
+            poly << n * ws - origin;
+
+        p.setPen(QPen(z.inclusion ? fence : noFly, 1));
+        p.setBrush(z.inclusion ? QBrush(Qt::NoBrush) : QBrush(QColor(239, 68, 68, 51)));
+        p.drawPolygon(poly);
+    }
+}
+
+// Hücreler keskin kalsın: ölçeklemede yumuşatma yok
+void NativeMapWidget::paintCoverage(QPainter &p)
+{
+    if (m_coverage.isEmpty()) return;
+
+    const double ws = worldSize();
+    const QPointF origin(m_center.x() * ws - width() * 0.5, m_center.y() * ws - height() * 0.5);
+    const QRectF view(origin.x() / ws, origin.y() / ws, width() / ws, height() / ws);
+
+    p.setRenderHint(QPainter::SmoothPixmapTransform, false);
+    for (const CoverageTile &t : std::as_const(m_coverage)) {
+        if (!view.intersects(t.bounds)) continue;
+        p.drawImage(QRectF(t.bounds.topLeft() * ws - origin, t.bounds.size() * ws), t.image);
+    }
+}
+
+void NativeMapWidget::paintUav(QPainter &p)
+{
+    const QPointF c = toScreen(m_uavLat, m_uavLon);
+    p.drawPixmap(QPointF(c.x() - m_uavIcon.width() * 0.5,
+                         c.y() - m_uavIcon.height() * 0.5), m_uavIcon);
+}
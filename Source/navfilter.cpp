@@ -0,0 +1,400 @@
+#include "navfilter.h"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr double GRAVITY = 9.80665;
+static constexpr double IMU_STALE = 0.25;          // s; daha eskiyse IMU yok sayılır
+static constexpr double ALIGN_SPEED = 3.0;         // m/s; rota için en az hız
+static constexpr double ALIGN_DIST = 5.0;          // m; rota için fix'ler arası en az yol
+static constexpr double MIN_SPEED_UPDATE = 1.0;    // m/s; altında hız ölçümü kullanılmaz
+static constexpr double GATE_POS = 16.0;           // chi^2, 3 serbestlik %99.9
+static constexpr double GATE_SPEED = 11.0;         // chi^2, 1 serbestlik %99.9
+static constexpr int MAX_REJECTED = 5;             // art arda; sonra fix'ten yeniden başla
+static constexpr double MAX_ACCEL_BIAS = 2.0;      // m/s^2
+static constexpr double MAX_GYRO_BIAS = 0.2;       // rad/s
+static constexpr double DEG = M_PI / 180.0;
+
+// Hata durumu indeksleri
+enum { P = 0, V = 3, TH = 6, BA = 9, BG = 12 };
+
+namespace {
+
+using Quat = std::array<double, 4>;
+
+Quat quatMul(const Quat &a, const Quat &b)
+{
+    return Quat{a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3],
+                a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2],
+                a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1],
+                a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0]};
+}
+
+// Dönme vektöründen (rad) kuaterniyon
+Quat quatExp(double x, double y, double z)
+{
+    const double a = std::sqrt(x * x + y * y + z * z);
+    if (a < 1e-12) return Quat{1.0, 0.5 * x, 0.5 * y, 0.5 * z};
+    const double s = std::sin(0.5 * a) / a;
+    return Quat{std::cos(0.5 * a), x * s, y * s, z * s};
+}
+
+void normalize(Quat &q)
+{
+    const double n = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (double &c : q) c /= n;
+}
+
+// 3x3'e kadar simetrik pozitif tanımlı matris tersi (Gauss-Jordan)
+bool invert(double *a, int n, double *inv)
+{
+    for (int i = 0; i < n * n; ++i) inv[i] = (i % (n + 1)) == 0 ? 1.0 : 0.0;
+    for (int c = 0; c < n; ++c) {
+        int piv = c;
+        for (int r = c + 1; r < n; ++r)
+            if (std::abs(a[r * n + c]) > std::abs(a[piv * n + c])) piv = r;
+        if (std::abs(a[piv * n + c]) < 1e-15) return false;
+        for (int k = 0; k < n; ++k) {
+            std::swap(a[c * n + k], a[piv * n + k]);
+            std::swap(inv[c * n + k], inv[piv * n + k]);
+        }
+        const double d = 1.0 / a[c * n + c];
+        for (int k = 0; k < n; ++k) {
+            a[c * n + k] *= d;
+            inv[c * n + k] *= d;
+        }
+        for (int r = 0; r < n; ++r) {
+            if (r == c) continue;
+            const double f = a[r * n + c];
+            for (int k = 0; k < n; ++k) {
+                a[r * n + k] -= f * a[c * n + k];
+                inv[r * n + k] -= f * inv[c * n + k];
+            }
+        }
+    }
+    return true;
+}
+
+}
+
+void NavFilter::reset()
+{
+    const Noise noise = m_noise;
+    *this = NavFilter();
+    m_noise = noise;
+}
+
+void NavFilter::rotation(double R[9]) const
+{
+    const double w = m_q[0], x = m_q[1], y = m_q[2], z = m_q[3];
+    R[0] = 1 - 2 * (y * y + z * z); R[1] = 2 * (x * y - w * z);     R[2] = 2 * (x * z + w * y);
+    R[3] = 2 * (x * y + w * z);     R[4] = 1 - 2 * (x * x + z * z); R[5] = 2 * (y * z - w * x);
+    R[6] = 2 * (x * z - w * y);     R[7] = 2 * (y * z + w * x);     R[8] = 1 - 2 * (x * x + y * y);
+}
+
+void NavFilter::init(double t, double lat, double lon, double alt)
+{
+    const Noise noise = m_noise;
+    const Vec3 acc = m_lastAcc, gyro = m_lastGyro;
+    const bool hasAcc = m_hasAcc;
+    const double lastImu = m_lastImu;
+    *this = NavFilter();
+    m_noise = noise;
+    m_lastAcc = acc;
+    m_lastGyro = gyro;
+    m_hasAcc = hasAcc;
+    m_lastImu = lastImu;
+
+    m_frame = EnuFrame(lat, lon, alt);
+    m_init = true;
+    m_t = t;
+    m_lastGps = t;
+
+    // Eğim: ölçülen özgül kuvveti yukarıya çeviren en kısa dönüş (yön sonra)
+    const double n = std::sqrt(acc[0] * acc[0] + acc[1] * acc[1] + acc[2] * acc[2]);
+    if (hasAcc && n > 0.5 * GRAVITY) {
+        const double fx = acc[0] / n, fy = acc[1] / n, fz = acc[2] / n;
+        const double ax = fy, ay = -fx;                 // f x z
+        const double s = std::sqrt(ax * ax + ay * ay);
+        const double angle = std::atan2(s, fz);
+        if (s > 1e-9)
+            m_q = quatExp(ax / s * angle, ay / s * angle, 0.0);
+    }
+
+    const double var[N] = {
+        noise.gpsH * noise.gpsH, noise.gpsH * noise.gpsH, noise.gpsV * noise.gpsV,
+        16.0, 16.0, 1.0,                        // hız
+        0.05 * 0.05, 0.05 * 0.05, M_PI * M_PI,  // eğim, yön bilinmiyor
+        0.25, 0.25, 0.25,
+        4e-4, 4e-4, 4e-4,
+    };
+    for (int i = 0; i < N; ++i) m_P[i * N + i] = var[i];
+}
+
+void NavFilter::predict(double dt, const Vec3 &acc, const Vec3 &gyro, bool useImu)
+{
+    if (dt <= 0.0) return;
+
+    double R[9];
+    rotation(R);
+    Vec3 ab{}, wb{}, an{};
+    if (useImu) {
+        for (int i = 0; i < 3; ++i) {
+            ab[i] = acc[i] - m_ba[i];
+            wb[i] = gyro[i] - m_bg[i];
+        }
+        for (int i = 0; i < 3; ++i)
+            an[i] = R[i * 3] * ab[0] + R[i * 3 + 1] * ab[1] + R[i * 3 + 2] * ab[2];
+        an[2] -= GRAVITY;
+        if (!m_headingValid) an[0] = an[1] = 0.0;
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        m_p[i] += m_v[i] * dt + 0.5 * an[i] * dt * dt;
+        m_v[i] += an[i] * dt;
+    }
+    if (useImu) {
+        m_q = quatMul(m_q, quatExp(wb[0] * dt, wb[1] * dt, wb[2] * dt));
+        normalize(m_q);
+    }
+
+    // Hata durumu geçişi F (seyrek bloklar)
+    Mat F{};
+    for (int i = 0; i < N; ++i) F[i * N + i] = 1.0;
+    for (int i = 0; i < 3; ++i) F[(P + i) * N + V + i] = dt;
+    if (useImu) {
+        // dv = -R [ab]x dth - R dba
+        const double Ax[9] = {0, -ab[2], ab[1], ab[2], 0, -ab[0], -ab[1], ab[0], 0};
+        const int firstRow = m_headingValid ? 0 : 2;
+        for (int r = firstRow; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                double m = 0.0;
+                for (int k = 0; k < 3; ++k) m += R[r * 3 + k] * Ax[k * 3 + c];
+                F[(V + r) * N + TH + c] = -m * dt;
+                F[(V + r) * N + BA + c] = -R[r * 3 + c] * dt;
+            }
+        }
+        // dth' = (I - [w dt]x) dth - dbg dt
+        const double wx = wb[0] * dt, wy = wb[1] * dt, wz = wb[2] * dt;
+        F[(TH + 0) * N + TH + 1] = wz;  F[(TH + 0) * N + TH + 2] = -wy;
+        F[(TH + 1) * N + TH + 0] = -wz; F[(TH + 1) * N + TH + 2] = wx;
+        F[(TH + 2) * N + TH + 0] = wy;  F[(TH + 2) * N + TH + 1] = -wx;
+        for (int i = 0; i < 3; ++i) F[(TH + i) * N + BG + i] = -dt;
+    }
+
+    // P = F P F^T + Q
+    Mat FP{};
+    for (int r = 0; r < N; ++r)
+        for (int k = 0; k < N; ++k) {
+            const double f = F[r * N + k];
+            if (f == 0.0) continue;
+            for (int c = 0; c < N; ++c) FP[r * N + c] += f * m_P[k * N + c];
+        }
+    Mat out{};
+    for (int r = 0; r < N; ++r)
+        for (int c = r; c < N; ++c) {
+            double s = 0.0;
+            for (int k = 0; k < N; ++k) s += FP[r * N + k] * F[c * N + k];
+            out[r * N + c] = out[c * N + r] = s;
+        }
+    m_P = out;
+
+    const Noise &n = m_noise;
+    const double qa = useImu ? n.accel * n.accel * dt : n.noImuAccel * n.noImuAccel * dt;
+    const double qh = useImu && m_headingValid ? qa : n.noImuAccel * n.noImuAccel * dt;
+    m_P[(V + 0) * N + V + 0] += qh;
+    m_P[(V + 1) * N + V + 1] += qh;
+    m_P[(V + 2) * N + V + 2] += qa;
+    if (useImu) {
+        for (int i = 0; i < 3; ++i) {
+            m_P[(TH + i) * N + TH + i] += n.gyro * n.gyro * dt;
+            m_P[(BA + i) * N + BA + i] += n.accelBias * n.accelBias * dt;
+            m_P[(BG + i) * N + BG + i] += n.gyroBias * n.gyroBias * dt;
+        }
+    }
+}
+
+// Kalman güncellemesi; H satır düzeninde rows x N, R köşegen.
+// Mahalanobis uzaklığı gate'i geçerse ölçüm reddedilir.
+bool NavFilter::update(const double *H, int rows, const double *y, const double *Rdiag, double gate)
+{
+    double PHt[N * 3] = {};
+    for (int i = 0; i < N; ++i)
+        for (int j = 0; j < rows; ++j) {
+            double s = 0.0;
+            for (int k = 0; k < N; ++k) s += m_P[i * N + k] * H[j * N + k];
+            PHt[i * rows + j] = s;
+        }
+    double S[9], Si[9];
+    for (int a = 0; a < rows; ++a)
+        for (int b = 0; b < rows; ++b) {
+            double s = a == b ? Rdiag[a] : 0.0;
+            for (int k = 0; k < N; ++k) s += H[a * N + k] * PHt[k * rows + b];
+            S[a * rows + b] = s;
+        }
+    double Sc[9];
+    std::copy(S, S + rows * rows, Sc);
+    if (!invert(Sc, rows, Si)) return false;
+
+    double d2 = 0.0;
+    for (int a = 0; a < rows; ++a)
+        for (int b = 0; b < rows; ++b) d2 += y[a] * Si[a * rows + b] * y[b];
+    if (gate > 0.0 && d2 > gate) return false;
+
+    double K[N * 3];
+    for (int i = 0; i < N; ++i)
+        for (int j = 0; j < rows; ++j) {
+            double s = 0.0;
+            for (int k = 0; k < rows; ++k) s += PHt[i * rows + k] * Si[k * rows + j];
+            K[i * rows + j] = s;
+        }
+
+    double dx[N];
+    for (int i = 0; i < N; ++i) {
+        double s = 0.0;
+        for (int j = 0; j < rows; ++j) s += K[i * rows + j] * y[j];
+        dx[i] = s;
+    }
+
+    // P = P - K S K^T (simetrik kalır)
+    for (int r = 0; r < N; ++r)
+        for (int c = r; c < N; ++c) {
+            double s = 0.0;
+            for (int a = 0; a < rows; ++a)
+                for (int b = 0; b < rows; ++b)
+                    s += K[r * rows + a] * S[a * rows + b] * K[c * rows + b];
+            m_P[r * N + c] -= s;
+            m_P[c * N + r] = m_P[r * N + c];
+        }
+
+    inject(dx);
+    return true;
+}
+
+void NavFilter::inject(const double *dx)
+{
+    for (int i = 0; i < 3; ++i) {
+        m_p[i] += dx[P + i];
+        m_v[i] += dx[V + i];
+        m_ba[i] = std::clamp(m_ba[i] + dx[BA + i], -MAX_ACCEL_BIAS, MAX_ACCEL_BIAS);
+        m_bg[i] = std::clamp(m_bg[i] + dx[BG + i], -MAX_GYRO_BIAS, MAX_GYRO_BIAS);
+    }
+    m_q = quatMul(m_q, quatExp(dx[TH], dx[TH + 1], dx[TH + 2]));
+    normalize(m_q);
+}
+
+// Burnun baktığı yön GPS rotasına çevrilir; yön hatası kovaryansı sıfırlanır
+void NavFilter::alignHeading(double course)
+{
+    double R[9];
+    rotation(R);
+    const double current = std::atan2(R[1], R[4]);      // gövde y ekseni, kuzeyden saat yönü
+    const double turn = -(course * DEG - current);       // ENU'da z etrafında, saat yönü tersi
+    m_q = quatMul(quatExp(0.0, 0.0, turn), m_q);
+    normalize(m_q);
+
+    for (int i = 0; i < N; ++i) {
+        m_P[(TH + 2) * N + i] = 0.0;
+        m_P[i * N + TH + 2] = 0.0;
+    }
+    m_P[(TH + 2) * N + TH + 2] = (10.0 * DEG) * (10.0 * DEG);
+    m_headingValid = true;
+}
+
+void NavFilter::imu(double t, const double acc[3], const double gyro[3])
+{
+    const Vec3 a{acc[0], acc[1], acc[2]}, w{gyro[0], gyro[1], gyro[2]};
+    m_lastAcc = a;
+    m_lastGyro = w;
+    m_hasAcc = true;
+
+    if (m_init && t > m_t) {
+        // Uzun boşluk sabit hızla geçilir; IMU sadece son MAX_DT için
+        double dt = t - m_t;
+        if (dt > MAX_DT) {
+            predict(dt - MAX_DT, a, w, false);
+            dt = MAX_DT;
+        }
+        predict(dt, a, w, true);
+        m_t = t;
+    }
+    m_lastImu = t;
+}
+
+void NavFilter::gps(double t, double lat, double lon, double alt, double speed)
+{
+    if (!m_init || m_rejected >= MAX_REJECTED) {
+        init(t, lat, lon, alt);
+        m_frame.toLocal(lat, lon, m_prevE, m_prevN);
+        m_hasPrevFix = true;
+        return;
+    }
+
+    if (t > m_t) {
+        const bool imuFresh = t - m_lastImu <= IMU_STALE;
+        predict(t - m_t, m_lastAcc, m_lastGyro, imuFresh && t - m_t <= MAX_DT);
+        m_t = t;
+    }
+
+    double e, n;
+    m_frame.toLocal(lat, lon, e, n);
+    const double u = alt - m_frame.alt0();
+
+    if (!m_headingValid && speed >= ALIGN_SPEED && m_hasPrevFix
+        && std::hypot(e - m_prevE, n - m_prevN) >= ALIGN_DIST) {
+        alignHeading(EnuFrame::bearing(e - m_prevE, n - m_prevN));
+    }
+    if (!m_hasPrevFix || std::hypot(e - m_prevE, n - m_prevN) >= ALIGN_DIST) {
+        m_prevE = e;
+        m_prevN = n;
+        m_hasPrevFix = true;
+    }
+
+    // Konum
+    double H[3 * N] = {};
+    for (int i = 0; i < 3; ++i) H[i * N + P + i] = 1.0;
+    const double y[3] = {e - m_p[0], n - m_p[1], u - m_p[2]};
+    const double R[3] = {m_noise.gpsH * m_noise.gpsH, m_noise.gpsH * m_noise.gpsH,
+                         m_noise.gpsV * m_noise.gpsV};
+    if (update(H, 3, y, R, GATE_POS)) {
+        m_rejected = 0;
+        m_lastGps = t;
+    } else {
+        ++m_rejected;
+        return;
+    }
+
+    // Yer hızı (büyüklük): h(v) = |v_yatay|
+    const double vh = std::hypot(m_v[0], m_v[1]);
+    if (speed >= MIN_SPEED_UPDATE && vh >= MIN_SPEED_UPDATE) {
+        double Hs[N] = {};
+        Hs[V + 0] = m_v[0] / vh;
+        Hs[V + 1] = m_v[1] / vh;
+        const double ys = speed - vh;
+        const double Rs = m_noise.gpsSpeed * m_noise.gpsSpeed;
+        update(Hs, 1, &ys, &Rs, GATE_SPEED);
+    }
+}
+
+NavFilter::State NavFilter::state(double t) const
+{
+    State s;
+    if (!m_init) return s;
+
+    const double dt = std::clamp(t - m_t, 0.0, MAX_EXTRAPOLATE);
+    s.valid = isValid(t);
+    s.east = m_p[0] + m_v[0] * dt;
+    s.north = m_p[1] + m_v[1] * dt;
+    s.up = m_p[2] + m_v[2] * dt;
+    s.vEast = m_v[0];
+    s.vNorth = m_v[1];
+    s.vUp = m_v[2];
+    m_frame.toGeo(s.east, s.north, s.lat, s.lon);
+    s.alt = m_frame.alt0() + s.up;
+    s.speed = std::hypot(m_v[0], m_v[1]);
+    s.course = EnuFrame::bearing(m_v[0], m_v[1]);
+    s.sigmaH = std::sqrt(std::max(0.0, m_P[0] + m_P[N + 1]));
+    s.sigmaV = std::sqrt(std::max(0.0, m_P[2 * N + 2]));
+    s.headingValid = m_headingValid;
+    return s;
+}
@@ -0,0 +1,314 @@
+#include "routeoptimizer.h"
+#include "geodesy.h"
+#include "parallel.h"
+
+#include <QElapsedTimer>
+#include <QMetaObject>
+#include <QMutex>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+static constexpr double EPS = 1e-6;             // m; sayısal gürültüyle döngüye girmesin
+static constexpr int OR_OPT_MAX = 3;            // taşınan en uzun parça
+static constexpr int MIN_STARTS = 8;
+
+namespace {
+
+// Düğümler: 0 = başlangıç bağlantısı, 1..m = serbest noktalar, m+1 = bitiş.
+// Bağlantı yoksa (açık uç) o düğümün tüm mesafeleri 0'dır.
+struct Matrix {
+    int n = 0;
+    std::vector<double> d;
+
+    double operator()(int a, int b) const { return d[size_t(a) * n + b]; }
+};
+
+Matrix buildMatrix(const QVector<GeoPoint> &pts, bool hasStart, bool hasEnd)
+{
+    Matrix m;
+    m.n = pts.size();
+    m.d.assign(size_t(m.n) * m.n, 0.0);
+
+    QVector<double> lat(m.n), lon(m.n), rowLat(m.n), rowLon(m.n);
+    for (int i = 0; i < m.n; ++i) {
+        lat[i] = pts[i].lat;
+        lon[i] = pts[i].lon;
+    }
+    for (int i = 0; i < m.n; ++i) {
+        if ((i == 0 && !hasStart) || (i == m.n - 1 && !hasEnd)) continue;
+        rowLat.fill(pts[i].lat);
+        rowLon.fill(pts[i].lon);
+        Geodesy::haversineBatch(rowLat.constData(), rowLon.constData(),
+                                lat.constData(), lon.constData(), &m.d[size_t(i) * m.n], m.n);
+    }
+    for (int i = 0; i < m.n; ++i) {
+        if (!hasStart) m.d[size_t(i) * m.n] = 0.0;
+        if (!hasEnd)   m.d[size_t(i) * m.n + m.n - 1] = 0.0;
+    }
+    return m;
+}
+
+double tourCost(const Matrix &d, const std::vector<int> &t)
+{
+    double c = 0.0;
+    for (size_t i = 1; i < t.size(); ++i)
+        c += d(t[i - 1], t[i]);
+    return c;
+}
+
+// Açgözlü kurulum; 'pick' > 1 ise en yakın 'pick' adaydan rastgele biri
+std::vector<int> nearestNeighbour(const Matrix &d, int pick, std::mt19937 &rng)
+{
+    const int n = d.n;
+    std::vector<int> tour;
+    tour.reserve(n);
+    tour.push_back(0);
+    std::vector<char> used(n, 0);
+    std::vector<std::pair<double, int>> cand;
+    for (int step = 1; step < n - 1; ++step) {
+        const int cur = tour.back();
+        cand.clear();
+        for (int j = 1; j < n - 1; ++j)
+            if (!used[j]) cand.emplace_back(d(cur, j), j);
+        const int k = std::min<int>(pick, cand.size());
+        std::partial_sort(cand.begin(), cand.begin() + k, cand.end());
+        const int next = cand[k > 1 ? int(rng() % k) : 0].second;
+        used[next] = 1;
+        tour.push_back(next);
+    }
+    tour.push_back(n - 1);
+    return tour;
+}
+
+// Segment [i, j] ters çevrilir; mesafeler simetrik
+bool twoOpt(const Matrix &d, std::vector<int> &t, const std::atomic<bool> *cancel)
+{
+    const int n = t.size();
+    bool improved = false;
+    for (int i = 1; i < n - 2; ++i) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) break;
+        for (int j = i + 1; j < n - 1; ++j) {
+            const int a = t[i - 1], b = t[i], c = t[j], e = t[j + 1];
+            const double delta = d(a, c) + d(b, e) - d(a, b) - d(c, e);
+            if (delta < -EPS) {
+                std::reverse(t.begin() + i, t.begin() + j + 1);
+                improved = true;
+            }
+        }
+    }
+    return improved;
+}
+
+// 1..3 noktalık parça başka bir kenarın arasına (gerekirse ters) taşınır
+bool orOpt(const Matrix &d, std::vector<int> &t, const std::atomic<bool> *cancel)
+{
+    const int n = t.size();
+    bool improved = false;
+    for (int len = 1; len <= OR_OPT_MAX; ++len) {
+        for (int i = 1; i + len < n; ++i) {
+            if (cancel && cancel->load(std::memory_order_relaxed)) return improved;
+            const int p = t[i - 1], s = t[i], e = t[i + len - 1], nx = t[i + len];
+            const double removeGain = d(p, s) + d(e, nx) - d(p, nx);
+            if (removeGain <= EPS) continue;
+
+            int bestK = -1;
+            bool bestRev = false;
+            double best = -EPS;
+            for (int k = 0; k < n - 1; ++k) {
+                if (k >= i - 1 && k <= i + len - 1) continue;   // parçanın kendi kenarları
+                const int u = t[k], v = t[k + 1];
+                const double fwd = d(u, s) + d(e, v) - d(u, v) - removeGain;
+                const double rev = d(u, e) + d(s, v) - d(u, v) - removeGain;
+                if (fwd < best) { best = fwd; bestK = k; bestRev = false; }
+                if (rev < best) { best = rev; bestK = k; bestRev = true; }
+            }
+            if (bestK < 0) continue;
+
+            std::vector<int> seg(t.begin() + i, t.begin() + i + len);
+            if (bestRev) std::reverse(seg.begin(), seg.end());
+            t.erase(t.begin() + i, t.begin() + i + len);
+            const int at = bestK < i ? bestK + 1 : bestK + 1 - len;
+            t.insert(t.begin() + at, seg.begin(), seg.end());
+            improved = true;
+        }
+    }
+    return improved;
+}
+
+}
+
+void RouteOptimizer::fixedEnds(const QVector<Waypoint> &wps, int &head, int &tail)
+{
+    const int n = wps.size();
+    head = 0;
+    while (head < n && (wps[head].command == MissionCommand::Takeoff
+                        || wps[head].command == MissionCommand::VtolTakeoff))
+        ++head;
+    tail = 0;
+    while (tail < n - head && (wps[n - 1 - tail].command == MissionCommand::Land
+                               || wps[n - 1 - tail].command == MissionCommand::VtolLand
+                               || wps[n - 1 - tail].command == MissionCommand::Rtl))
+        ++tail;
+}
+
+RouteOptimizer::Result RouteOptimizer::optimize(const QVector<Waypoint> &wps, const GeoPoint *home,
+                                                int starts, int threads,
+                                                const std::atomic<bool> *cancel,
+                                                const Progress &progress)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    Result r;
+    r.wps = wps;
+    r.order.resize(wps.size());
+    for (int i = 0; i < wps.size(); ++i) r.order[i] = i;
+
+    int head, tail;
+    fixedEnds(wps, head, tail);
+    const int m = wps.size() - head - tail;
+
+    // Bağlantılar: kalkış noktası ya da home; RTL'de home, iniş noktasında kendisi
+    GeoPoint startPt{0, 0}, endPt{0, 0};
+    bool hasStart = false, hasEnd = false;
+    if (head > 0) {
+        startPt = GeoPoint{wps[head - 1].lat, wps[head - 1].lon};
+        hasStart = true;
+    } else if (home) {
+        startPt = *home;
+        hasStart = true;
+    }
+    if (tail > 0) {
+        const Waypoint &last = wps[wps.size() - tail];
+        if (last.command != MissionCommand::Rtl) {
+            endPt = GeoPoint{last.lat, last.lon};
+            hasEnd = true;
+        } else if (home) {
+            endPt = *home;
+            hasEnd = true;
+        } else if (hasStart) {
+            endPt = startPt;
+            hasEnd = true;
+        }
+    }
+
+    QVector<GeoPoint> pts(m + 2);
+    pts[0] = startPt;
+    pts[m + 1] = endPt;
+    for (int i = 0; i < m; ++i)
+        pts[i + 1] = GeoPoint{wps[head + i].lat, wps[head + i].lon};
+    const Matrix d = buildMatrix(pts, hasStart, hasEnd);
+
+    std::vector<int> identity(m + 2);
+    for (int i = 0; i < m + 2; ++i) identity[i] = i;
+    r.before = r.after = tourCost(d, identity);
+    if (m < 3) {
+        r.elapsedMs = timer.elapsed();
+        return r;
+    }
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int workers = threads > 0 ? threads : pool->maxThreadCount();
+    if (starts <= 0) starts = qMax(MIN_STARTS, 2 * workers);
+
+    // Başlangıçlar iş kuyruğu gibi dağıtılır; çağıran thread da çalışır
+    QMutex mutex;
+    std::vector<int> best = identity;
+    double bestCost = r.before;
+    int bestStart = -1;
+    std::atomic<int> done{0};
+
+    parallelFor(starts, 1, workers, [&](int from, int to) {
+        for (int s = from; s < to; ++s) {
+            if (cancel && cancel->load(std::memory_order_relaxed)) break;
+
+            std::mt19937 rng(7919u * unsigned(s) + 1u);
+            std::vector<int> t = s == 1 ? identity : nearestNeighbour(d, s == 0 ? 1 : 3, rng);
+            bool improved = true;
+            while (improved && !(cancel && cancel->load(std::memory_order_relaxed))) {
+                improved = twoOpt(d, t, cancel);
+                improved |= orOpt(d, t, cancel);
+            }
+            const double c = tourCost(d, t);
+
+            QMutexLocker lock(&mutex);
+            if (c < bestCost - EPS || (c <= bestCost + EPS && bestStart >= 0 && s < bestStart)) {
+                bestCost = c;
+                best = std::move(t);
+                bestStart = s;
+            }
+            const int finished = ++done;
+            lock.unlock();
+            if (progress) progress(finished, starts);
+        }
+    });
+
+    r.starts = done.load();
+    r.cancelled = cancel && cancel->load();
+    r.after = bestCost;
+    for (int i = 0; i < m; ++i) {
+        const int from = head + best[i + 1] - 1;
+        r.order[head + i] = from;
+        r.wps[head + i] = wps[from];
+    }
+    r.elapsedMs = timer.elapsed();
+    return r;
+}
+
+RouteOptimizer::RouteOptimizer(QObject *parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(1);    // başlangıçlar zaten global havuzda paralel
+}
+
+RouteOptimizer::~RouteOptimizer()
+{
+    cancel();
+    m_pool.waitForDone();
+}
+
+// İş sadece kendi kopyalarına dokunur; sonuç this'e kuyrukla gelir. this işten
+// uzun yaşar (yıkıcı bekler), silinirken bekleyen olayları Qt atar.
+void RouteOptimizer::start(const QVector<Waypoint> &wps, const GeoPoint *home, int starts)
+{
+    cancel();
+    auto flag = std::make_shared<std::atomic<bool>>(false);
+    m_cancel = flag;
+    m_running = true;
+
+    const bool hasHome = home != nullptr;
+    const GeoPoint homePt = hasHome ? *home : GeoPoint{0, 0};
+
+    m_pool.start([this, flag, wps, hasHome, homePt, starts]() {
+        auto report = [this, flag](int done, int total) {
+            QMetaObject::invokeMethod(this, [this, flag, done, total]() {
+                if (m_cancel == flag)
+                    emit progress(done, total);
+            }, Qt::QueuedConnection);
+        };
+        const Result r = optimize(wps, hasHome ? &homePt : nullptr, starts, 0, flag.get(), report);
+
+        QMetaObject::invokeMethod(this, [this, flag, r]() {
+            if (m_cancel != flag) return;   // daha yeni bir iş başladı
+            m_running = false;
+            emit finished(r);
+        }, Qt::QueuedConnection);
+    });
+}
+
+// Çalışan başlangıçlar bir sonraki kontrol noktasında durur; o ana kadarki
+// en iyi sıra yine finished() ile gelir
+void RouteOptimizer::cancel()
+{
+    if (m_cancel) m_cancel->store(true);
+}
+
+void RouteOptimizer::discard()
+{
+    cancel();
+    m_cancel.reset();
+    m_running = false;
+}
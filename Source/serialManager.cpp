@@ -110,6 +110,17 @@ bool SerialManager::send(const QString &portName, const QString &message)
     return true;
 }
 
+bool SerialManager::write(const QByteArray &data)
+{
+    if (!m_serial->isOpen()) return false;
+
+    if (m_serial->write(data) < 0) {
+        emit errorOccurred(m_serial->portName(), m_serial->errorString());
+        return false;
+    }
+    return true;
+}
+
 QString SerialManager::receive(const QString &portName)
 {
     if (!ensureConnectedTo(portName)) {
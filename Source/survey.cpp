@@ -0,0 +1,111 @@
+#include "survey.h"
+#include "enuframe.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+static constexpr double DEG = M_PI / 180.0;
+
+// Minimum hat aralığı; saçma girişte milyonlarca hat üretmeyelim
+static constexpr double MIN_LINE_SPACING = 0.5;
+
+namespace {
+
+struct Vec2 {
+    double x;
+    double y;
+};
+
+}
+
+double Survey::lineSpacing(const SurveyParams &params)
+{
+    const double overlap = std::clamp(params.overlap, 0.0, 95.0) / 100.0;
+    return std::max(MIN_LINE_SPACING, params.spacing * (1.0 - overlap));
+}
+
+QVector<Waypoint> Survey::generate(const QVector<GeoPoint> &polygon, const SurveyParams &params)
+{
+    QVector<Waypoint> out;
+    const int n = polygon.size();
+    if (n < 3) return out;
+
+    // Yerel ENU: poligon merkezinde teğet düzlem
+    double lat0 = 0.0, lon0 = 0.0;
+    for (const GeoPoint &g : polygon) {
+        lat0 += g.lat;
+        lon0 += g.lon;
+    }
+    const EnuFrame frame(lat0 / n, lon0 / n);
+
+    // Hat yönü h = (sin θ, cos θ). u: hat boyunca, v: hatlara dik
+    const double s = std::sin(params.heading * DEG);
+    const double c = std::cos(params.heading * DEG);
+
+    std::vector<Vec2> uv(n);
+    double vMin = 1e300, vMax = -1e300;
+    for (int i = 0; i < n; ++i) {
+        double e, nn;
+        frame.toLocal(polygon[i].lat, polygon[i].lon, e, nn);
+        uv[i] = { e * s + nn * c, e * c - nn * s };
+        vMin = std::min(vMin, uv[i].y);
+        vMax = std::max(vMax, uv[i].y);
+    }
+
+    const double step = lineSpacing(params);
+    const int lines = int(std::floor((vMax - vMin) / step)) + 1;
+
+    auto addPoint = [&](double u, double v) {
+        const double e = u * s + v * c;
+        const double nn = u * c - v * s;
+
+        Waypoint wp{};
+        frame.toGeo(e, nn, wp.lat, wp.lon);
+        wp.alt = params.altitude;
+        wp.radius = params.radius;
+        wp.command = MissionCommand::Waypoint;
+        out.push_back(wp);
+    };
+
+    std::vector<double> xs;
+    xs.reserve(16);
+    out.reserve(lines * 2);
+
+    for (int k = 0; k < lines; ++k) {
+        // İlk hat kenardan yarım aralık içeride
+        const double v = vMin + step * 0.5 + k * step;
+        if (v > vMax) break;
+
+        xs.clear();
+        for (int i = 0; i < n; ++i) {
+            const Vec2 &a = uv[i];
+            const Vec2 &b = uv[(i + 1) % n];
+            if (a.y == b.y) continue;
+            // yarı açık aralık: köşeler iki kez sayılmasın
+            if ((v >= a.y && v < b.y) || (v >= b.y && v < a.y)) {
+                const double t = (v - a.y) / (b.y - a.y);
+                xs.push_back(a.x + t * (b.x - a.x));
+            }
+        }
+        if (xs.size() < 2) continue;
+        std::sort(xs.begin(), xs.end());
+
+        const int pairs = int(xs.size() / 2);
+        const bool forward = (k % 2) == 0;
+        for (int j = 0; j < pairs; ++j) {
+            const int p = forward ? j : pairs - 1 - j;
+            const double u0 = xs[2 * p];
+            const double u1 = xs[2 * p + 1];
+            if (forward) {
+                addPoint(u0, v);
+                addPoint(u1, v);
+            } else {
+                addPoint(u1, v);
+                addPoint(u0, v);
+            }
+        }
+    }
+
+    return out;
+}
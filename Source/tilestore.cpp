@@ -0,0 +1,114 @@
+#include "tilestore.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QNetworkAccessManager>
+#include <QNetworkDiskCache>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QStandardPaths>
+#include <QUrl>
+
+static const char *TILE_URL =
+    "https://server.arcgisonline.com/ArcGIS/rest/services/World_Imagery/MapServer/tile/%1/%2/%3";
+
+static constexpr qint64 RETRY_AFTER_MS = 30000;
+
+TileStore::TileStore(QObject *parent)
+    : QObject(parent),
+    m_net(new QNetworkAccessManager(this))
+{
+    const QString cachePath =
+        QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)
+        + "/tile_cache";
+    QDir().mkpath(cachePath);
+
+    auto *disk = new QNetworkDiskCache(this);
+    disk->setCacheDirectory(cachePath);
+    disk->setMaximumCacheSize(500 * 1024 * 1024);
+    m_net->setCache(disk);
+
+    m_memory.setMaxCost(192 * 1024);    // ~192 MB çözülmüş karo
+}
+
+TileStore::~TileStore()
+{
+    m_pool.waitForDone();
+}
+
+bool TileStore::contains(int z, int x, int y) const
+{
+    return m_memory.contains(key(z, x, y));
+}
+
+QImage TileStore::tile(int z, int x, int y)
+{
+    if (QImage *img = m_memory.object(key(z, x, y)))
+        return *img;
+
+    request(z, x, y);
+    return QImage();
+}
+
+void TileStore::request(int z, int x, int y)
+{
+    const int n = 1 << z;
+    if (z < 0 || z > MAX_NATIVE_ZOOM || x < 0 || y < 0 || x >= n || y >= n)
+        return;
+
+    const quint64 k = key(z, x, y);
+    if (m_memory.contains(k) || m_pending.contains(k))
+        return;
+
+    const auto failed = m_failedAt.constFind(k);
+    if (failed != m_failedAt.constEnd()
+        && QDateTime::currentMSecsSinceEpoch() - failed.value() < RETRY_AFTER_MS)
+        return;
+
+    m_pending.insert(k);
+
+    QNetworkRequest req(QUrl(QString(TILE_URL).arg(z).arg(y).arg(x)));
+    req.setAttribute(QNetworkRequest::CacheLoadControlAttribute,
+                     QNetworkRequest::PreferCache);
+    req.setHeader(QNetworkRequest::UserAgentHeader, "Kuzgun");
+
+    QNetworkReply *reply = m_net->get(req);
+    connect(reply, &QNetworkReply::finished, this, [this, reply, k, z, x, y]() {
+        reply->deleteLater();
+
+        if (reply->error() != QNetworkReply::NoError) {
+            qDebug() << "Tile error" << z << x << y << reply->errorString();
+            m_pending.remove(k);
+            m_failedAt.insert(k, QDateTime::currentMSecsSinceEpoch());
+            return;
+        }
+
+        const QByteArray data = reply->readAll();
+
+        // Çözme + format dönüşümü arka planda; this işten uzun yaşar (yıkıcı bekler)
+        m_pool.start([this, data, k, z, x, y]() {
+            QImage img = QImage::fromData(data);
+            if (!img.isNull())
+                img = img.convertToFormat(QImage::Format_RGB32);
+
+            QMetaObject::invokeMethod(this, [this, img, k, z, x, y]() {
+                onDecoded(k, z, x, y, img);
+            }, Qt::QueuedConnection);
+        });
+    });
+}
+
+void TileStore::onDecoded(quint64 k, int z, int x, int y, const QImage &img)
+{
+    m_pending.remove(k);
+
+    if (img.isNull()) {
+        m_failedAt.insert(k, QDateTime::currentMSecsSinceEpoch());
+        return;
+    }
+
+    m_failedAt.remove(k);
+    m_memory.insert(k, new QImage(img), int(img.sizeInBytes() / 1024));
+    emit tileReady(z, x, y);
+}
@@ -0,0 +1,46 @@
+// FlightPath::compute: uzun görevde yaylı rota, seri ve QThreadPool ile.
+//
+//   cmake -S . -B build -DKUZGUN_BUILD_BENCHMARKS=ON
+//   cmake --build build --target bench_flightpath && ./build/bench/bench_flightpath [waypoints]
+
+#include "flightpath.h"
+#include "benchutil.h"
+
+#include <QThreadPool>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+int main(int argc, char **argv)
+{
+    const int n = argc > 1 ? std::atoi(argv[1]) : 200000;
+    const int runs = 5;
+
+    std::mt19937_64 rng(5);
+    std::uniform_real_distribution<double> dStep(-0.004, 0.004), dRadius(20.0, 120.0);
+
+    QVector<Waypoint> wps(n);
+    double lat = 40.8, lon = 29.3;
+    for (Waypoint &wp : wps) {
+        lat = qBound(40.3, lat + dStep(rng), 41.3);
+        lon = qBound(28.8, lon + dStep(rng), 29.8);
+        wp = Waypoint{};
+        wp.lat = lat;
+        wp.lon = lon;
+        wp.alt = 80.0f;
+        wp.radius = float(dRadius(rng));
+    }
+
+    FlightPath::Path serial, parallel;
+    const double tSerial = bestOfMs(runs, [&]{ serial = FlightPath::compute(wps, 1.0, 1); });
+    const double tParallel = bestOfMs(runs, [&]{ parallel = FlightPath::compute(wps, 1.0, 0); });
+
+    std::printf("waypoints: %d, threads: %d\n", n, QThreadPool::globalInstance()->maxThreadCount());
+    std::printf("serial   : %8.2f ms  (%lld points)\n", tSerial, (long long)serial.points.size());
+    std::printf("parallel : %8.2f ms  (%.2fx)\n", tParallel, tSerial / tParallel);
+    std::printf("straight : %.1f km, flown: %.1f km, tight turns: %d\n",
+                serial.straightLength / 1000.0, serial.length / 1000.0, serial.tightTurns);
+    return serial.points.size() == parallel.points.size() ? 0 : 1;
+}
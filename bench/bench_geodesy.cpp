@@ -0,0 +1,113 @@
+// Geodesy batch çekirdeklerini FlightController::haversineMeters'ın eski
+// skaler haliyle karşılaştırır. Doğruluk farkını da yazar.
+//
+//   cmake -S . -B build -DKUZGUN_BUILD_BENCHMARKS=ON
+//   cmake --build build --target bench_geodesy && ./build/bench/bench_geodesy [n]
+
+#include "geodesy.h"
+#include "benchutil.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// FlightController::haversineMeters (önceki hali), birebir
+static double deg2rad(double d) { return d * M_PI / 180.0; }
+
+static double legacyHaversine(double lat1, double lon1, double lat2, double lon2)
+{
+    const double R = 6371000.0; // metre
+    const double dLat = deg2rad(lat2 - lat1);
+    const double dLon = deg2rad(lon2 - lon1);
+
+    const double a =
+        std::sin(dLat/2)*std::sin(dLat/2) +
+        std::cos(deg2rad(lat1))*std::cos(deg2rad(lat2)) *
+            std::sin(dLon/2)*std::sin(dLon/2);
+
+    const double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1-a));
+    return R * c;
+}
+
+static double maxAbsDiff(const std::vector<double> &a, const std::vector<double> &b)
+{
+    double m = 0.0;
+    for (size_t i = 0; i < a.size(); ++i)
+        m = std::max(m, std::fabs(a[i] - b[i]));
+    return m;
+}
+
+int main(int argc, char **argv)
+{
+    const int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int runs = 5;
+
+    // Görev ölçeğinde noktalar: bir merkez etrafında ±0.5 derece
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> dLat(40.3, 41.3), dLon(28.8, 29.8);
+    std::uniform_real_distribution<double> dBrg(0.0, 360.0), dDist(0.0, 20000.0), dAlt(0.0, 500.0);
+
+    std::vector<double> lat1(n), lon1(n), lat2(n), lon2(n), brg(n), dist(n), alt(n);
+    for (int i = 0; i < n; ++i) {
+        lat1[i] = dLat(rng); lon1[i] = dLon(rng);
+        lat2[i] = dLat(rng); lon2[i] = dLon(rng);
+        brg[i] = dBrg(rng);  dist[i] = dDist(rng); alt[i] = dAlt(rng);
+    }
+
+    std::vector<double> ref(n), out(n), out2(n), out3(n);
+    volatile double sink = 0.0;
+
+    std::printf("n = %d, best of %d runs\n\n", n, runs);
+
+    const double tLegacy = bestOfMs(runs, [&] {
+        for (int i = 0; i < n; ++i)
+            ref[i] = legacyHaversine(lat1[i], lon1[i], lat2[i], lon2[i]);
+        sink = sink + ref[n / 2];
+    });
+    std::printf("%-34s %9.2f ms\n", "haversine legacy (member fn)", tLegacy);
+
+    for (Geodesy::Kernel k : {Geodesy::Kernel::Scalar, Geodesy::Kernel::Avx2}) {
+        Geodesy::forceKernel(k);
+        if (Geodesy::activeKernel() != k) {
+            std::printf("\n[%s not supported on this CPU]\n", k == Geodesy::Kernel::Avx2 ? "avx2" : "scalar");
+            continue;
+        }
+        const char *name = Geodesy::kernelName();
+        std::printf("\n-- kernel: %s\n", name);
+
+        const double tH = bestOfMs(runs, [&] {
+            Geodesy::haversineBatch(lat1.data(), lon1.data(), lat2.data(), lon2.data(), out.data(), n);
+        });
+        std::printf("%-34s %9.2f ms  x%.1f  max|err| %.3g m\n",
+                    "haversineBatch", tH, tLegacy / tH, maxAbsDiff(out, ref));
+
+        const double tB = bestOfMs(runs, [&] {
+            Geodesy::bearingBatch(lat1.data(), lon1.data(), lat2.data(), lon2.data(), out.data(), n);
+        });
+        std::printf("%-34s %9.2f ms\n", "bearingBatch", tB);
+
+        const double tD = bestOfMs(runs, [&] {
+            Geodesy::destinationBatch(lat1.data(), lon1.data(), brg.data(), dist.data(),
+                                      out.data(), out2.data(), n);
+        });
+        std::printf("%-34s %9.2f ms\n", "destinationBatch", tD);
+
+        const double tE = bestOfMs(runs, [&] {
+            Geodesy::enuBatch(40.8, 29.3, 0.0, lat1.data(), lon1.data(), alt.data(),
+                              out.data(), out2.data(), out3.data(), n);
+        });
+        std::printf("%-34s %9.2f ms\n", "enuBatch", tE);
+    }
+
+    // Vincenty yinelemeli ve skaler; sadece bilgi için küçük bir alt kümede
+    const int nv = std::min(n, 100000);
+    const double tV = bestOfMs(1, [&] {
+        Geodesy::vincentyBatch(lat1.data(), lon1.data(), lat2.data(), lon2.data(), out.data(), nv);
+    });
+    std::printf("\n%-34s %9.2f ms  (n = %d)\n", "vincentyBatch (scalar)", tV, nv);
+
+    return sink == 12345.0;
+}
@@ -0,0 +1,117 @@
+// Geofence: binlerce köşeli bir dış sınır + yasak bölgeler. Izgara kurulumu,
+// tek nokta sorgusu ve ileriye bakışlı fix güncellemesi ölçülür. Karşılaştırma
+// için her fix'te tüm kenarları tarayan düz ışın testi.
+//
+//   cmake -S . -B build -DKUZGUN_BUILD_BENCHMARKS=ON
+//   cmake --build build --target bench_geofence && ./build/bench/bench_geofence [vertices] [zones]
+
+#include "geofence.h"
+#include "benchutil.h"
+
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+static bool pointInRing(const QVector<GeoPoint> &ring, double lat, double lon)
+{
+    bool in = false;
+    for (int i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+        if ((ring[i].lat > lat) != (ring[j].lat > lat)
+            && lon < (ring[j].lon - ring[i].lon) * (lat - ring[i].lat) / (ring[j].lat - ring[i].lat) + ring[i].lon)
+            in = !in;
+    }
+    return in;
+}
+
+int main(int argc, char **argv)
+{
+    const int vertices = argc > 1 ? std::atoi(argv[1]) : 5000;
+    const int zoneCount = argc > 2 ? std::atoi(argv[2]) : 50;
+    const int fixes = 100000;
+    const int runs = 5;
+
+    std::mt19937_64 rng(13);
+    std::uniform_real_distribution<double> dJitter(0.9, 1.0), dLat(40.6, 41.0), dLon(29.1, 29.5);
+
+    // Dış sınır: girintili çıkıntılı çember; içinde küçük yasak bölgeler
+    QVector<MissionValidator::Zone> zones;
+    MissionValidator::Zone fence;
+    fence.inclusion = true;
+    for (int i = 0; i < vertices; ++i) {
+        const double a = 2.0 * M_PI * i / vertices, r = 0.25 * dJitter(rng);
+        fence.ring.append(GeoPoint{40.8 + r * std::sin(a), 29.3 + r * std::cos(a)});
+    }
+    zones.append(fence);
+    for (int z = 0; z < zoneCount; ++z) {
+        MissionValidator::Zone nf;
+        const double lat = dLat(rng), lon = dLon(rng);
+        const int k = qMax(3, vertices / 50);
+        for (int i = 0; i < k; ++i) {
+            const double a = 2.0 * M_PI * i / k, r = 0.01 * dJitter(rng);
+            nf.ring.append(GeoPoint{lat + r * std::sin(a), lon + r * std::cos(a)});
+        }
+        zones.append(nf);
+    }
+    int edges = 0;
+    for (const MissionValidator::Zone &z : std::as_const(zones)) edges += z.ring.size();
+
+    // Uçuş izi: 20 m/s, 5 Hz, yumuşak dönüşler
+    QVector<GeoPoint> track(fixes);
+    double lat = 40.8, lon = 29.3, heading = 0.0;
+    std::normal_distribution<double> dTurn(0.0, 0.05);
+    for (GeoPoint &p : track) {
+        heading += dTurn(rng);
+        lat += 4.0 * std::cos(heading) / 111320.0;
+        lon += 4.0 * std::sin(heading) / (111320.0 * std::cos(qDegreesToRadians(lat)));
+        if (std::abs(lat - 40.8) > 0.3 || std::abs(lon - 29.3) > 0.3) { lat = 40.8; lon = 29.3; }
+        p = GeoPoint{lat, lon};
+    }
+
+    std::printf("edges = %d, zones = %d, fixes = %d, best of %d runs\n\n",
+                edges, zones.size(), fixes, runs);
+
+    Geofence g;
+    const double tBuild = bestOfMs(runs, [&] { g.setZones(zones); });
+
+    int breaches = 0;
+    const double tCheck = bestOfMs(runs, [&] {
+        breaches = 0;
+        for (const GeoPoint &p : std::as_const(track))
+            breaches += g.check(p.lat, p.lon).breach != Geofence::None;
+    });
+
+    int warnings = 0;
+    const double tUpdate = bestOfMs(runs, [&] {
+        warnings = 0;
+        g.resetTrack();
+        for (const GeoPoint &p : std::as_const(track))
+            warnings += g.update(p.lat, p.lon, 20.0).aheadSeconds >= 0;
+    });
+
+    // Düz tarama: her fix'te tüm bölgelerin tüm kenarları
+    const int scanFixes = fixes / 100;
+    int scanBreaches = 0;
+    const double tScan = bestOfMs(1, [&] {
+        scanBreaches = 0;
+        for (int i = 0; i < scanFixes; ++i) {
+            bool inFence = false, inNoFly = false;
+            for (const MissionValidator::Zone &z : std::as_const(zones)) {
+                const bool in = pointInRing(z.ring, track[i].lat, track[i].lon);
+                (z.inclusion ? inFence : inNoFly) |= in;
+            }
+            scanBreaches += inNoFly || !inFence;
+        }
+    });
+
+    std::printf("%-28s %10.2f ms\n", "grid build", tBuild);
+    std::printf("%-28s %10.3f us  (%d breaches)\n", "check (avg)", tCheck * 1000.0 / fixes, breaches);
+    std::printf("%-28s %10.3f us  (%d look-ahead warnings)\n", "update + look-ahead (avg)",
+                tUpdate * 1000.0 / fixes, warnings);
+    std::printf("%-28s %10.3f us  (%d of %d breaches)\n", "brute-force scan (avg)",
+                tScan * 1000.0 / scanFixes, scanBreaches, scanFixes);
+    return 0;
+}
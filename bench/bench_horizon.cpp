@@ -0,0 +1,68 @@
+// Yapay ufuk: kare başına paintEvent süresi. Eski yol (clip path + merdivenin
+// tamamı her karede) ile önceden çizilmiş katmanların döndürülmüş blit'i.
+// Ekran yok, QImage'a render edilir; DPR denemek için QT_SCALE_FACTOR=2.
+//
+//   cmake -S . -B build -DKUZGUN_BUILD_BENCHMARKS=ON
+//   cmake --build build --target bench_horizon && ./build/bench/bench_horizon [width] [height]
+
+#include "HorizonWidget.h"
+#include "benchutil.h"
+
+#include <QApplication>
+#include <QImage>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char **argv)
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+
+    const int width = argc > 1 ? std::atoi(argv[1]) : 400;
+    const int height = argc > 2 ? std::atoi(argv[2]) : 300;
+    const int frames = 2000;
+    const int runs = 5;
+
+    HorizonWidget w;
+    w.resize(width, height);
+    const qreal dpr = w.devicePixelRatioF();
+    QImage target(w.size() * dpr, QImage::Format_ARGB32_Premultiplied);
+    target.setDevicePixelRatio(dpr);
+
+    // Her karede farklı tutum: ±35° roll, ±20° pitch salınımı
+    auto renderFrames = [&] {
+        for (int i = 0; i < frames; ++i) {
+            w.setAttitude(35.0 * std::sin(i * 0.013), 20.0 * std::sin(i * 0.007));
+            w.render(&target, QPoint(), QRegion(), QWidget::RenderFlags());
+        }
+    };
+
+    std::printf("%d x %d px, dpr = %.2f, frames = %d, best of %d runs\n\n",
+                width, height, dpr, frames, runs);
+
+    w.setLayerCache(false);
+    const double tDirect = bestOfMs(runs, renderFrames);
+
+    w.setLayerCache(true);
+    w.render(&target, QPoint(), QRegion(), QWidget::RenderFlags());     // katmanlar hazır
+    const double tCached = bestOfMs(runs, renderFrames);
+
+    // Boyut değişince katmanlar yeniden çizilir (ilk kare)
+    const int resizes = 50;
+    const double tRebuild = bestOfMs(runs, [&] {
+        for (int i = 0; i < resizes; ++i) {
+            w.resize(width + (i & 1), height);
+            w.render(&target, QPoint(), QRegion(), QWidget::RenderFlags());
+        }
+    });
+
+    std::printf("%-28s %10.3f us\n", "direct paint (per frame)", tDirect * 1000.0 / frames);
+    std::printf("%-28s %10.3f us  (x%.1f)\n", "cached layers (per frame)",
+                tCached * 1000.0 / frames, tDirect / tCached);
+    std::printf("%-28s %10.3f us\n", "resize + rebuild", tRebuild * 1000.0 / resizes);
+    return 0;
+}
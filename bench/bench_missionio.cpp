@@ -0,0 +1,119 @@
+// MissionIO okuma/yazma süreleri. .plan için QJsonDocument (DOM) ile
+// karşılaştırır; dosyadan okuma QFile::map yolunu ölçer.
+//
+//   cmake -S . -B build -DKUZGUN_BUILD_BENCHMARKS=ON
+//   cmake --build build --target bench_missionio && ./build/bench/bench_missionio [n]
+
+#include "missionio.h"
+#include "benchutil.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+// Eski yol olsaydı: tüm belge ağacı, sonra items üzerinde gezinme
+static int domPlanCount(const QByteArray &bytes)
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(bytes);
+    const QJsonArray items = doc.object().value("mission").toObject().value("items").toArray();
+    int n = 0;
+    for (const QJsonValue &v : items) {
+        const QJsonArray p = v.toObject().value("params").toArray();
+        n += p.size() == 7 && p[4].toDouble() != 0.0;
+    }
+    return n;
+}
+
+static bool sameMission(const QVector<Waypoint> &a, const QVector<Waypoint> &b)
+{
+    if (a.size() != b.size()) return false;
+    for (int i = 0; i < a.size(); ++i) {
+        if (std::abs(a[i].lat - b[i].lat) > 1e-6 || std::abs(a[i].lon - b[i].lon) > 1e-6
+            || std::abs(a[i].alt - b[i].alt) > 0.01f || a[i].command != b[i].command)
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    const int n = argc > 1 ? std::atoi(argv[1]) : 50000;
+    const int runs = 5;
+
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> dLat(40.3, 41.3), dLon(28.8, 29.8), dAlt(20.0, 200.0);
+    std::uniform_int_distribution<int> dCmd(0, int(MissionCommand::Count) - 1);
+
+    QVector<Waypoint> wps(n);
+    for (Waypoint &wp : wps) {
+        wp.lat = dLat(rng);
+        wp.lon = dLon(rng);
+        wp.alt = float(dAlt(rng));
+        wp.radius = 50.0f;
+        wp.command = MissionCommand(dCmd(rng));
+    }
+
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        std::printf("temp dir failed\n");
+        return 1;
+    }
+
+    std::printf("n = %d waypoints, best of %d runs\n\n", n, runs);
+    std::printf("%-8s %10s %12s %12s %12s %s\n", "format", "size KB", "write ms", "parse ms", "load ms", "round-trip");
+
+    struct Case {
+        const char *name;
+        const char *file;
+        QByteArray (*write)(const QVector<Waypoint> &);
+        bool (*parse)(QByteArrayView, QVector<Waypoint> &, QString *);
+    };
+    const Case cases[] = {
+        {"plan", "m.plan", MissionIO::writePlan, MissionIO::parsePlan},
+        {"kml",  "m.kml",  MissionIO::writeKml,  MissionIO::parseKml},
+        {"gpx",  "m.gpx",
+         [](const QVector<Waypoint> &w) { return MissionIO::writeGpx(w); },
+         [](QByteArrayView d, QVector<Waypoint> &o, QString *e) { return MissionIO::parseGpx(d, o, e); }},
+    };
+
+    QByteArray planBytes;
+    for (const Case &c : cases) {
+        QByteArray bytes;
+        const double tWrite = bestOfMs(runs, [&] { bytes = c.write(wps); });
+        if (c.write == MissionIO::writePlan) planBytes = bytes;
+
+        QVector<Waypoint> parsed;
+        const double tParse = bestOfMs(runs, [&] {
+            parsed.clear();
+            c.parse(bytes, parsed, nullptr);
+        });
+
+        const QString path = dir.filePath(c.file);
+        QFile f(path);
+        if (!f.open(QIODevice::WriteOnly) || f.write(bytes) != bytes.size()) {
+            std::printf("write %s failed\n", c.file);
+            return 1;
+        }
+        f.close();
+
+        QVector<Waypoint> loaded;
+        const double tLoad = bestOfMs(runs, [&] { MissionIO::load(path, loaded); });
+
+        std::printf("%-8s %10.0f %12.2f %12.2f %12.2f %s\n", c.name, bytes.size() / 1024.0,
+                    tWrite, tParse, tLoad,
+                    sameMission(parsed, wps) && sameMission(loaded, wps) ? "ok" : "MISMATCH");
+    }
+
+    int domCount = 0;
+    const double tDom = bestOfMs(runs, [&] { domCount = domPlanCount(planBytes); });
+    std::printf("\n%-34s %9.2f ms  (%d items)\n", "plan via QJsonDocument (DOM)", tDom, domCount);
+
+    return 0;
+}
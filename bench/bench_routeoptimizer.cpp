@@ -0,0 +1,55 @@
+// RouteOptimizer: rastgele tıklanmış denetim noktaları, kalkış ve iniş sabit.
+// Aynı sayıda başlangıç seri ve QThreadPool ile çalıştırılır.
+//
+//   cmake -S . -B build -DKUZGUN_BUILD_BENCHMARKS=ON
+//   cmake --build build --target bench_routeoptimizer && ./build/bench/bench_routeoptimizer [points] [starts]
+
+#include "routeoptimizer.h"
+
+#include <QThreadPool>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+static double runMs(const QVector<Waypoint> &wps, int starts, int threads, RouteOptimizer::Result &r)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    r = RouteOptimizer::optimize(wps, nullptr, starts, threads);
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+int main(int argc, char **argv)
+{
+    const int points = argc > 1 ? std::atoi(argv[1]) : 300;
+    const int starts = argc > 2 ? std::atoi(argv[2]) : 16;
+
+    std::mt19937_64 rng(3);
+    std::uniform_real_distribution<double> dLat(40.80, 40.83), dLon(29.30, 29.34);
+
+    QVector<Waypoint> wps(points + 2);
+    for (Waypoint &wp : wps) {
+        wp = Waypoint{};
+        wp.lat = dLat(rng);
+        wp.lon = dLon(rng);
+        wp.alt = 60.0f;
+        wp.radius = 50.0f;
+        wp.command = MissionCommand::Waypoint;
+    }
+    wps.first().command = MissionCommand::Takeoff;
+    wps.last().command = MissionCommand::Land;
+
+    RouteOptimizer::Result serial, parallel;
+    const double tSerial = runMs(wps, starts, 1, serial);
+    const double tParallel = runMs(wps, starts, 0, parallel);
+
+    std::printf("points: %d, starts: %d, threads: %d\n",
+                points, starts, QThreadPool::globalInstance()->maxThreadCount());
+    std::printf("insertion order : %8.0f m\n", serial.before);
+    std::printf("serial          : %8.0f m  %8.1f ms\n", serial.after, tSerial);
+    std::printf("parallel        : %8.0f m  %8.1f ms  (%.2fx)\n",
+                parallel.after, tParallel, tSerial / tParallel);
+    return 0;
+}
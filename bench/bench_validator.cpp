@@ -0,0 +1,92 @@
+// MissionValidator: 10k bacak x 10k yasak bölge. R-ağacı kurulumu, tüm görevin
+// doğrulanması ve tek satır düzenlemesinden sonraki artımlı kontrol ölçülür.
+// Karşılaştırma için her bacağı her bölge kutusuyla deneyen düz tarama.
+//
+//   cmake -S . -B build -DKUZGUN_BUILD_BENCHMARKS=ON
+//   cmake --build build --target bench_validator && ./build/bench/bench_validator [legs] [zones]
+
+#include "missionvalidator.h"
+#include "benchutil.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+int main(int argc, char **argv)
+{
+    const int legs = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const int zoneCount = argc > 2 ? std::atoi(argv[2]) : 10000;
+    const int runs = 5;
+
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> dLat(40.3, 41.3), dLon(28.8, 29.8);
+    std::uniform_real_distribution<double> dSize(0.001, 0.005), dStep(-0.004, 0.004), dAlt(20.0, 110.0);
+
+    // Küçük dörtgen/altıgen yasak bölgeler
+    QVector<MissionValidator::Zone> zones(zoneCount);
+    for (MissionValidator::Zone &z : zones) {
+        const double lat = dLat(rng), lon = dLon(rng), r = dSize(rng);
+        const int k = 4 + int(rng() % 3);
+        for (int i = 0; i < k; ++i) {
+            const double a = 2.0 * M_PI * i / k;
+            z.ring.append(GeoPoint{lat + r * std::sin(a), lon + r * std::cos(a)});
+        }
+    }
+
+    // Rastgele yürüyüş: kısa bacaklar, gerçek bir görev gibi
+    QVector<Waypoint> wps(legs + 1);
+    double lat = 40.8, lon = 29.3;
+    for (Waypoint &wp : wps) {
+        lat = qBound(40.3, lat + dStep(rng), 41.3);
+        lon = qBound(28.8, lon + dStep(rng), 29.8);
+        wp = Waypoint{};
+        wp.lat = lat;
+        wp.lon = lon;
+        wp.alt = float(dAlt(rng));
+        wp.radius = 80.0f;
+        wp.command = MissionCommand::Waypoint;
+    }
+
+    std::printf("legs = %d, zones = %d, best of %d runs\n\n", legs, zoneCount, runs);
+
+    MissionValidator v;
+    const double tBuild = bestOfMs(runs, [&] { v.setZones(zones); });
+    const double tAll = bestOfMs(runs, [&] { v.validateAll(wps); });
+
+    // Her bacağın her bölge kutusuyla denendiği düz tarama (sadece kutu testi)
+    std::vector<RBox> boxes;
+    for (const MissionValidator::Zone &z : zones) {
+        RBox b{1e9, 1e9, -1e9, -1e9};
+        for (const GeoPoint &g : z.ring) b.expand(RBox{g.lon, g.lat, g.lon, g.lat});
+        boxes.push_back(b);
+    }
+    long long candidates = 0;
+    const double tScan = bestOfMs(1, [&] {
+        candidates = 0;
+        for (int i = 1; i < wps.size(); ++i) {
+            const RBox q{std::min(wps[i - 1].lon, wps[i].lon), std::min(wps[i - 1].lat, wps[i].lat),
+                         std::max(wps[i - 1].lon, wps[i].lon), std::max(wps[i - 1].lat, wps[i].lat)};
+            for (const RBox &b : boxes) candidates += b.intersects(q);
+        }
+    });
+
+    // Artımlı: bir noktayı kaydır, sadece komşu satırlar kontrol edilir
+    const int edits = 1000;
+    std::uniform_int_distribution<int> dRow(0, wps.size() - 1);
+    const double tEdit = bestOfMs(runs, [&] {
+        for (int e = 0; e < edits; ++e) {
+            const int row = dRow(rng);
+            wps[row].lat += dStep(rng) * 0.1;
+            int first, last;
+            v.rowChanged(wps, row, first, last);
+        }
+    });
+
+    std::printf("%-28s %10.2f ms\n", "R-tree build", tBuild);
+    std::printf("%-28s %10.2f ms  (%d offending rows)\n", "validateAll", tAll, v.offendingRows());
+    std::printf("%-28s %10.2f ms  (%lld bbox candidates)\n", "brute-force bbox scan", tScan, candidates);
+    std::printf("%-28s %10.3f us\n", "incremental edit (avg)", tEdit * 1000.0 / edits);
+    return 0;
+}
@@ -0,0 +1,21 @@
+#ifndef BENCHUTIL_H
+#define BENCHUTIL_H
+
+#include <algorithm>
+#include <chrono>
+
+// runs kez çalıştırır, en hızlı turun süresini (ms) döndürür
+template <typename F>
+inline double bestOfMs(int runs, F &&f)
+{
+    double best = 1e300;
+    for (int r = 0; r < runs; ++r) {
+        const auto t0 = std::chrono::steady_clock::now();
+        f();
+        const auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+    return best;
+}
+
+#endif // BENCHUTIL_H